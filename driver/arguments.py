@@ -183,9 +183,11 @@ def _check_mutex_args(parser, args, required=False):
 
 
 def _looks_like_search_input(filename):
-    with open(filename) as input_file:
-        first_line = next(input_file, "").rstrip()
-    return first_line == "begin_version"
+    with open(filename, "rb") as input_file:
+        first_line = next(input_file, b"").rstrip()
+    # Binary task files written by "downward --write-binary-task" start
+    # with a NUL byte.
+    return first_line == b"begin_version" or first_line.startswith(b"\0FDTASK")
 
 
 def _set_components_automatically(parser, args):
@@ -412,6 +414,11 @@ def parse_args():
     driver_other.add_argument(
         "--portfolio-single-plan", action="store_true",
         help="abort satisficing portfolio after finding the first plan")
+    driver_other.add_argument(
+        "--portfolio-task-cache", metavar="DIR", default=None,
+        help="directory in which portfolios cache the task in binary format "
+            "so that later runs on the same task can reuse it "
+            "(default: temporary directory that is deleted after the run)")
 
     driver_other.add_argument(
         "--cleanup", action="store_true",
@@ -472,6 +479,9 @@ def parse_args():
     if args.portfolio_single_plan and not args.portfolio:
         print_usage_and_exit_with_driver_input_error(
             parser, "--portfolio-single-plan may only be used for portfolios.")
+    if args.portfolio_task_cache is not None and not args.portfolio:
+        print_usage_and_exit_with_driver_input_error(
+            parser, "--portfolio-task-cache may only be used for portfolios.")
 
     if not args.version and not args.show_aliases and not args.cleanup:
         _set_components_and_inputs(parser, args)
@@ -17,10 +17,12 @@ __all__ = ["run"]
 
 import subprocess
 import sys
+import tempfile
 
 from . import call
 from . import limits
 from . import returncodes
+from . import task_cache
 from . import util
 
 
@@ -201,12 +203,16 @@ def get_portfolio_attributes(portfolio):
     return attributes
 
 
-def run(portfolio, executable, sas_file, plan_manager, time, memory):
+def run(portfolio, executable, sas_file, plan_manager, time, memory,
+        cache_dir=None):
     """
     Run the configs in the given portfolio file.
 
     The portfolio is allowed to run for at most *time* seconds and may
-    use a maximum of *memory* bytes.
+    use a maximum of *memory* bytes. The task is converted to the binary
+    task format once and all configs read the converted task. It is
+    cached in *cache_dir* if given and in a temporary directory
+    otherwise.
     """
     attributes = get_portfolio_attributes(portfolio)
     configs = attributes["CONFIGS"]
@@ -228,11 +234,27 @@ def run(portfolio, executable, sas_file, plan_manager, time, memory):
 
     timeout = util.get_elapsed_time() + time
 
+    if cache_dir is None:
+        with tempfile.TemporaryDirectory() as temp_dir:
+            return _run_configs(
+                configs, optimal, final_config, final_config_builder,
+                executable, sas_file, temp_dir, plan_manager, timeout, memory)
+    return _run_configs(
+        configs, optimal, final_config, final_config_builder, executable,
+        sas_file, cache_dir, plan_manager, timeout, memory)
+
+
+def _run_configs(configs, optimal, final_config, final_config_builder,
+                 executable, sas_file, cache_dir, plan_manager, timeout,
+                 memory):
+    # Converting the task counts towards the time limit of the portfolio.
+    search_input = task_cache.get_cached_search_input(
+        executable, sas_file, cache_dir)
     if optimal:
         exitcodes = run_opt(
-            configs, executable, sas_file, plan_manager, timeout, memory)
+            configs, executable, search_input, plan_manager, timeout, memory)
     else:
         exitcodes = run_sat(
-            configs, executable, sas_file, plan_manager, final_config,
+            configs, executable, search_input, plan_manager, final_config,
             final_config_builder, timeout, memory)
     return returncodes.generate_portfolio_exitcode(list(exitcodes))
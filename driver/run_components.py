@@ -112,7 +112,7 @@ def run_search(args):
         logging.info("search portfolio: %s" % args.portfolio)
         return portfolio_runner.run(
             args.portfolio, executable, args.search_input, plan_manager,
-            time_limit, memory_limit)
+            time_limit, memory_limit, args.portfolio_task_cache)
     else:
         if not args.search_options:
             returncodes.exit_with_driver_input_error(
@@ -0,0 +1,72 @@
+"""Cache of preprocessed search input for portfolios.
+
+Every portfolio component is a separate call of the search component,
+which would read and parse the translator output again. Instead, we let
+the search component convert the task once into its binary format (see
+src/search/tasks/binary_root_task.h), which later calls map into memory
+without parsing. Converted tasks are stored under a name derived from
+the hash of the translator output and the version of the binary format,
+so a cache directory can be shared between planner runs.
+"""
+
+import hashlib
+import logging
+import os
+import subprocess
+import tempfile
+
+from . import call
+
+
+# Must match BINARY_TASK_MAGIC and BINARY_TASK_VERSION in
+# src/search/tasks/binary_root_task.cc.
+BINARY_TASK_MAGIC = b"\0FDTASK\0"
+BINARY_TASK_VERSION = 1
+
+
+def is_binary_task(filename):
+    with open(filename, "rb") as input_file:
+        return input_file.read(len(BINARY_TASK_MAGIC)) == BINARY_TASK_MAGIC
+
+
+def compute_task_hash(filename):
+    task_hash = hashlib.sha256()
+    with open(filename, "rb") as input_file:
+        for chunk in iter(lambda: input_file.read(1 << 20), b""):
+            task_hash.update(chunk)
+    return task_hash.hexdigest()
+
+
+def get_cached_search_input(executable, sas_file, cache_dir):
+    """
+    Return the name of a binary task file for *sas_file* in *cache_dir*,
+    converting the task if the cache has no entry for it yet. If the
+    conversion fails, return *sas_file*, which the search component
+    can read as well.
+    """
+    if is_binary_task(sas_file):
+        return sas_file
+    os.makedirs(cache_dir, exist_ok=True)
+    cached_file = os.path.join(cache_dir, "{}-v{}.task".format(
+        compute_task_hash(sas_file), BINARY_TASK_VERSION))
+    if os.path.exists(cached_file):
+        logging.info("Using cached search input {}.".format(cached_file))
+        return cached_file
+
+    # Write to a temporary file first so that concurrent runs sharing the
+    # cache never see partially written files.
+    fd, temp_file = tempfile.mkstemp(dir=cache_dir, suffix=".tmp")
+    os.close(fd)
+    try:
+        call.check_call(
+            "convert", [executable, "--write-binary-task", temp_file],
+            stdin=sas_file)
+    except subprocess.CalledProcessError as err:
+        os.remove(temp_file)
+        logging.warning(
+            "Converting the search input failed with exit code {}. "
+            "Using the translator output directly.".format(err.returncode))
+        return sas_file
+    os.replace(temp_file, cached_file)
+    logging.info("Cached search input in {}.".format(cached_file))
+    return cached_file
@@ -0,0 +1,101 @@
+#! /usr/bin/env python3
+
+"""
+Compare the search time of astar() with the tiebreaking open list and with
+the bucket-based open list on the tasks in misc/tests/benchmarks. Both open
+lists expand states in the same order, so the number of expansions must
+match. Usage:
+
+    ./compare-open-lists.py [--build BUILD] [--runs RUNS] [--time-limit LIMIT]
+"""
+
+import argparse
+import os
+import re
+import statistics
+import subprocess
+import sys
+import tempfile
+
+DIR = os.path.dirname(os.path.abspath(__file__))
+REPO = os.path.dirname(os.path.dirname(DIR))
+BENCHMARKS_DIR = os.path.join(REPO, "misc", "tests", "benchmarks")
+FAST_DOWNWARD = os.path.join(REPO, "fast-downward.py")
+
+HEURISTICS = ["blind()", "lmcut()"]
+OPEN_LISTS = ["tiebreaking", "bucket"]
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--build", default="release")
+    parser.add_argument("--runs", type=int, default=5)
+    parser.add_argument("--time-limit", default="60s")
+    return parser.parse_args()
+
+
+def get_tasks():
+    for domain in sorted(os.listdir(BENCHMARKS_DIR)):
+        domain_dir = os.path.join(BENCHMARKS_DIR, domain)
+        for problem in sorted(os.listdir(domain_dir)):
+            if problem != "domain.pddl":
+                yield os.path.join(domain_dir, problem)
+
+
+def translate(build, task, sas_file):
+    subprocess.check_call(
+        [sys.executable, FAST_DOWNWARD, "--build", build, "--sas-file", sas_file,
+         "--translate", task], stdout=subprocess.DEVNULL)
+
+
+def search(build, time_limit, sas_file, heuristic, open_list):
+    bucket_open_list = "true" if open_list == "bucket" else "false"
+    output = subprocess.run(
+        [sys.executable, FAST_DOWNWARD, "--build", build,
+         "--search-time-limit", time_limit, sas_file,
+         "--search", "astar({}, bucket_open_list={})".format(
+             heuristic, bucket_open_list)],
+        cwd=tempfile.gettempdir(), stdout=subprocess.PIPE,
+        stderr=subprocess.DEVNULL, universal_newlines=True).stdout
+    if "Solution found!" not in output:
+        # For example, the heuristic does not support the task.
+        return None
+    expansions = int(re.search(r"Expanded (\d+) state\(s\)\.", output).group(1))
+    search_time = float(re.search(r"Search time: (.+)s", output).group(1))
+    return expansions, search_time
+
+
+def main():
+    args = parse_args()
+    print("{:40} {:10} {:12} {:>10} {:>12}".format(
+        "task", "heuristic", "open list", "expanded", "search time"))
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        sas_file = os.path.join(tmp_dir, "output.sas")
+        for task in get_tasks():
+            translate(args.build, task, sas_file)
+            name = os.path.relpath(task, BENCHMARKS_DIR)
+            for heuristic in HEURISTICS:
+                expansions = set()
+                for open_list in OPEN_LISTS:
+                    times = []
+                    for _ in range(args.runs):
+                        result = search(
+                            args.build, args.time_limit, sas_file,
+                            heuristic, open_list)
+                        if result is None:
+                            break
+                        num_expanded, search_time = result
+                        expansions.add(num_expanded)
+                        times.append(search_time)
+                    if not times:
+                        print("{:40} {:10} {:12} unsolved".format(
+                            name, heuristic, open_list))
+                        continue
+                    print("{:40} {:10} {:12} {:>10} {:>11.4f}s".format(
+                        name, heuristic, open_list, num_expanded,
+                        statistics.median(times)))
+                assert len(expansions) <= 1, expansions
+
+
+if __name__ == "__main__":
+    main()
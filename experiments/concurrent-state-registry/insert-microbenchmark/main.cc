@@ -0,0 +1,137 @@
+#include "algorithms/concurrent_array_set.h"
+#include "algorithms/int_hash_set.h"
+#include "algorithms/segmented_vector.h"
+#include "utils/hash.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+using Bin = unsigned int;
+
+
+static void benchmark(const string &desc, int num_arrays,
+                      const function<int()> &func) {
+    cout << "Running " << desc << ":" << flush;
+    auto start = chrono::steady_clock::now();
+    int num_unique = func();
+    auto end = chrono::steady_clock::now();
+    double duration = chrono::duration<double>(end - start).count();
+    cout << " " << duration << "s, " << num_arrays / duration / 1e6
+         << "M inserts/s, " << num_unique << " unique" << endl;
+}
+
+
+/*
+  Mirror of the single-threaded StateRegistry: a SegmentedArrayVector plus an
+  IntHashSet of indices into it.
+*/
+struct SequentialArraySet {
+    struct Hash {
+        const segmented_vector::SegmentedArrayVector<Bin> &pool;
+        int size;
+        Hash(const segmented_vector::SegmentedArrayVector<Bin> &pool, int size)
+            : pool(pool), size(size) {
+        }
+        int_hash_set::HashType operator()(int id) const {
+            utils::HashState hash_state;
+            for (int i = 0; i < size; ++i) {
+                hash_state.feed(pool[id][i]);
+            }
+            return hash_state.get_hash32();
+        }
+    };
+
+    struct Equal {
+        const segmented_vector::SegmentedArrayVector<Bin> &pool;
+        int size;
+        Equal(const segmented_vector::SegmentedArrayVector<Bin> &pool, int size)
+            : pool(pool), size(size) {
+        }
+        bool operator()(int lhs, int rhs) const {
+            return equal(pool[lhs], pool[lhs] + size, pool[rhs]);
+        }
+    };
+
+    segmented_vector::SegmentedArrayVector<Bin> pool;
+    int_hash_set::IntHashSet<Hash, Equal> ids;
+
+    explicit SequentialArraySet(int size)
+        : pool(size), ids(Hash(pool, size), Equal(pool, size)) {
+    }
+
+    void insert(const Bin *data) {
+        pool.push_back(data);
+        if (!ids.insert(pool.size() - 1).second) {
+            pool.pop_back();
+        }
+    }
+};
+
+
+int main(int argc, char **argv) {
+    const int NUM_ARRAYS = argc > 1 ? atoi(argv[1]) : 4000000;
+    const int ARRAY_SIZE = 4;
+    // Each array occurs twice on average, like states reached on two paths.
+    const int NUM_DISTINCT = NUM_ARRAYS / 2;
+    const int NUM_STRIPES = 256;
+    const int REPETITIONS = 2;
+    const int max_threads = max(1u, thread::hardware_concurrency());
+
+    mt19937 rng(2021);
+    uniform_int_distribution<int> dist(0, NUM_DISTINCT - 1);
+    vector<Bin> data(static_cast<size_t>(NUM_ARRAYS) * ARRAY_SIZE);
+    for (int i = 0; i < NUM_ARRAYS; ++i) {
+        int value = dist(rng);
+        for (int j = 0; j < ARRAY_SIZE; ++j) {
+            data[i * ARRAY_SIZE + j] = value * (j + 1);
+        }
+    }
+
+    cout << "Inserting " << NUM_ARRAYS << " arrays of " << ARRAY_SIZE
+         << " bins, hardware threads: " << max_threads << endl;
+    for (int rep = 0; rep < REPETITIONS; ++rep) {
+        benchmark("IntHashSet (sequential)", NUM_ARRAYS,
+                  [&]() {
+                      SequentialArraySet s(ARRAY_SIZE);
+                      for (int i = 0; i < NUM_ARRAYS; ++i) {
+                          s.insert(&data[i * ARRAY_SIZE]);
+                      }
+                      return s.ids.size();
+                  });
+        for (int num_threads = 1; num_threads <= 2 * max_threads;
+             num_threads *= 2) {
+            benchmark("ConcurrentArraySet with " + to_string(num_threads) +
+                      " threads", NUM_ARRAYS,
+                      [&]() {
+                          concurrent_array_set::ConcurrentArraySet<Bin> s(
+                              ARRAY_SIZE, NUM_STRIPES);
+                          vector<thread> threads;
+                          for (int t = 0; t < num_threads; ++t) {
+                              threads.emplace_back(
+                                  [&, t]() {
+                                      for (int i = t; i < NUM_ARRAYS;
+                                           i += num_threads) {
+                                          s.insert(&data[i * ARRAY_SIZE]);
+                                      }
+                                  });
+                          }
+                          for (thread &t : threads) {
+                              t.join();
+                          }
+                          return s.size();
+                      });
+        }
+        cout << endl;
+    }
+
+    return 0;
+}
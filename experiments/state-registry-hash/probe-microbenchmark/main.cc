@@ -0,0 +1,117 @@
+#include "algorithms/int_hash_set.h"
+#include "algorithms/segmented_vector.h"
+#include "utils/hash.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+using Bin = unsigned int;
+
+
+static void benchmark(const string &desc, int num_arrays,
+                      const function<int()> &func) {
+    cout << "Running " << desc << ":" << flush;
+    auto start = chrono::steady_clock::now();
+    int num_unique = func();
+    auto end = chrono::steady_clock::now();
+    double duration = chrono::duration<double>(end - start).count();
+    cout << " " << duration << "s, " << num_arrays / duration / 1e6
+         << "M inserts/s, " << num_unique << " unique" << endl;
+}
+
+
+/*
+  Mirror of StateRegistry: a SegmentedArrayVector plus an IntHashSet of
+  indices into it whose hash and equality functions read the arrays.
+*/
+struct ArraySet {
+    struct Hash {
+        const segmented_vector::SegmentedArrayVector<Bin> &pool;
+        int size;
+        Hash(const segmented_vector::SegmentedArrayVector<Bin> &pool, int size)
+            : pool(pool), size(size) {
+        }
+        int_hash_set::HashType operator()(int id) const {
+            utils::HashState hash_state;
+            for (int i = 0; i < size; ++i) {
+                hash_state.feed(pool[id][i]);
+            }
+            return hash_state.get_hash32();
+        }
+    };
+
+    struct Equal {
+        const segmented_vector::SegmentedArrayVector<Bin> &pool;
+        int size;
+        Equal(const segmented_vector::SegmentedArrayVector<Bin> &pool, int size)
+            : pool(pool), size(size) {
+        }
+        bool operator()(int lhs, int rhs) const {
+            return equal(pool[lhs], pool[lhs] + size, pool[rhs]);
+        }
+    };
+
+    segmented_vector::SegmentedArrayVector<Bin> pool;
+    int_hash_set::IntHashSet<Hash, Equal> ids;
+
+    ArraySet(int size, bool use_fingerprints)
+        : pool(size),
+          ids(Hash(pool, size), Equal(pool, size), use_fingerprints) {
+    }
+
+    void insert(const Bin *data) {
+        pool.push_back(data);
+        if (!ids.insert(pool.size() - 1).second) {
+            pool.pop_back();
+        }
+    }
+};
+
+
+int main(int argc, char **argv) {
+    const int MAX_NUM_ARRAYS = argc > 1 ? atoi(argv[1]) : 16000000;
+    const int ARRAY_SIZE = 4;
+    const int REPETITIONS = 2;
+
+    for (int num_arrays = MAX_NUM_ARRAYS / 64; num_arrays <= MAX_NUM_ARRAYS;
+         num_arrays *= 8) {
+        // Each array occurs twice on average, like states reached on two paths.
+        int num_distinct = num_arrays / 2;
+        mt19937 rng(2021);
+        uniform_int_distribution<int> dist(0, num_distinct - 1);
+        vector<Bin> data(static_cast<size_t>(num_arrays) * ARRAY_SIZE);
+        for (int i = 0; i < num_arrays; ++i) {
+            int value = dist(rng);
+            for (int j = 0; j < ARRAY_SIZE; ++j) {
+                data[i * ARRAY_SIZE + j] = value * (j + 1);
+            }
+        }
+
+        cout << "Inserting " << num_arrays << " arrays of " << ARRAY_SIZE
+             << " bins" << endl;
+        for (int rep = 0; rep < REPETITIONS; ++rep) {
+            for (bool use_fingerprints : {false, true}) {
+                benchmark(use_fingerprints ? "IntHashSet with fingerprints"
+                          : "IntHashSet", num_arrays,
+                          [&]() {
+                              ArraySet s(ARRAY_SIZE, use_fingerprints);
+                              for (int i = 0; i < num_arrays; ++i) {
+                                  s.insert(&data[i * ARRAY_SIZE]);
+                              }
+                              return s.ids.size();
+                          });
+            }
+        }
+        cout << endl;
+    }
+
+    return 0;
+}
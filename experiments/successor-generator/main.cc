@@ -0,0 +1,102 @@
+#include "task_proxy.h"
+
+#include "task_utils/successor_generator.h"
+#include "task_utils/successor_generator_factory.h"
+#include "tasks/root_task.h"
+#include "utils/rng.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const int NUM_SAMPLES = 1000;
+static const int MAX_WALK_LENGTH = 50;
+
+
+/*
+  Sample states by random walks from the initial state. We use the decision
+  tree to find the applicable operators.
+*/
+static vector<State> sample_states(const TaskProxy &task_proxy, int num_samples) {
+    successor_generator::SuccessorGeneratorFactory::use_precondition_masks(false);
+    successor_generator::SuccessorGenerator generator(task_proxy);
+    OperatorsProxy operators = task_proxy.get_operators();
+    utils::RandomNumberGenerator rng(2022);
+    vector<State> samples;
+    vector<OperatorID> applicable_ops;
+    for (int i = 0; i < num_samples; ++i) {
+        State state = task_proxy.get_initial_state();
+        state.unpack();
+        int length = rng.random(MAX_WALK_LENGTH + 1);
+        for (int step = 0; step < length; ++step) {
+            applicable_ops.clear();
+            generator.generate_applicable_ops(state, applicable_ops);
+            if (applicable_ops.empty()) {
+                break;
+            }
+            OperatorID op_id = *rng.choose(applicable_ops);
+            state = state.get_unregistered_successor(operators[op_id]);
+        }
+        samples.push_back(move(state));
+    }
+    return samples;
+}
+
+
+static long long benchmark(
+    const string &desc, const TaskProxy &task_proxy, bool use_masks,
+    const vector<State> &samples, int num_rounds) {
+    cout << "Running " << desc << ":" << flush;
+    successor_generator::SuccessorGeneratorFactory::use_precondition_masks(use_masks);
+    successor_generator::SuccessorGenerator generator(task_proxy);
+    vector<OperatorID> applicable_ops;
+    long long checksum = 0;
+    long long num_applicable_ops = 0;
+    auto start = chrono::steady_clock::now();
+    for (int round = 0; round < num_rounds; ++round) {
+        for (const State &state : samples) {
+            applicable_ops.clear();
+            generator.generate_applicable_ops(state, applicable_ops);
+            num_applicable_ops += applicable_ops.size();
+            for (size_t i = 0; i < applicable_ops.size(); ++i) {
+                checksum += (i + 1) * applicable_ops[i].get_index();
+            }
+        }
+    }
+    auto end = chrono::steady_clock::now();
+    double duration = chrono::duration<double>(end - start).count();
+    long long num_states = static_cast<long long>(num_rounds) * samples.size();
+    cout << " " << duration << "s, " << num_states / duration / 1e6
+         << "M states/s, " << num_applicable_ops / duration / 1e6
+         << "M applicable ops/s" << endl;
+    return checksum;
+}
+
+
+int main(int argc, char **argv) {
+    int num_rounds = 100;
+    if (argc == 2) {
+        num_rounds = atoi(argv[1]);
+    } else if (argc != 1) {
+        cerr << "usage: " << argv[0] << " [NUM_ROUNDS] < output.sas" << endl;
+        return 2;
+    }
+
+    tasks::read_root_task(cin);
+    TaskProxy task_proxy(*tasks::g_root_task);
+    cout << "Operators: " << task_proxy.get_operators().size() << endl;
+    vector<State> samples = sample_states(task_proxy, NUM_SAMPLES);
+
+    long long tree_checksum = benchmark(
+        "decision tree", task_proxy, false, samples, num_rounds);
+    long long masks_checksum = benchmark(
+        "precondition masks", task_proxy, true, samples, num_rounds);
+    if (tree_checksum != masks_checksum) {
+        cerr << "Generators report different operators." << endl;
+        return 1;
+    }
+}
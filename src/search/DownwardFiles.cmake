@@ -51,6 +51,7 @@ fast_downward_plugin(
         abstract_task
         axioms
         command_line
+        compressed_state_pool
         evaluation_context
         evaluation_result
         evaluator
@@ -83,6 +84,16 @@ fast_downward_plugin(
     CORE_PLUGIN
 )
 
+fast_downward_plugin(
+    NAME CONCURRENT_STATE_REGISTRY
+    HELP "Thread-safe state registry and per-state information for parallel search algorithms"
+    SOURCES
+        concurrent_per_state_information
+        concurrent_state_registry
+    DEPENDS CONCURRENT_ARRAY_SET TASK_PROPERTIES
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME OPTIONS
     HELP "Option parsing and plugin definition"
@@ -111,8 +122,10 @@ fast_downward_plugin(
         utils/countdown_timer
         utils/exceptions
         utils/hash
+        utils/heuristic_cache
         utils/language
         utils/logging
+        utils/mapped_storage
         utils/markup
         utils/math
         utils/memory
@@ -122,6 +135,7 @@ fast_downward_plugin(
         utils/system
         utils/system_unix
         utils/system_windows
+        utils/thread_pool
         utils/timer
     CORE_PLUGIN
 )
@@ -133,6 +147,13 @@ fast_downward_plugin(
         open_lists/alternation_open_list
 )
 
+fast_downward_plugin(
+    NAME BUCKET_OPEN_LIST
+    HELP "Open list that stores entries in buckets indexed by two integer evaluators"
+    SOURCES
+        open_lists/bucket_open_list
+)
+
 fast_downward_plugin(
     NAME BEST_FIRST_OPEN_LIST
     HELP "Open list that selects the best element according to a single evaluation function"
@@ -168,6 +189,16 @@ fast_downward_plugin(
         open_lists/type_based_open_list
 )
 
+fast_downward_plugin(
+    NAME CONCURRENT_ARRAY_SET
+    HELP "Thread-safe set of fixed-size arrays with lock-striped duplicate detection"
+    SOURCES
+        algorithms/concurrent_array_set
+        algorithms/concurrent_segmented_vector
+    DEPENDS INT_HASH_SET
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME DYNAMIC_BITSET
     HELP "Poor man's version of boost::dynamic_bitset"
@@ -224,6 +255,14 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME MPSC_QUEUE
+    HELP "Lock-free queue for passing messages between threads"
+    SOURCES
+        algorithms/mpsc_queue
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME ORDERED_SET
     HELP "Set of elements ordered by insertion time"
@@ -364,7 +403,7 @@ fast_downward_plugin(
     HELP "Basic classes used for all search engines"
     SOURCES
         search_engines/search_common
-    DEPENDS ALTERNATION_OPEN_LIST G_EVALUATOR BEST_FIRST_OPEN_LIST SUM_EVALUATOR TIEBREAKING_OPEN_LIST WEIGHTED_EVALUATOR
+    DEPENDS ALTERNATION_OPEN_LIST BUCKET_OPEN_LIST G_EVALUATOR BEST_FIRST_OPEN_LIST SUM_EVALUATOR TIEBREAKING_OPEN_LIST WEIGHTED_EVALUATOR
     DEPENDENCY_ONLY
 )
 
@@ -385,6 +424,14 @@ fast_downward_plugin(
     DEPENDS EAGER_SEARCH SEARCH_COMMON
 )
 
+fast_downward_plugin(
+    NAME PLUGIN_HDA_STAR
+    HELP "Hash-distributed parallel A* search"
+    SOURCES
+        search_engines/hda_star_search
+    DEPENDS MPSC_QUEUE SEARCH_COMMON SUCCESSOR_GENERATOR
+)
+
 fast_downward_plugin(
     NAME PLUGIN_EAGER
     HELP "Eager (i.e., normal) best-first search"
@@ -448,6 +495,13 @@ fast_downward_plugin(
         search_engines/iterated_search
 )
 
+fast_downward_plugin(
+    NAME PORTFOLIO_SEARCH
+    HELP "Portfolio of search engines run in one process"
+    SOURCES
+        search_engines/portfolio_search
+)
+
 fast_downward_plugin(
     NAME PYTHON_CLIENT
     HELP "Client to talk to python"
@@ -569,6 +623,7 @@ fast_downward_plugin(
     SOURCES
         tasks/cost_adapted_task
         tasks/delegating_task
+        tasks/binary_root_task
         tasks/root_task
     CORE_PLUGIN
 )
@@ -738,6 +793,7 @@ fast_downward_plugin(
         pdbs/canonical_pdbs
         pdbs/canonical_pdbs_heuristic
         pdbs/cegar
+        pdbs/compact_distances
         pdbs/dominance_pruning
         pdbs/incremental_canonical_pdbs
         pdbs/match_tree
@@ -760,6 +816,7 @@ fast_downward_plugin(
         pdbs/pattern_generator_random
         pdbs/pattern_generator
         pdbs/pattern_information
+        pdbs/pdb_builder
         pdbs/pdb_heuristic
         pdbs/plugin_group
         pdbs/random_pattern
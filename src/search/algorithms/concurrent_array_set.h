@@ -0,0 +1,178 @@
+#ifndef ALGORITHMS_CONCURRENT_ARRAY_SET_H
+#define ALGORITHMS_CONCURRENT_ARRAY_SET_H
+
+#include "concurrent_segmented_vector.h"
+#include "int_hash_set.h"
+
+#include "../utils/hash.h"
+#include "../utils/logging.h"
+#include "../utils/memory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/*
+  Thread-safe set of fixed-size arrays that assigns a unique ID to each
+  array, e.g. to packed states (see ConcurrentStateRegistry).
+
+  The arrays are stored in a ConcurrentSegmentedArrayVector at the position
+  of their ID. Duplicate detection uses a lock-striped hash index: the high
+  bits of the hash of an array select one of several stripes, each holding
+  an IntHashSet of IDs protected by its own mutex. Threads inserting arrays
+  into different stripes do not block each other, and the IntHashSets use
+  the low bits of the same hash, so the stripes do not skew their buckets.
+
+  IDs are drawn from a global atomic counter while holding the stripe lock.
+  If the array turns out to be a duplicate, the stripe keeps the drawn ID
+  for its next insertion. Therefore, the IDs of the arrays are not dense:
+  up to one ID per stripe is reserved but unused. get_id_bound() returns an
+  upper bound for all IDs, which is what containers indexed by ID need.
+
+  Reading an array with lookup() does not lock. A thread may only look up
+  IDs that it obtained from insert() itself or received from the inserting
+  thread through some synchronization (locks, atomics, message queues).
+*/
+namespace concurrent_array_set {
+template<typename Element>
+class ConcurrentArraySet {
+    using Pool = concurrent_segmented_vector::ConcurrentSegmentedArrayVector<Element>;
+
+    struct ArrayHash {
+        const Pool *pool;
+        int array_size;
+        ArrayHash(const Pool &pool, int array_size)
+            : pool(&pool), array_size(array_size) {
+        }
+
+        int_hash_set::HashType operator()(int id) const {
+            return compute_hash((*pool)[id], array_size);
+        }
+    };
+
+    struct ArrayEqual {
+        const Pool *pool;
+        int array_size;
+        ArrayEqual(const Pool &pool, int array_size)
+            : pool(&pool), array_size(array_size) {
+        }
+
+        bool operator()(int lhs, int rhs) const {
+            const Element *lhs_data = (*pool)[lhs];
+            const Element *rhs_data = (*pool)[rhs];
+            return std::equal(lhs_data, lhs_data + array_size, rhs_data);
+        }
+    };
+
+    using IDSet = int_hash_set::IntHashSet<ArrayHash, ArrayEqual>;
+
+    struct Stripe {
+        std::mutex stripe_mutex;
+        IDSet ids;
+        int spare_id;
+
+        Stripe(const Pool &pool, int array_size)
+            : ids(ArrayHash(pool, array_size), ArrayEqual(pool, array_size)),
+              spare_id(-1) {
+        }
+    };
+
+    const int array_size;
+    Pool pool;
+    /*
+      Stripes are allocated separately to keep their mutexes and hash sets
+      on different cache lines.
+    */
+    std::vector<std::unique_ptr<Stripe>> stripes;
+    std::atomic<int> next_id;
+    std::atomic<int> num_entries;
+
+    static int_hash_set::HashType compute_hash(
+        const Element *data, int array_size) {
+        utils::HashState hash_state;
+        for (int i = 0; i < array_size; ++i) {
+            hash_state.feed(data[i]);
+        }
+        return hash_state.get_hash32();
+    }
+
+    Stripe &get_stripe(int_hash_set::HashType hash) {
+        std::uint64_t index = (static_cast<std::uint64_t>(hash) * stripes.size()) >> 32;
+        return *stripes[index];
+    }
+
+public:
+    ConcurrentArraySet(int array_size, int num_stripes)
+        : array_size(array_size),
+          pool(array_size),
+          next_id(0),
+          num_entries(0) {
+        assert(num_stripes >= 1);
+        stripes.reserve(num_stripes);
+        for (int i = 0; i < num_stripes; ++i) {
+            stripes.push_back(utils::make_unique_ptr<Stripe>(pool, array_size));
+        }
+    }
+
+    /*
+      Insert a copy of the given array unless an equal array is contained
+      already. Return the ID of the array in the set and whether it was
+      inserted. Can be called concurrently by any number of threads.
+    */
+    std::pair<int, bool> insert(const Element *data) {
+        Stripe &stripe = get_stripe(compute_hash(data, array_size));
+        std::lock_guard<std::mutex> lock(stripe.stripe_mutex);
+        int id = stripe.spare_id;
+        if (id == -1) {
+            id = next_id.fetch_add(1, std::memory_order_relaxed);
+        }
+        std::copy_n(data, array_size, pool[id]);
+        std::pair<int, bool> result = stripe.ids.insert(id);
+        if (result.second) {
+            stripe.spare_id = -1;
+            num_entries.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            stripe.spare_id = id;
+        }
+        return result;
+    }
+
+    const Element *lookup(int id) const {
+        return pool[id];
+    }
+
+    int size() const {
+        return num_entries.load(std::memory_order_relaxed);
+    }
+
+    int get_id_bound() const {
+        return next_id.load(std::memory_order_relaxed);
+    }
+
+    int get_num_stripes() const {
+        return stripes.size();
+    }
+
+    // Must not be called while other threads modify the set.
+    void print_statistics(utils::LogProxy &log) const {
+        int min_stripe_size = stripes.front()->ids.size();
+        int max_stripe_size = min_stripe_size;
+        for (const std::unique_ptr<Stripe> &stripe : stripes) {
+            min_stripe_size = std::min(min_stripe_size, stripe->ids.size());
+            max_stripe_size = std::max(max_stripe_size, stripe->ids.size());
+        }
+        log << "Concurrent array set stripes: " << stripes.size()
+            << " (entries per stripe: " << min_stripe_size << " to "
+            << max_stripe_size << ")" << std::endl;
+        log << "Concurrent array set unused IDs: "
+            << get_id_bound() - size() << std::endl;
+    }
+};
+}
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef ALGORITHMS_CONCURRENT_SEGMENTED_VECTOR_H
+#define ALGORITHMS_CONCURRENT_SEGMENTED_VECTOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+
+/*
+  ConcurrentSegmentedArrayVector is a thread-safe variant of
+  SegmentedArrayVector (see segmented_vector.h) that maps indices to
+  fixed-size arrays whose size is only known at runtime.
+
+  In contrast to SegmentedArrayVector, there is no push_back. Instead, the
+  vector has an unbounded virtual size and the segment containing an index
+  is allocated the first time that the index is accessed. Entries of newly
+  allocated segments are set to a default value. Segments are never moved
+  or freed before the vector is destroyed, so pointers to entries stay
+  valid and threads can access entries without locking.
+
+  Segment k holds FIRST_SEGMENT_ARRAYS * 2^k arrays, which lets us use a
+  fixed-size table of segment pointers that is updated with compare-and-swap
+  operations. The price is that up to half of the last segment is unused.
+
+  Accessing different entries from different threads is safe. Accessing the
+  same entry from several threads needs external synchronization, e.g. by
+  passing its index through a lock or a message queue after writing it.
+*/
+
+namespace concurrent_segmented_vector {
+template<class Element>
+class ConcurrentSegmentedArrayVector {
+    static const int NUM_SEGMENTS = 32;
+    static const std::size_t FIRST_SEGMENT_ARRAYS = 1024;
+
+    const std::size_t elements_per_array;
+    const Element default_value;
+    std::atomic<Element *> segments[NUM_SEGMENTS];
+
+    static int get_segment(std::size_t index) {
+        std::size_t q = index / FIRST_SEGMENT_ARRAYS + 1;
+        int segment = 0;
+        while (q >>= 1) {
+            ++segment;
+        }
+        return segment;
+    }
+
+    static std::size_t get_segment_start(int segment) {
+        return FIRST_SEGMENT_ARRAYS * ((std::size_t(1) << segment) - 1);
+    }
+
+    static std::size_t get_segment_arrays(int segment) {
+        return FIRST_SEGMENT_ARRAYS << segment;
+    }
+
+    Element *get_or_allocate_segment(int segment) {
+        Element *data = segments[segment].load(std::memory_order_acquire);
+        if (!data) {
+            std::size_t num_elements =
+                get_segment_arrays(segment) * elements_per_array;
+            Element *new_data = new Element[num_elements];
+            std::fill_n(new_data, num_elements, default_value);
+            if (segments[segment].compare_exchange_strong(
+                    data, new_data,
+                    std::memory_order_acq_rel, std::memory_order_acquire)) {
+                data = new_data;
+            } else {
+                // Another thread allocated the segment in the meantime.
+                delete[] new_data;
+            }
+        }
+        return data;
+    }
+
+public:
+    explicit ConcurrentSegmentedArrayVector(
+        std::size_t elements_per_array,
+        const Element &default_value = Element())
+        : elements_per_array(elements_per_array),
+          default_value(default_value) {
+        assert(elements_per_array > 0);
+        for (int i = 0; i < NUM_SEGMENTS; ++i) {
+            segments[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ConcurrentSegmentedArrayVector(const ConcurrentSegmentedArrayVector &) = delete;
+    ConcurrentSegmentedArrayVector &operator=(
+        const ConcurrentSegmentedArrayVector &) = delete;
+
+    ~ConcurrentSegmentedArrayVector() {
+        for (int i = 0; i < NUM_SEGMENTS; ++i) {
+            delete[] segments[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    // Return the array at the given index, allocating its segment if needed.
+    Element *operator[](std::size_t index) {
+        int segment = get_segment(index);
+        assert(segment < NUM_SEGMENTS);
+        Element *data = get_or_allocate_segment(segment);
+        return data + (index - get_segment_start(segment)) * elements_per_array;
+    }
+
+    // The segment containing the index must have been allocated before.
+    const Element *operator[](std::size_t index) const {
+        int segment = get_segment(index);
+        assert(segment < NUM_SEGMENTS);
+        const Element *data = segments[segment].load(std::memory_order_acquire);
+        assert(data);
+        return data + (index - get_segment_start(segment)) * elements_per_array;
+    }
+
+    std::size_t get_num_allocated_bytes() const {
+        std::size_t num_bytes = 0;
+        for (int i = 0; i < NUM_SEGMENTS; ++i) {
+            if (segments[i].load(std::memory_order_relaxed)) {
+                num_bytes += get_segment_arrays(i) * elements_per_array *
+                    sizeof(Element);
+            }
+        }
+        return num_bytes;
+    }
+};
+
+template<class Element>
+const int ConcurrentSegmentedArrayVector<Element>::NUM_SEGMENTS;
+
+template<class Element>
+const std::size_t ConcurrentSegmentedArrayVector<Element>::FIRST_SEGMENT_ARRAYS;
+}
+
+#endif
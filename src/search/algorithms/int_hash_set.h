@@ -8,11 +8,20 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <limits>
 #include <utility>
 #include <vector>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define INT_HASH_SET_USE_SSE2
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace int_hash_set {
 /*
   Hash set for storing non-negative integer keys.
@@ -67,6 +76,16 @@ namespace int_hash_set {
   check for a given key are aligned in memory, the lookup has good
   cache locality.
 
+  Optionally, the hash set additionally stores a one-byte fingerprint of
+  the hash of each bucket in a separate vector. A lookup then compares
+  the fingerprints of all buckets it needs to check at once (with SSE2
+  if available) and only reads the buckets whose fingerprints match.
+  Since keys are never removed, all buckets between the ideal bucket of
+  a key and its actual bucket are full, so a lookup can also stop at the
+  first empty bucket. The fingerprints of the first MAX_DISTANCE buckets
+  are repeated after the last bucket, so that the fingerprints of the
+  buckets to check are always contiguous. This needs one more byte per
+  bucket.
 */
 
 using KeyType = int;
@@ -105,9 +124,49 @@ class IntHashSet {
     Hasher hasher;
     Equal equal;
     std::vector<Bucket> buckets;
+    // Fingerprints of the buckets, or empty if fingerprints are not used.
+    bool use_fingerprints;
+    std::vector<uint8_t> fingerprints;
     int num_entries;
     int num_resizes;
 
+    static const uint8_t empty_bucket_fingerprint = 0;
+
+    static int get_lowest_bit_index(uint32_t mask) {
+        assert(mask != 0);
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return index;
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+
+    static uint8_t get_fingerprint(HashType hash) {
+        /* get_bucket uses the lowest bits of the hash, so we use the highest
+           ones. The highest bit distinguishes full from empty buckets. */
+        return 0x80 | (hash >> 25);
+    }
+
+    void set_bucket(int index, const Bucket &bucket) {
+        buckets[index] = bucket;
+        if (use_fingerprints) {
+            uint8_t fingerprint = bucket.full() ?
+                get_fingerprint(bucket.hash) : empty_bucket_fingerprint;
+            fingerprints[index] = fingerprint;
+            if (index < MAX_DISTANCE) {
+                fingerprints[capacity() + index] = fingerprint;
+            }
+        }
+    }
+
+    void swap_buckets(int index1, int index2) {
+        Bucket bucket1 = buckets[index1];
+        set_bucket(index1, buckets[index2]);
+        set_bucket(index2, bucket1);
+    }
+
     int capacity() const {
         return buckets.size();
     }
@@ -119,6 +178,10 @@ class IntHashSet {
         assert(buckets.empty());
         num_entries = 0;
         buckets.resize(new_capacity);
+        if (use_fingerprints) {
+            fingerprints.assign(new_capacity + MAX_DISTANCE,
+                                empty_bucket_fingerprint);
+        }
         for (const Bucket &bucket : old_buckets) {
             if (bucket.full()) {
                 insert(bucket.key, bucket.hash);
@@ -178,8 +241,66 @@ class IntHashSet {
         return index;
     }
 
+    /*
+      Return a bitmask whose i-th bit is set iff the fingerprint of the i-th
+      bucket starting at ideal_index equals the given fingerprint and all
+      buckets before it are full.
+    */
+    uint32_t get_candidate_mask(int ideal_index, uint8_t fingerprint) const {
+        static_assert(MAX_DISTANCE == 32, "candidate mask must have 32 bits");
+        const uint8_t *first = &fingerprints[ideal_index];
+        uint32_t matches;
+        uint32_t empty;
+#ifdef INT_HASH_SET_USE_SSE2
+        __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+        __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first + 16));
+        __m128i wanted = _mm_set1_epi8(static_cast<char>(fingerprint));
+        __m128i zero = _mm_setzero_si128();
+        matches = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(low, wanted))) |
+            static_cast<uint32_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(high, wanted))) << 16;
+        empty = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(low, zero))) |
+            static_cast<uint32_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(high, zero))) << 16;
+#else
+        matches = 0;
+        empty = 0;
+        for (int i = 0; i < MAX_DISTANCE; ++i) {
+            matches |= static_cast<uint32_t>(first[i] == fingerprint) << i;
+            empty |= static_cast<uint32_t>(
+                first[i] == empty_bucket_fingerprint) << i;
+        }
+#endif
+        if (empty) {
+            // Keep the matches before the first empty bucket.
+            matches &= (empty & (~empty + 1)) - 1;
+        }
+        return matches;
+    }
+
+    KeyType find_equal_key_with_fingerprints(KeyType key, HashType hash) const {
+        int ideal_index = get_bucket(hash);
+        uint32_t candidates = get_candidate_mask(
+            ideal_index, get_fingerprint(hash));
+        while (candidates) {
+            int offset = get_lowest_bit_index(candidates);
+            candidates &= candidates - 1;
+            const Bucket &bucket = buckets[get_bucket(ideal_index + offset)];
+            assert(bucket.full());
+            if (bucket.hash == hash && equal(bucket.key, key)) {
+                return bucket.key;
+            }
+        }
+        return Bucket::empty_bucket_key;
+    }
+
     KeyType find_equal_key(KeyType key, HashType hash) const {
         assert(hasher(key) == hash);
+        if (use_fingerprints && capacity() >= MAX_DISTANCE) {
+            return find_equal_key_with_fingerprints(key, hash);
+        }
         int ideal_index = get_bucket(hash);
         for (int i = 0; i < MAX_DISTANCE; ++i) {
             int index = get_bucket(ideal_index + i);
@@ -247,7 +368,7 @@ class IntHashSet {
                 int candidate_ideal_index = get_bucket(candidate_hash);
                 if (get_distance(candidate_ideal_index, free_index) < MAX_DISTANCE) {
                     // Candidate can be swapped.
-                    std::swap(buckets[candidate_index], buckets[free_index]);
+                    swap_buckets(candidate_index, free_index);
                     free_index = candidate_index;
                     swapped = true;
                     break;
@@ -262,24 +383,33 @@ class IntHashSet {
         }
         assert(utils::in_bounds(free_index, buckets));
         assert(!buckets[free_index].full());
-        buckets[free_index] = Bucket(key, hash);
+        set_bucket(free_index, Bucket(key, hash));
         ++num_entries;
         return std::make_pair(key, true);
     }
 
 public:
-    IntHashSet(const Hasher &hasher, const Equal &equal)
+    IntHashSet(const Hasher &hasher, const Equal &equal,
+               bool use_fingerprints = false)
         : hasher(hasher),
           equal(equal),
           buckets(1),
+          use_fingerprints(use_fingerprints),
           num_entries(0),
           num_resizes(0) {
+        if (use_fingerprints) {
+            fingerprints.assign(1 + MAX_DISTANCE, empty_bucket_fingerprint);
+        }
     }
 
     int size() const {
         return num_entries;
     }
 
+    std::size_t get_num_bytes() const {
+        return buckets.capacity() * sizeof(Bucket) + fingerprints.capacity();
+    }
+
     /*
       Insert a key into the hash set.
 
@@ -326,6 +456,9 @@ const int IntHashSet<Hasher, Equal>::MAX_DISTANCE;
 
 template<typename Hasher, typename Equal>
 const unsigned int IntHashSet<Hasher, Equal>::MAX_BUCKETS;
+
+template<typename Hasher, typename Equal>
+const uint8_t IntHashSet<Hasher, Equal>::empty_bucket_fingerprint;
 }
 
 #endif
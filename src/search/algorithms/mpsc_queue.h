@@ -0,0 +1,87 @@
+#ifndef ALGORITHMS_MPSC_QUEUE_H
+#define ALGORITHMS_MPSC_QUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace mpsc_queue {
+/*
+  Lock-free queue for many producers and a single consumer.
+
+  Producers push elements with a compare-and-swap on the head of a singly
+  linked list. The consumer never removes individual elements but takes the
+  whole list at once with an atomic exchange (pop_all), which avoids the ABA
+  problem of lock-free stacks and lets the consumer process messages in
+  batches. pop_all returns the elements in the order in which they were
+  pushed.
+
+  The class is intended for passing messages between search threads (see
+  HDAStarSearch), where each thread owns one queue as its inbox.
+*/
+template<typename T>
+class MPSCQueue {
+    struct Node {
+        T value;
+        Node *next;
+
+        explicit Node(T &&value)
+            : value(std::move(value)),
+              next(nullptr) {
+        }
+    };
+
+    std::atomic<Node *> head;
+
+public:
+    MPSCQueue()
+        : head(nullptr) {
+    }
+
+    MPSCQueue(const MPSCQueue &) = delete;
+    MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+    ~MPSCQueue() {
+        Node *node = head.load(std::memory_order_relaxed);
+        while (node) {
+            Node *next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    // Can be called concurrently by any number of threads.
+    void push(T value) {
+        Node *node = new Node(std::move(value));
+        node->next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(
+                   node->next, node,
+                   std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Must only be called by the consumer thread.
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == nullptr;
+    }
+
+    /*
+      Move all elements to the end of result (oldest first). Must only be
+      called by the consumer thread.
+    */
+    void pop_all(std::vector<T> &result) {
+        Node *node = head.exchange(nullptr, std::memory_order_acquire);
+        size_t old_size = result.size();
+        while (node) {
+            result.push_back(std::move(node->value));
+            Node *next = node->next;
+            delete node;
+            node = next;
+        }
+        std::reverse(result.begin() + old_size, result.end());
+    }
+};
+}
+
+#endif
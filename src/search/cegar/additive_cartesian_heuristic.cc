@@ -8,6 +8,7 @@
 #include "../option_parser.h"
 #include "../plugin.h"
 
+#include "../utils/heuristic_cache.h"
 #include "../utils/logging.h"
 #include "../utils/markup.h"
 #include "../utils/rng.h"
@@ -42,8 +43,58 @@ static vector<CartesianHeuristicFunction> generate_heuristic_functions(
 
 AdditiveCartesianHeuristic::AdditiveCartesianHeuristic(
     const options::Options &opts)
-    : Heuristic(opts),
-      heuristic_functions(generate_heuristic_functions(opts, log)) {
+    : Heuristic(opts) {
+    string cache_key;
+    if (utils::uses_heuristic_cache()) {
+        cache_key = compute_cache_key("cartesian");
+        if (load_from_cache(cache_key)) {
+            if (log.is_at_least_normal()) {
+                log << "Loaded " << heuristic_functions.size()
+                    << " Cartesian abstraction(s) from the heuristic cache."
+                    << endl;
+            }
+            return;
+        }
+    }
+    heuristic_functions = generate_heuristic_functions(opts, log);
+    if (!cache_key.empty()) {
+        store_in_cache(cache_key);
+    }
+}
+
+bool AdditiveCartesianHeuristic::load_from_cache(const string &key) {
+    unique_ptr<utils::CacheReader> reader =
+        utils::CacheReader::open("cartesian", key);
+    if (!reader) {
+        return false;
+    }
+    int num_functions = reader->read_int();
+    if (num_functions < 0) {
+        return false;
+    }
+    for (int i = 0; i < num_functions; ++i) {
+        unique_ptr<CartesianHeuristicFunction> function =
+            CartesianHeuristicFunction::load(*reader, task);
+        if (!function) {
+            heuristic_functions.clear();
+            return false;
+        }
+        heuristic_functions.push_back(move(*function));
+    }
+    if (!reader->is_complete()) {
+        heuristic_functions.clear();
+        return false;
+    }
+    return true;
+}
+
+void AdditiveCartesianHeuristic::store_in_cache(const string &key) const {
+    utils::CacheWriter writer("cartesian", key);
+    writer.write_int(heuristic_functions.size());
+    for (const CartesianHeuristicFunction &function : heuristic_functions) {
+        function.save(writer, task);
+    }
+    writer.commit();
 }
 
 int AdditiveCartesianHeuristic::compute_heuristic(const State &ancestor_state) {
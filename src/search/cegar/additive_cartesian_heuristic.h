@@ -3,6 +3,7 @@
 
 #include "../heuristic.h"
 
+#include <string>
 #include <vector>
 
 namespace cegar {
@@ -13,7 +14,10 @@ class CartesianHeuristicFunction;
   summing all of their values.
 */
 class AdditiveCartesianHeuristic : public Heuristic {
-    const std::vector<CartesianHeuristicFunction> heuristic_functions;
+    std::vector<CartesianHeuristicFunction> heuristic_functions;
+
+    bool load_from_cache(const std::string &key);
+    void store_in_cache(const std::string &key) const;
 
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
@@ -3,6 +3,8 @@
 #include "refinement_hierarchy.h"
 
 #include "../utils/collections.h"
+#include "../utils/heuristic_cache.h"
+#include "../utils/memory.h"
 
 using namespace std;
 
@@ -19,4 +21,27 @@ int CartesianHeuristicFunction::get_value(const State &state) const {
     assert(utils::in_bounds(abstract_state_id, h_values));
     return h_values[abstract_state_id];
 }
+
+void CartesianHeuristicFunction::save(
+    utils::CacheWriter &writer,
+    const shared_ptr<AbstractTask> &ancestor_task) const {
+    writer.write_vector(h_values);
+    refinement_hierarchy->save(writer, ancestor_task);
+}
+
+unique_ptr<CartesianHeuristicFunction> CartesianHeuristicFunction::load(
+    utils::CacheReader &reader,
+    const shared_ptr<AbstractTask> &ancestor_task) {
+    vector<int> h_values = reader.read_vector<int>();
+    if (!reader.is_valid()) {
+        return nullptr;
+    }
+    unique_ptr<RefinementHierarchy> hierarchy = RefinementHierarchy::load(
+        reader, ancestor_task, h_values.size());
+    if (!hierarchy) {
+        return nullptr;
+    }
+    return utils::make_unique_ptr<CartesianHeuristicFunction>(
+        move(hierarchy), move(h_values));
+}
 }
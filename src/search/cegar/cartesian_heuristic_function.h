@@ -4,8 +4,14 @@
 #include <memory>
 #include <vector>
 
+class AbstractTask;
 class State;
 
+namespace utils {
+class CacheReader;
+class CacheWriter;
+}
+
 namespace cegar {
 class RefinementHierarchy;
 /*
@@ -26,6 +32,14 @@ public:
     CartesianHeuristicFunction(CartesianHeuristicFunction &&) = default;
 
     int get_value(const State &state) const;
+
+    // See RefinementHierarchy::save() and RefinementHierarchy::load().
+    void save(
+        utils::CacheWriter &writer,
+        const std::shared_ptr<AbstractTask> &ancestor_task) const;
+    static std::unique_ptr<CartesianHeuristicFunction> load(
+        utils::CacheReader &reader,
+        const std::shared_ptr<AbstractTask> &ancestor_task);
 };
 }
 
@@ -2,6 +2,11 @@
 
 #include "../task_proxy.h"
 
+#include "../tasks/domain_abstracted_task.h"
+#include "../utils/heuristic_cache.h"
+
+#include <algorithm>
+
 using namespace std;
 
 namespace cegar {
@@ -50,6 +55,168 @@ RefinementHierarchy::RefinementHierarchy(const shared_ptr<AbstractTask> &task)
     nodes.emplace_back(0);
 }
 
+RefinementHierarchy::RefinementHierarchy(
+    const shared_ptr<AbstractTask> &task, vector<Node> &&nodes)
+    : task(task),
+      nodes(move(nodes)) {
+}
+
+/*
+  Since the task of the hierarchy maps each variable independently, the
+  value map can be computed by converting one state per value.
+*/
+static vector<vector<int>> compute_value_map(
+    const TaskProxy &ancestor_task_proxy, const TaskProxy &task_proxy) {
+    VariablesProxy variables = ancestor_task_proxy.get_variables();
+    int num_variables = variables.size();
+    assert(static_cast<int>(task_proxy.get_variables().size()) == num_variables);
+    int max_domain_size = 0;
+    for (VariableProxy var : variables) {
+        max_domain_size = max(max_domain_size, var.get_domain_size());
+    }
+    vector<vector<int>> value_map(num_variables);
+    for (int value = 0; value < max_domain_size; ++value) {
+        vector<int> values(num_variables);
+        for (int var = 0; var < num_variables; ++var) {
+            values[var] = min(value, variables[var].get_domain_size() - 1);
+        }
+        State state = ancestor_task_proxy.create_state(move(values));
+        State converted_state = task_proxy.convert_ancestor_state(state);
+        for (int var = 0; var < num_variables; ++var) {
+            if (value < variables[var].get_domain_size()) {
+                value_map[var].push_back(converted_state[var].get_value());
+            }
+        }
+    }
+    return value_map;
+}
+
+static bool is_identity(const vector<vector<int>> &value_map) {
+    for (const vector<int> &values : value_map) {
+        for (size_t value = 0; value < values.size(); ++value) {
+            if (values[value] != static_cast<int>(value)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static shared_ptr<AbstractTask> create_domain_abstracted_task(
+    const shared_ptr<AbstractTask> &parent,
+    vector<vector<int>> &&value_map) {
+    TaskProxy parent_proxy(*parent);
+    VariablesProxy variables = parent_proxy.get_variables();
+    int num_variables = variables.size();
+    vector<int> domain_size(num_variables, 0);
+    vector<vector<string>> fact_names(num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        for (size_t value = 0; value < value_map[var].size(); ++value) {
+            int abstract_value = value_map[var][value];
+            if (abstract_value >= domain_size[var]) {
+                domain_size[var] = abstract_value + 1;
+                fact_names[var].resize(domain_size[var]);
+            }
+            if (fact_names[var][abstract_value].empty()) {
+                fact_names[var][abstract_value] =
+                    variables[var].get_fact(value).get_name();
+            }
+        }
+    }
+    vector<int> initial_state_values = parent->get_initial_state_values();
+    for (int var = 0; var < num_variables; ++var) {
+        initial_state_values[var] = value_map[var][initial_state_values[var]];
+    }
+    vector<FactPair> goals;
+    for (FactProxy goal : parent_proxy.get_goals()) {
+        FactPair fact = goal.get_pair();
+        goals.emplace_back(fact.var, value_map[fact.var][fact.value]);
+    }
+    return make_shared<extra_tasks::DomainAbstractedTask>(
+        parent, move(domain_size), move(initial_state_values), move(goals),
+        move(fact_names), move(value_map));
+}
+
+void RefinementHierarchy::save(
+    utils::CacheWriter &writer,
+    const shared_ptr<AbstractTask> &ancestor_task) const {
+    vector<vector<int>> value_map = compute_value_map(
+        TaskProxy(*ancestor_task), TaskProxy(*task));
+    for (const vector<int> &values : value_map) {
+        writer.write_vector(values);
+    }
+    vector<int> node_data;
+    node_data.reserve(5 * nodes.size());
+    for (const Node &node : nodes) {
+        node_data.push_back(node.left_child);
+        node_data.push_back(node.right_child);
+        node_data.push_back(node.var);
+        node_data.push_back(node.value);
+        node_data.push_back(node.state_id);
+    }
+    writer.write_vector(node_data);
+}
+
+unique_ptr<RefinementHierarchy> RefinementHierarchy::load(
+    utils::CacheReader &reader,
+    const shared_ptr<AbstractTask> &ancestor_task,
+    int num_states) {
+    VariablesProxy variables = TaskProxy(*ancestor_task).get_variables();
+    int num_variables = variables.size();
+    vector<vector<int>> value_map;
+    value_map.reserve(num_variables);
+    for (VariableProxy var : variables) {
+        value_map.push_back(reader.read_vector<int>());
+        if (static_cast<int>(value_map.back().size()) != var.get_domain_size()) {
+            return nullptr;
+        }
+        for (int abstract_value : value_map.back()) {
+            if (abstract_value < 0 || abstract_value >= var.get_domain_size()) {
+                return nullptr;
+            }
+        }
+    }
+    vector<int> node_data = reader.read_vector<int>();
+    int num_nodes = node_data.size() / 5;
+    if (!reader.is_valid() || num_nodes == 0 ||
+        static_cast<int>(node_data.size()) != 5 * num_nodes) {
+        return nullptr;
+    }
+    vector<Node> nodes;
+    nodes.reserve(num_nodes);
+    for (int id = 0; id < num_nodes; ++id) {
+        const int *data = &node_data[5 * id];
+        Node node(0);
+        node.left_child = data[0];
+        node.right_child = data[1];
+        node.var = data[2];
+        node.value = data[3];
+        node.state_id = data[4];
+        bool is_valid;
+        if (node.left_child == UNDEFINED) {
+            is_valid = node.right_child == UNDEFINED &&
+                node.var == UNDEFINED && node.value == UNDEFINED &&
+                node.state_id >= 0 && node.state_id < num_states;
+        } else {
+            // Children are always added after their parents.
+            is_valid = node.left_child > id && node.left_child < num_nodes &&
+                node.right_child > id && node.right_child < num_nodes &&
+                node.var >= 0 && node.var < num_variables &&
+                node.state_id == UNDEFINED;
+        }
+        if (!is_valid) {
+            return nullptr;
+        }
+        nodes.push_back(node);
+    }
+    shared_ptr<AbstractTask> task = ancestor_task;
+    if (!is_identity(value_map)) {
+        task = create_domain_abstracted_task(ancestor_task, move(value_map));
+    }
+    return unique_ptr<RefinementHierarchy>(
+        new RefinementHierarchy(task, move(nodes)));
+}
+
 NodeID RefinementHierarchy::add_node(int state_id) {
     NodeID node_id = nodes.size();
     nodes.emplace_back(state_id);
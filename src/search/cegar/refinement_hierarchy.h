@@ -12,6 +12,11 @@
 class AbstractTask;
 class State;
 
+namespace utils {
+class CacheReader;
+class CacheWriter;
+}
+
 namespace cegar {
 class Node;
 
@@ -34,9 +39,31 @@ class RefinementHierarchy {
     NodeID add_node(int state_id);
     NodeID get_node_id(const State &state) const;
 
+    RefinementHierarchy(
+        const std::shared_ptr<AbstractTask> &task, std::vector<Node> &&nodes);
+
 public:
     explicit RefinementHierarchy(const std::shared_ptr<AbstractTask> &task);
 
+    /*
+      Store the hierarchy in a heuristic cache entry. Instead of the task of
+      the hierarchy, which can be a transformation of ancestor_task, we store
+      how it maps the values of ancestor_task. This only works for tasks
+      that map each variable independently, like domain abstractions.
+    */
+    void save(
+        utils::CacheWriter &writer,
+        const std::shared_ptr<AbstractTask> &ancestor_task) const;
+    /*
+      Load a hierarchy stored with save() for the same ancestor task. Return
+      nullptr if the entry does not contain a valid hierarchy whose states
+      are smaller than num_states.
+    */
+    static std::unique_ptr<RefinementHierarchy> load(
+        utils::CacheReader &reader,
+        const std::shared_ptr<AbstractTask> &ancestor_task,
+        int num_states);
+
     /*
       Update the split tree for the new split. Additionally to the left
       and right child nodes add |values|-1 helper nodes that all have
@@ -96,6 +123,7 @@ public:
     }
 
     friend std::ostream &operator<<(std::ostream &os, const Node &node);
+    friend class RefinementHierarchy;
 };
 }
 
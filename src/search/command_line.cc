@@ -3,10 +3,14 @@
 #include "option_parser.h"
 #include "plan_manager.h"
 #include "search_engine.h"
+#include "state_registry.h"
 
 #include "options/doc_printer.h"
 #include "options/predefinitions.h"
 #include "options/registries.h"
+#include "task_utils/successor_generator_factory.h"
+#include "utils/heuristic_cache.h"
+#include "utils/mapped_storage.h"
 #include "utils/strings.h"
 
 #include <algorithm>
@@ -49,6 +53,7 @@ static shared_ptr<SearchEngine> parse_cmd_line_aux(
     options::Predefinitions predefinitions;
     string shared_memory_name;
     bool no_cache = false;
+    bool parsed_search = false;
 
     shared_ptr<SearchEngine> engine;
     /*
@@ -66,6 +71,7 @@ static shared_ptr<SearchEngine> parse_cmd_line_aux(
             OptionParser parser(sanitize_arg_string(args[i]), registry,
                                 predefinitions, dry_run);
             engine = parser.start_parsing<shared_ptr<SearchEngine>>();
+            parsed_search = true;
         } else if (arg == "--help" && dry_run) {
             cout << "Help:" << endl;
             bool txt2tags = false;
@@ -122,6 +128,57 @@ static shared_ptr<SearchEngine> parse_cmd_line_aux(
             shared_memory_name = args[i];
         } else if (arg == "--no-cache") {
             no_cache = true;
+        } else if (arg == "--state-storage") {
+            if (is_last)
+                throw ArgError("missing argument after --state-storage");
+            ++i;
+            if (parsed_search)
+                throw ArgError("--state-storage must be given before --search");
+            string storage = sanitize_arg_string(args[i]);
+            if (utils::startswith(storage, "mmap:") && storage.size() > 5) {
+                // Use the unsanitized argument for the directory name.
+                if (!dry_run)
+                    utils::use_mapped_storage(args[i].substr(5));
+            } else if (storage == "compressed") {
+                StateRegistry::use_compression(true);
+            } else if (storage != "memory") {
+                throw ArgError("argument for --state-storage must be "
+                               "'memory', 'compressed' or 'mmap:DIRECTORY'");
+            }
+        } else if (arg == "--registry-hash") {
+            if (is_last)
+                throw ArgError("missing argument after --registry-hash");
+            ++i;
+            if (parsed_search)
+                throw ArgError("--registry-hash must be given before --search");
+            string hash = sanitize_arg_string(args[i]);
+            if (hash == "fingerprints") {
+                StateRegistry::use_hash_fingerprints(true);
+            } else if (hash != "plain") {
+                throw ArgError("argument for --registry-hash must be "
+                               "'plain' or 'fingerprints'");
+            }
+        } else if (arg == "--heuristic-cache-dir") {
+            if (is_last)
+                throw ArgError("missing argument after --heuristic-cache-dir");
+            ++i;
+            if (parsed_search)
+                throw ArgError("--heuristic-cache-dir must be given before --search");
+            if (!dry_run)
+                utils::use_heuristic_cache(args[i]);
+        } else if (arg == "--successor-generator") {
+            if (is_last)
+                throw ArgError("missing argument after --successor-generator");
+            ++i;
+            if (parsed_search)
+                throw ArgError("--successor-generator must be given before --search");
+            string generator = sanitize_arg_string(args[i]);
+            if (generator == "masks") {
+                successor_generator::SuccessorGeneratorFactory::use_precondition_masks(true);
+            } else if (generator != "tree") {
+                throw ArgError("argument for --successor-generator must be "
+                               "'tree' or 'masks'");
+            }
         } else {
             throw ArgError("unknown option " + arg);
         }
@@ -165,9 +222,12 @@ shared_ptr<SearchEngine> parse_cmd_line(
 
 string usage(const string &progname) {
     return "usage: \n" +
-           progname + " [OPTIONS] --search SEARCH < OUTPUT\n\n"
+           progname + " [OPTIONS] --search SEARCH < OUTPUT\n" +
+           progname + " --write-binary-task TASKFILE < OUTPUT\n\n"
            "* SEARCH (SearchEngine): configuration of the search algorithm\n"
-           "* OUTPUT (filename): translator output\n\n"
+           "* OUTPUT (filename): translator output or binary task file\n"
+           "* TASKFILE (filename): where to write the task in binary format,\n"
+           "  which can be passed as OUTPUT and loads much faster\n\n"
            "Options:\n"
            "--help [NAME]\n"
            "    Prints help for all heuristics, open lists, etc. called NAME.\n"
@@ -178,6 +238,29 @@ string usage(const string &progname) {
            "--evaluator EVALUATOR_PREDEFINITION\n"
            "    Predefines an evaluator that can afterwards be referenced\n"
            "    by the name that is specified in the definition.\n"
+           "--state-storage STORAGE\n"
+           "    Where to store registered states and per-state information:\n"
+           "    'memory' (default), 'compressed' to store states delta-encoded\n"
+           "    in memory (slower, but needs less memory), or 'mmap:DIRECTORY'\n"
+           "    to place them in a memory-mapped temporary file in DIRECTORY,\n"
+           "    which lets the operating system move rarely used data to disk.\n"
+           "    Must be given before --search.\n"
+           "--registry-hash HASH\n"
+           "    How the state registry detects duplicate states: 'plain' (default)\n"
+           "    compares the stored hashes of all candidate buckets, 'fingerprints'\n"
+           "    first compares one-byte fingerprints of the hashes with SIMD\n"
+           "    instructions and needs one more byte per bucket. Must be given\n"
+           "    before --search.\n"
+           "--heuristic-cache-dir DIRECTORY\n"
+           "    Store pattern databases, Cartesian abstractions and merge-and-shrink\n"
+           "    abstractions in DIRECTORY and reuse them in later runs on the same\n"
+           "    task with the same heuristic parameters. Must be given before\n"
+           "    --search.\n"
+           "--successor-generator GENERATOR\n"
+           "    How to compute applicable operators: 'tree' (default) walks a\n"
+           "    decision tree over the preconditions, 'masks' tests 64 operators\n"
+           "    at a time with precondition bitmasks. Which one is faster depends\n"
+           "    on the task. Must be given before --search.\n"
            "--internal-plan-file FILENAME\n"
            "    Plan will be output to a file called FILENAME\n\n"
            "--internal-previous-portfolio-plans COUNTER\n"
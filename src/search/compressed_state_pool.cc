@@ -0,0 +1,132 @@
+#include "compressed_state_pool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+using namespace std;
+
+const int CompressedStatePool::MAX_BLOCK_SIZE;
+const size_t CompressedStatePool::MIN_CHUNK_BYTES;
+
+static int count_bits(uint8_t byte) {
+    int num_bits = 0;
+    for (; byte; byte &= byte - 1) {
+        ++num_bits;
+    }
+    return num_bits;
+}
+
+CompressedStatePool::CompressedStatePool(int num_bins)
+    : state_bytes(num_bins * sizeof(PackedStateBin)),
+      mask_bytes((state_bytes + 7) / 8),
+      max_block_bytes(state_bytes +
+                      (MAX_BLOCK_SIZE - 1) * (mask_bytes + state_bytes)),
+      chunk_bytes(max(MIN_CHUNK_BYTES, max_block_bytes)),
+      write_pos(nullptr),
+      chunk_end(nullptr),
+      last_state_start(nullptr),
+      num_states(0),
+      num_encoded_bytes(0) {
+    assert(num_bins > 0);
+}
+
+CompressedStatePool::~CompressedStatePool() {
+    for (uint8_t *chunk : chunks) {
+        utils::deallocate_mapped_storage(chunk, chunk_bytes);
+    }
+}
+
+void CompressedStatePool::start_block() {
+    if (static_cast<size_t>(chunk_end - write_pos) < max_block_bytes) {
+        // The rest of the current chunk stays unused.
+        uint8_t *chunk = static_cast<uint8_t *>(
+            utils::allocate_mapped_storage(chunk_bytes));
+        chunks.push_back(chunk);
+        write_pos = chunk;
+        chunk_end = chunk + chunk_bytes;
+    }
+    block_starts.push_back(write_pos);
+}
+
+const uint8_t *CompressedStatePool::find_state(size_t index) const {
+    const uint8_t *pos = block_starts[index / MAX_BLOCK_SIZE];
+    int index_in_block = index % MAX_BLOCK_SIZE;
+    if (index_in_block == 0) {
+        return pos;
+    }
+    pos += state_bytes;
+    for (int i = 1; i < index_in_block; ++i) {
+        int num_diff_bytes = 0;
+        for (int j = 0; j < mask_bytes; ++j) {
+            num_diff_bytes += count_bits(pos[j]);
+        }
+        pos += mask_bytes + num_diff_bytes;
+    }
+    return pos;
+}
+
+void CompressedStatePool::push_back(const PackedStateBin *state) {
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(state);
+    if (num_states % MAX_BLOCK_SIZE == 0) {
+        start_block();
+        last_state_start = write_pos;
+        memcpy(write_pos, data, state_bytes);
+        write_pos += state_bytes;
+        num_encoded_bytes += state_bytes;
+        ++num_states;
+        return;
+    }
+
+    const uint8_t *reference = block_starts[block_starts.size() - 1];
+    last_state_start = write_pos;
+    uint8_t *mask = write_pos;
+    uint8_t *diff = mask + mask_bytes;
+    fill_n(mask, mask_bytes, 0);
+    for (int i = 0; i < state_bytes; ++i) {
+        uint8_t byte_diff = data[i] ^ reference[i];
+        if (byte_diff) {
+            mask[i / 8] |= 1 << (i % 8);
+            *diff++ = byte_diff;
+        }
+    }
+    num_encoded_bytes += diff - write_pos;
+    write_pos = diff;
+    ++num_states;
+}
+
+void CompressedStatePool::pop_back() {
+    // We only keep track of the start of the last state.
+    assert(last_state_start);
+    --num_states;
+    num_encoded_bytes -= write_pos - last_state_start;
+    write_pos = last_state_start;
+    last_state_start = nullptr;
+    if (num_states % MAX_BLOCK_SIZE == 0) {
+        block_starts.pop_back();
+    }
+}
+
+void CompressedStatePool::decompress(size_t index, PackedStateBin *state) const {
+    assert(index < size());
+    const uint8_t *reference = block_starts[index / MAX_BLOCK_SIZE];
+    uint8_t *data = reinterpret_cast<uint8_t *>(state);
+    memcpy(data, reference, state_bytes);
+    if (index % MAX_BLOCK_SIZE == 0) {
+        return;
+    }
+    const uint8_t *mask = find_state(index);
+    const uint8_t *diff = mask + mask_bytes;
+    for (int mask_byte = 0; mask_byte < mask_bytes; ++mask_byte) {
+        uint8_t bits = mask[mask_byte];
+        for (int i = mask_byte * 8; bits; ++i, bits >>= 1) {
+            if (bits & 1) {
+                data[i] ^= *diff++;
+            }
+        }
+    }
+}
+
+size_t CompressedStatePool::get_num_used_bytes() const {
+    return num_encoded_bytes + block_starts.size() * sizeof(uint8_t *);
+}
@@ -0,0 +1,75 @@
+#ifndef COMPRESSED_STATE_POOL_H
+#define COMPRESSED_STATE_POOL_H
+
+#include "algorithms/int_packer.h"
+#include "algorithms/segmented_vector.h"
+#include "utils/mapped_storage.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+  Append-only store for packed states that trades decompression time for
+  memory. It can replace the SegmentedArrayVector<PackedStateBin> of a
+  StateRegistry (see StateRegistry::use_compression).
+
+  States are grouped into blocks of 32 consecutively stored states.
+  The first state of a block is stored verbatim and serves as the block's
+  reference. Every other state is stored as the byte-wise XOR with the
+  reference: a bit mask marking the non-zero bytes of the XOR, followed by
+  these bytes. Consecutively registered states are often successors of the
+  same state and typically differ from the reference in a few bytes only.
+
+  Blocks are stored contiguously in large chunks. Apart from the encoded
+  data, we only store a pointer to the start of each block. To find a state
+  within its block, we skip the preceding states of the block, whose sizes
+  follow from the number of bits set in their masks. Decompressing a state
+  copies the reference and applies the stored differences.
+*/
+class CompressedStatePool {
+    using PackedStateBin = int_packer::IntPacker::Bin;
+    static const int MAX_BLOCK_SIZE = 32;
+    static const std::size_t MIN_CHUNK_BYTES = 1 << 20;
+
+    const int state_bytes;
+    const int mask_bytes;
+    const std::size_t max_block_bytes;
+    const std::size_t chunk_bytes;
+
+    std::vector<std::uint8_t *> chunks;
+    std::uint8_t *write_pos;
+    std::uint8_t *chunk_end;
+    // Start of the last stored state, needed for pop_back.
+    std::uint8_t *last_state_start;
+    std::size_t num_states;
+    std::size_t num_encoded_bytes;
+
+    segmented_vector::SegmentedVector<
+        std::uint8_t *, utils::MappedStorageAllocator<std::uint8_t *>> block_starts;
+
+    void start_block();
+    const std::uint8_t *find_state(std::size_t index) const;
+public:
+    explicit CompressedStatePool(int num_bins);
+    ~CompressedStatePool();
+
+    CompressedStatePool(const CompressedStatePool &) = delete;
+    CompressedStatePool &operator=(const CompressedStatePool &) = delete;
+
+    void push_back(const PackedStateBin *state);
+    void pop_back();
+    void decompress(std::size_t index, PackedStateBin *state) const;
+
+    std::size_t size() const {
+        return num_states;
+    }
+
+    /*
+      Return the number of bytes used for the encoded states and the block
+      pointers, not counting unused space at the end of the current chunk.
+    */
+    std::size_t get_num_used_bytes() const;
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef CONCURRENT_PER_STATE_INFORMATION_H
+#define CONCURRENT_PER_STATE_INFORMATION_H
+
+#include "state_id.h"
+
+#include "algorithms/concurrent_segmented_vector.h"
+
+#include <cassert>
+
+/*
+  Thread-safe counterpart of PerStateInformation for states registered in a
+  ConcurrentStateRegistry.
+
+  Entries are indexed by StateID and default-constructed (or set to the
+  given default value) on first access. The underlying storage grows
+  without moving entries, so threads can access entries of different states
+  concurrently while other threads add new ones. Concurrent access to the
+  entry of the same state must be synchronized by the caller.
+
+  Unlike PerStateInformation, this class does not subscribe to a registry,
+  so it must only be used with IDs from a single ConcurrentStateRegistry.
+*/
+template<class Entry>
+class ConcurrentPerStateInformation {
+    concurrent_segmented_vector::ConcurrentSegmentedArrayVector<Entry> entries;
+
+public:
+    ConcurrentPerStateInformation()
+        : entries(1) {
+    }
+
+    explicit ConcurrentPerStateInformation(const Entry &default_value)
+        : entries(1, default_value) {
+    }
+
+    ConcurrentPerStateInformation(const ConcurrentPerStateInformation<Entry> &) = delete;
+    ConcurrentPerStateInformation &operator=(
+        const ConcurrentPerStateInformation<Entry> &) = delete;
+
+    Entry &operator[](StateID id) {
+        assert(id != StateID::no_state);
+        return *entries[id.value];
+    }
+};
+
+#endif
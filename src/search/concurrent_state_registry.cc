@@ -0,0 +1,60 @@
+#include "concurrent_state_registry.h"
+
+#include "task_utils/task_properties.h"
+#include "utils/logging.h"
+
+#include <vector>
+
+using namespace std;
+
+ConcurrentStateRegistry::ConcurrentStateRegistry(
+    const TaskProxy &task_proxy, int num_stripes)
+    : task_proxy(task_proxy),
+      state_packer(task_properties::g_state_packers[task_proxy]),
+      num_variables(task_proxy.get_variables().size()),
+      registered_states(state_packer.get_num_bins(), num_stripes) {
+    task_properties::verify_no_axioms(task_proxy);
+}
+
+pair<StateID, bool> ConcurrentStateRegistry::insert_packed_state(
+    const PackedStateBin *buffer) {
+    pair<int, bool> result = registered_states.insert(buffer);
+    return make_pair(StateID(result.first), result.second);
+}
+
+pair<StateID, bool> ConcurrentStateRegistry::insert_state(const State &state) {
+    const vector<int> &values = state.get_unpacked_values();
+    // Avoid garbage values in half-full bins.
+    vector<PackedStateBin> buffer(state_packer.get_num_bins(), 0);
+    for (int var = 0; var < num_variables; ++var) {
+        state_packer.set(buffer.data(), var, values[var]);
+    }
+    return insert_packed_state(buffer.data());
+}
+
+pair<StateID, bool> ConcurrentStateRegistry::insert_successor_state(
+    const State &predecessor, const OperatorProxy &op) {
+    return insert_state(predecessor.get_unregistered_successor(op));
+}
+
+StateID ConcurrentStateRegistry::insert_initial_state() {
+    return insert_state(task_proxy.get_initial_state()).first;
+}
+
+State ConcurrentStateRegistry::lookup_state(StateID id) const {
+    const PackedStateBin *buffer = lookup_packed_state(id);
+    vector<int> values(num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        values[var] = state_packer.get(buffer, var);
+    }
+    return task_proxy.create_state(move(values));
+}
+
+int ConcurrentStateRegistry::get_state_size_in_bytes() const {
+    return state_packer.get_num_bins() * sizeof(PackedStateBin);
+}
+
+void ConcurrentStateRegistry::print_statistics(utils::LogProxy &log) const {
+    log << "Number of registered states: " << size() << endl;
+    registered_states.print_statistics(log);
+}
@@ -0,0 +1,94 @@
+#ifndef CONCURRENT_STATE_REGISTRY_H
+#define CONCURRENT_STATE_REGISTRY_H
+
+#include "state_id.h"
+#include "task_proxy.h"
+
+#include "algorithms/concurrent_array_set.h"
+#include "algorithms/int_packer.h"
+
+#include <utility>
+
+namespace utils {
+class LogProxy;
+}
+
+/*
+  Thread-safe counterpart of StateRegistry for search algorithms in which
+  several threads share one closed list.
+
+  Packed states are stored in a ConcurrentArraySet, so registering states
+  only locks one of num_stripes stripes of the hash index and looking up
+  registered states does not lock at all. See concurrent_array_set.h for
+  the rules on sharing StateIDs between threads and for why IDs are not
+  dense.
+
+  States returned by this class are unregistered states with unpacked
+  values, since State objects can only refer to a StateRegistry.
+  Consequently, they cannot be used with PerStateInformation or with
+  evaluators that cache their estimates. Use ConcurrentPerStateInformation,
+  which is indexed by StateID, to associate data with the states.
+
+  Tasks with axioms are not supported because evaluating axioms is not
+  thread-safe.
+*/
+class ConcurrentStateRegistry {
+    TaskProxy task_proxy;
+    const int_packer::IntPacker &state_packer;
+    const int num_variables;
+
+    concurrent_array_set::ConcurrentArraySet<PackedStateBin> registered_states;
+
+public:
+    ConcurrentStateRegistry(const TaskProxy &task_proxy, int num_stripes);
+
+    const TaskProxy &get_task_proxy() const {
+        return task_proxy;
+    }
+
+    const int_packer::IntPacker &get_state_packer() const {
+        return state_packer;
+    }
+
+    /*
+      Register the given packed data if this was not done before. Return
+      the ID of the state and whether it was newly registered.
+    */
+    std::pair<StateID, bool> insert_packed_state(const PackedStateBin *buffer);
+
+    /*
+      Register the given state, which must have unpacked data (e.g., a state
+      returned by lookup_state), if this was not done before.
+    */
+    std::pair<StateID, bool> insert_state(const State &state);
+
+    // Register the successor of predecessor, which must have unpacked data.
+    std::pair<StateID, bool> insert_successor_state(
+        const State &predecessor, const OperatorProxy &op);
+
+    StateID insert_initial_state();
+
+    const PackedStateBin *lookup_packed_state(StateID id) const {
+        return registered_states.lookup(id.value);
+    }
+
+    // Return an unregistered copy of the state with unpacked data.
+    State lookup_state(StateID id) const;
+
+    // Return the number of states registered so far.
+    int size() const {
+        return registered_states.size();
+    }
+
+    // Return an upper bound for the values of all StateIDs handed out so far.
+    int get_id_bound() const {
+        return registered_states.get_id_bound();
+    }
+
+    int get_state_size_in_bytes() const;
+
+    // Must not be called while other threads register states.
+    void print_statistics(utils::LogProxy &log) const;
+};
+
+#endif
@@ -55,6 +55,19 @@ const EvaluationResult &EvaluationContext::get_result(Evaluator *evaluator) {
     return result;
 }
 
+void EvaluationContext::store_result(
+    Evaluator *evaluator, const EvaluationResult &result) {
+    EvaluationResult &cached_result = cache[evaluator];
+    assert(cached_result.is_uninitialized());
+    assert(!result.is_uninitialized());
+    cached_result = result;
+    if (statistics &&
+        evaluator->is_used_for_counting_evaluations() &&
+        result.get_count_evaluation()) {
+        statistics->inc_evaluations();
+    }
+}
+
 const EvaluatorCache &EvaluationContext::get_cache() const {
     return cache;
 }
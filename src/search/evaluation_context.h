@@ -89,6 +89,12 @@ public:
         SearchStatistics *statistics = nullptr, bool calculate_preferred = false);
 
     const EvaluationResult &get_result(Evaluator *eval);
+    /*
+      Store a result for eval that has been computed elsewhere, e.g. by a
+      copy of eval running in another thread. Afterwards, the result is
+      treated exactly as if it had been computed by get_result(eval).
+    */
+    void store_result(Evaluator *eval, const EvaluationResult &result);
     const EvaluatorCache &get_cache() const;
     const State &get_state() const;
     int get_g_value() const;
@@ -1,5 +1,6 @@
 #include "evaluator.h"
 
+#include "evaluation_context.h"
 #include "option_parser.h"
 #include "plugin.h"
 
@@ -63,6 +64,20 @@ bool Evaluator::is_used_for_counting_evaluations() const {
     return use_for_counting_evaluations;
 }
 
+void Evaluator::compute_results(
+    vector<EvaluationContext> &eval_contexts,
+    vector<EvaluationResult> &results) {
+    results.clear();
+    results.reserve(eval_contexts.size());
+    for (EvaluationContext &eval_context : eval_contexts) {
+        results.push_back(eval_context.get_result(this));
+    }
+}
+
+bool Evaluator::supports_batch_evaluation() const {
+    return false;
+}
+
 bool Evaluator::does_cache_estimates() const {
     return false;
 }
@@ -75,6 +90,9 @@ int Evaluator::get_cached_estimate(const State &) const {
     ABORT("Called get_cached_estimate when estimate is not cached.");
 }
 
+void Evaluator::cache_estimate(const State &, int) {
+}
+
 void add_evaluator_options_to_parser(options::OptionParser &parser) {
     utils::add_log_options_to_parser(parser);
 }
@@ -6,6 +6,7 @@
 #include "../utils/logging.h"
 
 #include <set>
+#include <vector>
 
 class EvaluationContext;
 class State;
@@ -84,6 +85,21 @@ public:
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) = 0;
 
+    /*
+      compute_results should compute the results for several evaluation
+      contexts at once (e.g., for all new successors of an expanded state)
+      and store the result for eval_contexts[i] in results[i]. Like
+      compute_result, it should not add the results to the contexts.
+
+      Evaluators that can share work between the states should override it
+      and return true in supports_batch_evaluation. The default
+      implementation evaluates the contexts one after another.
+    */
+    virtual void compute_results(
+        std::vector<EvaluationContext> &eval_contexts,
+        std::vector<EvaluationResult> &results);
+    virtual bool supports_batch_evaluation() const;
+
     void report_value_for_initial_state(const EvaluationResult &result) const;
     void report_new_minimum_value(const EvaluationResult &result) const;
 
@@ -99,6 +115,12 @@ public:
       the given state is cached, i.e., is_estimate_cached returns true.
     */
     virtual int get_cached_estimate(const State &state) const;
+    /*
+      Store an estimate for the given state that has been computed
+      elsewhere, e.g. by another instance of this evaluator running in a
+      different thread. Evaluators that do not cache estimates ignore it.
+    */
+    virtual void cache_estimate(const State &state, int value);
 };
 
 extern void add_evaluator_options_to_parser(options::OptionParser &parser);
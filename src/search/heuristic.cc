@@ -8,6 +8,8 @@
 #include "task_utils/task_properties.h"
 #include "tasks/cost_adapted_task.h"
 #include "tasks/root_task.h"
+#include "utils/heuristic_cache.h"
+#include "utils/language.h"
 
 #include <cassert>
 #include <cstdlib>
@@ -34,6 +36,13 @@ State Heuristic::convert_ancestor_state(const State &ancestor_state) const {
     return task_proxy.convert_ancestor_state(ancestor_state);
 }
 
+string Heuristic::compute_cache_key(const string &kind) const {
+    utils::CacheKey key(kind);
+    key.feed(get_description());
+    task_properties::add_task_to_cache_key(task_proxy, key);
+    return key.finish();
+}
+
 void Heuristic::add_options_to_parser(OptionParser &parser) {
     add_evaluator_options_to_parser(parser);
     parser.add_option<shared_ptr<AbstractTask>>(
@@ -45,26 +54,74 @@ void Heuristic::add_options_to_parser(OptionParser &parser) {
 }
 
 EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
-    EvaluationResult result;
-
     assert(preferred_operators.empty());
 
     const State &state = eval_context.get_state();
     bool calculate_preferred = eval_context.get_calculate_preferred();
 
-    int heuristic = NO_VALUE;
+    if (!calculate_preferred && has_valid_cached_estimate(state)) {
+        return create_result(state, heuristic_cache[state].h, false);
+    }
+    int heuristic = compute_heuristic(state);
+    if (cache_evaluator_values) {
+        heuristic_cache[state] = HEntry(heuristic, false);
+    }
+    return create_result(state, heuristic, true);
+}
 
-    if (!calculate_preferred && cache_evaluator_values &&
-        heuristic_cache[state].h != NO_VALUE && !heuristic_cache[state].dirty) {
-        heuristic = heuristic_cache[state].h;
-        result.set_count_evaluation(false);
-    } else {
-        heuristic = compute_heuristic(state);
+void Heuristic::compute_results(
+    vector<EvaluationContext> &eval_contexts,
+    vector<EvaluationResult> &results) {
+    results.assign(eval_contexts.size(), EvaluationResult());
+    vector<int> batch;
+    vector<State> states;
+    batch.reserve(eval_contexts.size());
+    states.reserve(eval_contexts.size());
+    for (size_t i = 0; i < eval_contexts.size(); ++i) {
+        EvaluationContext &eval_context = eval_contexts[i];
+        const State &state = eval_context.get_state();
+        if (eval_context.get_calculate_preferred()) {
+            // Preferred operators are only computed state by state.
+            results[i] = compute_result(eval_context);
+        } else if (has_valid_cached_estimate(state)) {
+            results[i] = create_result(state, heuristic_cache[state].h, false);
+        } else {
+            batch.push_back(i);
+            states.push_back(state);
+        }
+    }
+    vector<int> values;
+    compute_heuristics(states, values);
+    assert(values.size() == states.size());
+    // The batched contexts do not ask for preferred operators.
+    preferred_operators.clear();
+    for (size_t j = 0; j < batch.size(); ++j) {
+        const State &state = states[j];
         if (cache_evaluator_values) {
-            heuristic_cache[state] = HEntry(heuristic, false);
+            heuristic_cache[state] = HEntry(values[j], false);
         }
-        result.set_count_evaluation(true);
+        results[batch[j]] = create_result(state, values[j], true);
     }
+}
+
+void Heuristic::compute_heuristics(
+    const vector<State> &ancestor_states, vector<int> &values) {
+    values.clear();
+    values.reserve(ancestor_states.size());
+    for (const State &state : ancestor_states) {
+        values.push_back(compute_heuristic(state));
+    }
+}
+
+bool Heuristic::has_valid_cached_estimate(const State &state) const {
+    return cache_evaluator_values &&
+           heuristic_cache[state].h != NO_VALUE && !heuristic_cache[state].dirty;
+}
+
+EvaluationResult Heuristic::create_result(
+    const State &state, int heuristic, bool count_evaluation) {
+    EvaluationResult result;
+    result.set_count_evaluation(count_evaluation);
 
     assert(heuristic == DEAD_END || heuristic >= 0);
 
@@ -87,6 +144,8 @@ EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
         for (OperatorID op_id : preferred_operators)
             assert(task_properties::is_applicable(global_operators[op_id], state));
     }
+#else
+    utils::unused_variable(state);
 #endif
 
     result.set_evaluator_value(heuristic);
@@ -108,3 +167,12 @@ int Heuristic::get_cached_estimate(const State &state) const {
     assert(is_estimate_cached(state));
     return heuristic_cache[state].h;
 }
+
+void Heuristic::cache_estimate(const State &state, int value) {
+    if (cache_evaluator_values) {
+        if (value == EvaluationResult::INFTY) {
+            value = DEAD_END;
+        }
+        heuristic_cache[state] = HEntry(value, false);
+    }
+}
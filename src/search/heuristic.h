@@ -9,6 +9,7 @@
 #include "algorithms/ordered_set.h"
 
 #include <memory>
+#include <string>
 #include <vector>
 
 class TaskProxy;
@@ -44,6 +45,11 @@ class Heuristic : public Evaluator {
     */
     ordered_set::OrderedSet<OperatorID> preferred_operators;
 
+    bool has_valid_cached_estimate(const State &state) const;
+    // Turn a computed or cached value into a result with the preferred operators.
+    EvaluationResult create_result(
+        const State &state, int heuristic, bool count_evaluation);
+
 protected:
     /*
       Cache for saving h values
@@ -63,6 +69,15 @@ protected:
 
     virtual int compute_heuristic(const State &ancestor_state) = 0;
 
+    /*
+      Compute the heuristic values of several states (see
+      Evaluator::compute_results). The default implementation calls
+      compute_heuristic for each state. Heuristics that override it should
+      also override supports_batch_evaluation.
+    */
+    virtual void compute_heuristics(
+        const std::vector<State> &ancestor_states, std::vector<int> &values);
+
     /*
       Usage note: Marking the same operator as preferred multiple times
       is OK -- it will only appear once in the list of preferred
@@ -72,6 +87,13 @@ protected:
 
     State convert_ancestor_state(const State &ancestor_state) const;
 
+    /*
+      Return the key of the heuristic cache entry (see
+      utils/heuristic_cache.h) for data that only depends on the task of the
+      heuristic and its configuration string.
+    */
+    std::string compute_cache_key(const std::string &kind) const;
+
 public:
     explicit Heuristic(const options::Options &opts);
     virtual ~Heuristic() override;
@@ -84,10 +106,14 @@ public:
 
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) override;
+    virtual void compute_results(
+        std::vector<EvaluationContext> &eval_contexts,
+        std::vector<EvaluationResult> &results) override;
 
     virtual bool does_cache_estimates() const override;
     virtual bool is_estimate_cached(const State &state) const override;
     virtual int get_cached_estimate(const State &state) const override;
+    virtual void cache_estimate(const State &state, int value) override;
 };
 
 #endif
@@ -40,19 +40,12 @@ void AdditiveHeuristic::write_overflow_warning() {
 // heuristic computation
 void AdditiveHeuristic::setup_exploration_queue() {
     queue.clear();
-
-    for (Proposition &prop : propositions) {
-        prop.cost = -1;
-        prop.marked = false;
-    }
+    start_exploration();
 
     // Deal with operators and axioms without preconditions.
-    for (UnaryOperator &op : unary_operators) {
-        op.unsatisfied_preconditions = op.num_preconditions;
-        op.cost = op.base_cost; // will be increased by precondition costs
-
-        if (op.unsatisfied_preconditions == 0)
-            enqueue_if_necessary(op.effect, op.base_cost, get_op_id(op));
+    for (OpID op_id : get_unconditional_operators()) {
+        const UnaryOperator *op = get_operator(op_id);
+        enqueue_if_necessary(op->effect, op->base_cost, op_id);
     }
 }
 
@@ -69,39 +62,38 @@ void AdditiveHeuristic::relaxed_exploration() {
         pair<int, PropID> top_pair = queue.pop();
         int distance = top_pair.first;
         PropID prop_id = top_pair.second;
-        Proposition *prop = get_proposition(prop_id);
-        int prop_cost = prop->cost;
+        int prop_cost = get_cost(prop_id);
         assert(prop_cost >= 0);
         assert(prop_cost <= distance);
         if (prop_cost < distance)
             continue;
+        const Proposition *prop = get_proposition(prop_id);
         if (prop->is_goal && --unsolved_goals == 0)
             return;
         for (OpID op_id : precondition_of_pool.get_slice(
                  prop->precondition_of, prop->num_precondition_occurences)) {
-            UnaryOperator *unary_op = get_operator(op_id);
-            increase_cost(unary_op->cost, prop_cost);
-            --unary_op->unsatisfied_preconditions;
-            assert(unary_op->unsatisfied_preconditions >= 0);
-            if (unary_op->unsatisfied_preconditions == 0)
-                enqueue_if_necessary(unary_op->effect,
-                                     unary_op->cost, op_id);
+            ExploredOperator &explored_op = get_explored_operator(op_id);
+            increase_cost(explored_op.cost, prop_cost);
+            --explored_op.unsatisfied_preconditions;
+            assert(explored_op.unsatisfied_preconditions >= 0);
+            if (explored_op.unsatisfied_preconditions == 0)
+                enqueue_if_necessary(get_operator(op_id)->effect,
+                                     explored_op.cost, op_id);
         }
     }
 }
 
 void AdditiveHeuristic::mark_preferred_operators(
     const State &state, PropID goal_id) {
-    Proposition *goal = get_proposition(goal_id);
-    if (!goal->marked) { // Only consider each subgoal once.
-        goal->marked = true;
-        OpID op_id = goal->reached_by;
+    if (!is_marked(goal_id)) { // Only consider each subgoal once.
+        mark(goal_id);
+        OpID op_id = get_reached_by(goal_id);
         if (op_id != NO_OP) { // We have not yet chained back to a start node.
             UnaryOperator *unary_op = get_operator(op_id);
             bool is_preferred = true;
             for (PropID precond : get_preconditions(op_id)) {
                 mark_preferred_operators(state, precond);
-                if (get_proposition(precond)->reached_by != NO_OP) {
+                if (get_reached_by(precond) != NO_OP) {
                     is_preferred = false;
                 }
             }
@@ -117,14 +109,19 @@ void AdditiveHeuristic::mark_preferred_operators(
 }
 
 int AdditiveHeuristic::compute_add_and_ff(const State &state) {
-    setup_exploration_queue();
-    setup_exploration_queue_state(state);
-    relaxed_exploration();
+    if (incremental) {
+        if (explore_incrementally<relaxation_heuristic::CostCombination::SUM>(
+                state, queue, MAX_COST_VALUE))
+            write_overflow_warning();
+    } else {
+        setup_exploration_queue();
+        setup_exploration_queue_state(state);
+        relaxed_exploration();
+    }
 
     int total_cost = 0;
     for (PropID goal_id : goal_propositions) {
-        const Proposition *goal = get_proposition(goal_id);
-        int goal_cost = goal->cost;
+        int goal_cost = get_cost(goal_id);
         if (goal_cost == -1)
             return DEAD_END;
         increase_cost(total_cost, goal_cost);
@@ -160,7 +157,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_property("safe", "yes for tasks without axioms");
     parser.document_property("preferred operators", "yes");
 
-    Heuristic::add_options_to_parser(parser);
+    relaxation_heuristic::RelaxationHeuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
     if (parser.dry_run())
         return nullptr;
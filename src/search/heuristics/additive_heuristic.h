@@ -18,6 +18,7 @@ using relaxation_heuristic::NO_OP;
 
 using relaxation_heuristic::Proposition;
 using relaxation_heuristic::UnaryOperator;
+using relaxation_heuristic::ExploredOperator;
 
 class AdditiveHeuristic : public relaxation_heuristic::RelaxationHeuristic {
     /* Costs larger than MAX_COST_VALUE are clamped to max_value. The
@@ -39,13 +40,12 @@ class AdditiveHeuristic : public relaxation_heuristic::RelaxationHeuristic {
 
     void enqueue_if_necessary(PropID prop_id, int cost, OpID op_id) {
         assert(cost >= 0);
-        Proposition *prop = get_proposition(prop_id);
-        if (prop->cost == -1 || prop->cost > cost) {
-            prop->cost = cost;
-            prop->reached_by = op_id;
+        int old_cost = get_cost(prop_id);
+        if (old_cost == -1 || old_cost > cost) {
+            set_cost(prop_id, cost, op_id);
             queue.push(cost, prop_id);
         }
-        assert(prop->cost != -1 && prop->cost <= cost);
+        assert(get_cost(prop_id) != -1 && get_cost(prop_id) <= cost);
     }
 
     void increase_cost(int &cost, int amount) {
@@ -76,7 +76,7 @@ public:
     void compute_heuristic_for_cegar(const State &state);
 
     int get_cost_for_cegar(int var, int value) const {
-        return get_proposition(var, value)->cost;
+        return get_cost(get_prop_id(var, value));
     }
 };
 }
@@ -22,17 +22,16 @@ FFHeuristic::FFHeuristic(const Options &opts)
 
 void FFHeuristic::mark_preferred_operators_and_relaxed_plan(
     const State &state, PropID goal_id) {
-    Proposition *goal = get_proposition(goal_id);
-    if (!goal->marked) { // Only consider each subgoal once.
-        goal->marked = true;
-        OpID op_id = goal->reached_by;
+    if (!is_marked(goal_id)) { // Only consider each subgoal once.
+        mark(goal_id);
+        OpID op_id = get_reached_by(goal_id);
         if (op_id != NO_OP) { // We have not yet chained back to a start node.
             UnaryOperator *unary_op = get_operator(op_id);
             bool is_preferred = true;
             for (PropID precond : get_preconditions(op_id)) {
                 mark_preferred_operators_and_relaxed_plan(
                     state, precond);
-                if (get_proposition(precond)->reached_by != NO_OP) {
+                if (get_reached_by(precond) != NO_OP) {
                     is_preferred = false;
                 }
             }
@@ -85,7 +84,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_property("safe", "yes for tasks without axioms");
     parser.document_property("preferred operators", "yes");
 
-    Heuristic::add_options_to_parser(parser);
+    relaxation_heuristic::RelaxationHeuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
     if (parser.dry_run())
         return nullptr;
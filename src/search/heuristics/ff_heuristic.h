@@ -13,6 +13,7 @@ using relaxation_heuristic::NO_OP;
 
 using relaxation_heuristic::Proposition;
 using relaxation_heuristic::UnaryOperator;
+using relaxation_heuristic::ExploredOperator;
 
 /*
   TODO: In a better world, this should not derive from
@@ -10,6 +10,7 @@
 #include "../utils/logging.h"
 #include "../utils/memory.h"
 
+#include <algorithm>
 #include <iostream>
 
 using namespace std;
@@ -17,7 +18,11 @@ using namespace std;
 namespace lm_cut_heuristic {
 LandmarkCutHeuristic::LandmarkCutHeuristic(const Options &opts)
     : Heuristic(opts),
-      landmark_generator(utils::make_unique_ptr<LandmarkCutLandmarks>(task_proxy)) {
+      landmark_generator(utils::make_unique_ptr<LandmarkCutLandmarks>(task_proxy)),
+      reuse_landmarks(opts.get<bool>("reuse_landmarks")),
+      transition_op_id(OperatorID::no_operator),
+      transition_state_id(StateID::no_state),
+      landmarks_state_id(StateID::no_state) {
     if (log.is_at_least_normal()) {
         log << "Initializing landmark cut heuristic..." << endl;
     }
@@ -26,13 +31,68 @@ LandmarkCutHeuristic::LandmarkCutHeuristic(const Options &opts)
 LandmarkCutHeuristic::~LandmarkCutHeuristic() {
 }
 
+void LandmarkCutHeuristic::notify_state_transition(
+    const State &parent_state, OperatorID op_id, const State &state) {
+    if (!transition_parent || transition_parent->get_id() != parent_state.get_id())
+        transition_parent = utils::make_unique_ptr<State>(parent_state);
+    transition_op_id = op_id;
+    transition_state_id = state.get_id();
+}
+
+void LandmarkCutHeuristic::compute_parent_landmarks() {
+    State state = convert_ancestor_state(*transition_parent);
+    parent_landmarks.clear();
+    parent_landmark_costs.clear();
+    bool dead_end = landmark_generator->compute_landmarks(
+        state, nullptr,
+        [this](const vector<int> &landmark, int cost) {
+            parent_landmarks.push_back(landmark);
+            parent_landmark_costs.push_back(cost);
+        });
+    if (dead_end) {
+        parent_landmarks.clear();
+        parent_landmark_costs.clear();
+    }
+    landmarks_state_id = transition_parent->get_id();
+}
+
+void LandmarkCutHeuristic::compute_reused_landmark_costs() {
+    /*
+      Every plan for the successor is the suffix of a plan for the parent
+      state that starts with the operator of the transition. Hence, each
+      landmark of the parent state that does not contain this operator is
+      a landmark of the successor.
+
+      We assume that the operator IDs of the search and of the task of
+      the heuristic coincide.
+    */
+    int op_no = transition_op_id.get_index();
+    reused_landmark_costs = parent_landmark_costs;
+    int num_landmarks = parent_landmarks.size();
+    for (int i = 0; i < num_landmarks; ++i) {
+        const vector<int> &landmark = parent_landmarks[i];
+        if (find(landmark.begin(), landmark.end(), op_no) != landmark.end())
+            reused_landmark_costs[i] = 0;
+    }
+}
+
 int LandmarkCutHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
     int total_cost = 0;
-    bool dead_end = landmark_generator->compute_landmarks(
-        state,
-        [&total_cost](int cut_cost) {total_cost += cut_cost;},
-        nullptr);
+    auto cost_callback = [&total_cost](int cut_cost) {total_cost += cut_cost;};
+    bool dead_end;
+    if (reuse_landmarks && transition_state_id != StateID::no_state &&
+        ancestor_state.get_id() == transition_state_id) {
+        if (landmarks_state_id != transition_parent->get_id())
+            compute_parent_landmarks();
+        compute_reused_landmark_costs();
+        dead_end = landmark_generator->compute_landmarks(
+            state, cost_callback, nullptr,
+            parent_landmarks, reused_landmark_costs);
+    } else {
+        dead_end = landmark_generator->compute_landmarks(
+            state, cost_callback, nullptr);
+    }
 
     if (dead_end)
         return DEAD_END;
@@ -48,8 +108,23 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_property("consistent", "no");
     parser.document_property("safe", "yes");
     parser.document_property("preferred operators", "no");
+    parser.document_note(
+        "Reusing landmarks",
+        "With reuse_landmarks=true, the heuristic starts the computation for "
+        "a successor state with the landmarks of its parent state that do "
+        "not contain the operator leading to the successor. Since these are "
+        "landmarks of the successor, the estimates remain admissible, but "
+        "they can differ from the estimates computed from scratch and "
+        "depend on the path on which a state is reached first. The "
+        "landmarks of each expanded state are computed once more when its "
+        "first successor is evaluated.");
 
     Heuristic::add_options_to_parser(parser);
+    parser.add_option<bool>(
+        "reuse_landmarks",
+        "start the computation for a successor state with the landmarks of "
+        "its parent state (see note)",
+        "false");
     Options opts = parser.parse();
     if (parser.dry_run())
         return nullptr;
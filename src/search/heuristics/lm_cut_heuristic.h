@@ -4,6 +4,7 @@
 #include "../heuristic.h"
 
 #include <memory>
+#include <vector>
 
 namespace options {
 class Options;
@@ -14,11 +15,43 @@ class LandmarkCutLandmarks;
 
 class LandmarkCutHeuristic : public Heuristic {
     std::unique_ptr<LandmarkCutLandmarks> landmark_generator;
+    const bool reuse_landmarks;
+
+    /*
+      With reuse_landmarks, the search notifies us about the transition
+      from transition_parent to the state that it evaluates next. The
+      landmarks of transition_parent that do not contain the operator of
+      the transition are landmarks of the successor, too, and we use them
+      as a starting point for the successor. We compute the landmarks of
+      transition_parent when we evaluate its first successor and keep them
+      until the search moves on to the next parent state.
+    */
+    std::unique_ptr<State> transition_parent;
+    OperatorID transition_op_id;
+    StateID transition_state_id;
+    StateID landmarks_state_id;
+    std::vector<std::vector<int>> parent_landmarks;
+    std::vector<int> parent_landmark_costs;
+    // Costs of parent_landmarks for the successor (0 if not reused).
+    std::vector<int> reused_landmark_costs;
+
+    void compute_parent_landmarks();
+    void compute_reused_landmark_costs();
 
     virtual int compute_heuristic(const State &ancestor_state) override;
 public:
     explicit LandmarkCutHeuristic(const options::Options &opts);
     virtual ~LandmarkCutHeuristic() override;
+
+    virtual void get_path_dependent_evaluators(
+        std::set<Evaluator *> &evals) override {
+        if (reuse_landmarks)
+            evals.insert(this);
+    }
+
+    virtual void notify_state_transition(const State &parent_state,
+                                         OperatorID op_id,
+                                         const State &state) override;
 };
 }
 
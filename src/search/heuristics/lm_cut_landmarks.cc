@@ -9,20 +9,48 @@
 using namespace std;
 
 namespace lm_cut_heuristic {
+RelaxedProposition::RelaxedProposition()
+    : num_precondition_of(0),
+      num_effect_of(0) {
+}
+
+
+RelaxedOperator::RelaxedOperator(
+    array_pool::ArrayPoolIndex preconditions, int num_preconditions,
+    array_pool::ArrayPoolIndex effects, int num_effects,
+    int op_id, int base)
+    : preconditions(preconditions),
+      num_preconditions(num_preconditions),
+      effects(effects),
+      num_effects(num_effects),
+      original_op_id(op_id),
+      base_cost(base) {
+}
+
+
+ExploredOperator::ExploredOperator(int cost, int unsatisfied_preconditions)
+    : cost(cost),
+      unsatisfied_preconditions(unsatisfied_preconditions),
+      h_max_supporter_cost(numeric_limits<int>::max()) {
+}
+
+
 // construction and destruction
 LandmarkCutLandmarks::LandmarkCutLandmarks(const TaskProxy &task_proxy) {
     task_properties::verify_no_axioms(task_proxy);
     task_properties::verify_no_conditional_effects(task_proxy);
 
     // Build propositions.
-    num_propositions = 2; // artificial goal and artificial precondition
+    int num_facts = 0;
     VariablesProxy variables = task_proxy.get_variables();
-    propositions.resize(variables.size());
-    for (FactProxy fact : variables.get_facts()) {
-        int var_id = fact.get_variable().get_id();
-        propositions[var_id].push_back(RelaxedProposition());
-        ++num_propositions;
+    proposition_offsets.reserve(variables.size());
+    for (VariableProxy var : variables) {
+        proposition_offsets.push_back(num_facts);
+        num_facts += var.get_domain_size();
     }
+    artificial_precondition = num_facts;
+    artificial_goal = num_facts + 1;
+    num_propositions = num_facts + 2;
 
     // Build relaxed operators for operators and axioms.
     for (OperatorProxy op : task_proxy.get_operators())
@@ -35,107 +63,109 @@ LandmarkCutLandmarks::LandmarkCutLandmarks(const TaskProxy &task_proxy) {
        unary operators hurts. */
 
     // Build artificial goal proposition and operator.
-    vector<RelaxedProposition *> goal_op_pre, goal_op_eff;
+    vector<PropID> goal_op_pre;
     for (FactProxy goal : task_proxy.get_goals()) {
-        goal_op_pre.push_back(get_proposition(goal));
+        goal_op_pre.push_back(get_prop_id(goal));
     }
-    goal_op_eff.push_back(&artificial_goal);
     /* Use the invalid operator ID -1 so accessing
        the artificial operator will generate an error. */
-    add_relaxed_operator(move(goal_op_pre), move(goal_op_eff), -1, 0);
+    add_relaxed_operator(move(goal_op_pre), {artificial_goal}, -1, 0);
 
     // Cross-reference relaxed operators.
-    for (RelaxedOperator &op : relaxed_operators) {
-        for (RelaxedProposition *pre : op.preconditions)
-            pre->precondition_of.push_back(&op);
-        for (RelaxedProposition *eff : op.effects)
-            eff->effect_of.push_back(&op);
+    vector<vector<OpID>> precondition_of_vectors(num_propositions);
+    vector<vector<OpID>> effect_of_vectors(num_propositions);
+    int num_relaxed_operators = relaxed_operators.size();
+    for (OpID op_id = 0; op_id < num_relaxed_operators; ++op_id) {
+        for (PropID pre : get_preconditions(op_id))
+            precondition_of_vectors[pre].push_back(op_id);
+        for (PropID eff : get_effects(op_id))
+            effect_of_vectors[eff].push_back(op_id);
     }
+    propositions.resize(num_propositions);
+    for (PropID prop_id = 0; prop_id < num_propositions; ++prop_id) {
+        RelaxedProposition &prop = propositions[prop_id];
+        prop.precondition_of =
+            proposition_pool.append(precondition_of_vectors[prop_id]);
+        prop.num_precondition_of = precondition_of_vectors[prop_id].size();
+        prop.effect_of = proposition_pool.append(effect_of_vectors[prop_id]);
+        prop.num_effect_of = effect_of_vectors[prop_id].size();
+    }
+
+    explored_propositions.resize(num_propositions);
+    reset_explored_operators.reserve(num_relaxed_operators);
+    for (const RelaxedOperator &op : relaxed_operators)
+        reset_explored_operators.emplace_back(op.base_cost, op.num_preconditions);
+    explored_operators = reset_explored_operators;
+    h_max_supporters.resize(num_relaxed_operators, NO_PROP);
 }
 
 LandmarkCutLandmarks::~LandmarkCutLandmarks() {
 }
 
 void LandmarkCutLandmarks::build_relaxed_operator(const OperatorProxy &op) {
-    vector<RelaxedProposition *> precondition;
-    vector<RelaxedProposition *> effects;
+    vector<PropID> precondition;
+    vector<PropID> effects;
     for (FactProxy pre : op.get_preconditions()) {
-        precondition.push_back(get_proposition(pre));
+        precondition.push_back(get_prop_id(pre));
     }
     for (EffectProxy eff : op.get_effects()) {
-        effects.push_back(get_proposition(eff.get_fact()));
+        effects.push_back(get_prop_id(eff.get_fact()));
     }
     add_relaxed_operator(
         move(precondition), move(effects), op.get_id(), op.get_cost());
 }
 
 void LandmarkCutLandmarks::add_relaxed_operator(
-    vector<RelaxedProposition *> &&precondition,
-    vector<RelaxedProposition *> &&effects,
+    vector<PropID> &&precondition,
+    vector<PropID> &&effects,
     int op_id, int base_cost) {
-    RelaxedOperator relaxed_op(
-        move(precondition), move(effects), op_id, base_cost);
-    if (relaxed_op.preconditions.empty())
-        relaxed_op.preconditions.push_back(&artificial_precondition);
-    relaxed_operators.push_back(relaxed_op);
-}
-
-RelaxedProposition *LandmarkCutLandmarks::get_proposition(
-    const FactProxy &fact) {
-    int var_id = fact.get_variable().get_id();
-    int val = fact.get_value();
-    return &propositions[var_id][val];
+    if (precondition.empty())
+        precondition.push_back(artificial_precondition);
+    relaxed_operators.emplace_back(
+        operator_pool.append(precondition), precondition.size(),
+        operator_pool.append(effects), effects.size(),
+        op_id, base_cost);
 }
 
 // heuristic computation
 void LandmarkCutLandmarks::setup_exploration_queue() {
     priority_queue.clear();
 
-    for (auto &var_props : propositions) {
-        for (RelaxedProposition &prop : var_props) {
-            prop.status = UNREACHED;
-        }
-    }
-
-    artificial_goal.status = UNREACHED;
-    artificial_precondition.status = UNREACHED;
-
-    for (RelaxedOperator &op : relaxed_operators) {
-        op.unsatisfied_preconditions = op.preconditions.size();
-        op.h_max_supporter = 0;
-        op.h_max_supporter_cost = numeric_limits<int>::max();
+    for (ExploredProposition &prop : explored_propositions) {
+        prop.status = UNREACHED;
     }
 }
 
-void LandmarkCutLandmarks::setup_exploration_queue_state(const State &state) {
-    for (FactProxy init_fact : state) {
-        enqueue_if_necessary(get_proposition(init_fact), 0);
+void LandmarkCutLandmarks::setup_exploration_queue_state(
+    const vector<int> &state_values) {
+    int num_variables = state_values.size();
+    for (int var = 0; var < num_variables; ++var) {
+        enqueue_if_necessary(get_prop_id(var, state_values[var]), 0);
     }
-    enqueue_if_necessary(&artificial_precondition, 0);
+    enqueue_if_necessary(artificial_precondition, 0);
 }
 
-void LandmarkCutLandmarks::first_exploration(const State &state) {
+void LandmarkCutLandmarks::first_exploration(const vector<int> &state_values) {
     assert(priority_queue.empty());
     setup_exploration_queue();
-    setup_exploration_queue_state(state);
+    setup_exploration_queue_state(state_values);
     while (!priority_queue.empty()) {
-        pair<int, RelaxedProposition *> top_pair = priority_queue.pop();
+        pair<int, PropID> top_pair = priority_queue.pop();
         int popped_cost = top_pair.first;
-        RelaxedProposition *prop = top_pair.second;
-        int prop_cost = prop->h_max_cost;
+        PropID prop_id = top_pair.second;
+        int prop_cost = explored_propositions[prop_id].h_max_cost;
         assert(prop_cost <= popped_cost);
         if (prop_cost < popped_cost)
             continue;
-        const vector<RelaxedOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (RelaxedOperator *relaxed_op : triggered_operators) {
-            --relaxed_op->unsatisfied_preconditions;
-            assert(relaxed_op->unsatisfied_preconditions >= 0);
-            if (relaxed_op->unsatisfied_preconditions == 0) {
-                relaxed_op->h_max_supporter = prop;
-                relaxed_op->h_max_supporter_cost = prop_cost;
-                int target_cost = prop_cost + relaxed_op->cost;
-                for (RelaxedProposition *effect : relaxed_op->effects) {
+        for (OpID op_id : get_precondition_of(prop_id)) {
+            ExploredOperator &relaxed_op = explored_operators[op_id];
+            --relaxed_op.unsatisfied_preconditions;
+            assert(relaxed_op.unsatisfied_preconditions >= 0);
+            if (relaxed_op.unsatisfied_preconditions == 0) {
+                h_max_supporters[op_id] = prop_id;
+                relaxed_op.h_max_supporter_cost = prop_cost;
+                int target_cost = prop_cost + relaxed_op.cost;
+                for (PropID effect : get_effects(op_id)) {
                     enqueue_if_necessary(effect, target_cost);
                 }
             }
@@ -143,8 +173,7 @@ void LandmarkCutLandmarks::first_exploration(const State &state) {
     }
 }
 
-void LandmarkCutLandmarks::first_exploration_incremental(
-    vector<RelaxedOperator *> &cut) {
+void LandmarkCutLandmarks::first_exploration_incremental() {
     assert(priority_queue.empty());
     /* We pretend that this queue has had as many pushes already as we
        have propositions to avoid switching from bucket-based to
@@ -152,32 +181,32 @@ void LandmarkCutLandmarks::first_exploration_incremental(
        to heap-based in problems where action costs are at most 1.
     */
     priority_queue.add_virtual_pushes(num_propositions);
-    for (RelaxedOperator *relaxed_op : cut) {
-        int cost = relaxed_op->h_max_supporter_cost + relaxed_op->cost;
-        for (RelaxedProposition *effect : relaxed_op->effects)
+    for (OpID op_id : cut) {
+        const ExploredOperator &relaxed_op = explored_operators[op_id];
+        int cost = relaxed_op.h_max_supporter_cost + relaxed_op.cost;
+        for (PropID effect : get_effects(op_id))
             enqueue_if_necessary(effect, cost);
     }
     while (!priority_queue.empty()) {
-        pair<int, RelaxedProposition *> top_pair = priority_queue.pop();
+        pair<int, PropID> top_pair = priority_queue.pop();
         int popped_cost = top_pair.first;
-        RelaxedProposition *prop = top_pair.second;
-        int prop_cost = prop->h_max_cost;
+        PropID prop_id = top_pair.second;
+        int prop_cost = explored_propositions[prop_id].h_max_cost;
         assert(prop_cost <= popped_cost);
         if (prop_cost < popped_cost)
             continue;
-        const vector<RelaxedOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (RelaxedOperator *relaxed_op : triggered_operators) {
-            if (relaxed_op->h_max_supporter == prop) {
-                int old_supp_cost = relaxed_op->h_max_supporter_cost;
+        for (OpID op_id : get_precondition_of(prop_id)) {
+            if (h_max_supporters[op_id] == prop_id) {
+                ExploredOperator &relaxed_op = explored_operators[op_id];
+                int old_supp_cost = relaxed_op.h_max_supporter_cost;
                 if (old_supp_cost > prop_cost) {
-                    relaxed_op->update_h_max_supporter();
-                    int new_supp_cost = relaxed_op->h_max_supporter_cost;
+                    update_h_max_supporter(op_id);
+                    int new_supp_cost = relaxed_op.h_max_supporter_cost;
                     if (new_supp_cost != old_supp_cost) {
                         // This operator has become cheaper.
                         assert(new_supp_cost < old_supp_cost);
-                        int target_cost = new_supp_cost + relaxed_op->cost;
-                        for (RelaxedProposition *effect : relaxed_op->effects)
+                        int target_cost = new_supp_cost + relaxed_op.cost;
+                        for (PropID effect : get_effects(op_id))
                             enqueue_if_necessary(effect, target_cost);
                     }
                 }
@@ -186,42 +215,41 @@ void LandmarkCutLandmarks::first_exploration_incremental(
     }
 }
 
-void LandmarkCutLandmarks::second_exploration(
-    const State &state, vector<RelaxedProposition *> &second_exploration_queue,
-    vector<RelaxedOperator *> &cut) {
+void LandmarkCutLandmarks::second_exploration(const vector<int> &state_values) {
     assert(second_exploration_queue.empty());
     assert(cut.empty());
 
-    artificial_precondition.status = BEFORE_GOAL_ZONE;
-    second_exploration_queue.push_back(&artificial_precondition);
+    explored_propositions[artificial_precondition].status = BEFORE_GOAL_ZONE;
+    second_exploration_queue.push_back(artificial_precondition);
 
-    for (FactProxy init_fact : state) {
-        RelaxedProposition *init_prop = get_proposition(init_fact);
-        init_prop->status = BEFORE_GOAL_ZONE;
+    int num_variables = state_values.size();
+    for (int var = 0; var < num_variables; ++var) {
+        PropID init_prop = get_prop_id(var, state_values[var]);
+        explored_propositions[init_prop].status = BEFORE_GOAL_ZONE;
         second_exploration_queue.push_back(init_prop);
     }
 
     while (!second_exploration_queue.empty()) {
-        RelaxedProposition *prop = second_exploration_queue.back();
+        PropID prop_id = second_exploration_queue.back();
         second_exploration_queue.pop_back();
-        const vector<RelaxedOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (RelaxedOperator *relaxed_op : triggered_operators) {
-            if (relaxed_op->h_max_supporter == prop) {
+        for (OpID op_id : get_precondition_of(prop_id)) {
+            if (h_max_supporters[op_id] == prop_id) {
                 bool reached_goal_zone = false;
-                for (RelaxedProposition *effect : relaxed_op->effects) {
-                    if (effect->status == GOAL_ZONE) {
-                        assert(relaxed_op->cost > 0);
+                for (PropID effect : get_effects(op_id)) {
+                    if (explored_propositions[effect].status == GOAL_ZONE) {
+                        assert(explored_operators[op_id].cost > 0);
                         reached_goal_zone = true;
-                        cut.push_back(relaxed_op);
+                        cut.push_back(op_id);
                         break;
                     }
                 }
                 if (!reached_goal_zone) {
-                    for (RelaxedProposition *effect : relaxed_op->effects) {
-                        if (effect->status != BEFORE_GOAL_ZONE) {
-                            assert(effect->status == REACHED);
-                            effect->status = BEFORE_GOAL_ZONE;
+                    for (PropID effect : get_effects(op_id)) {
+                        ExploredProposition &effect_prop =
+                            explored_propositions[effect];
+                        if (effect_prop.status != BEFORE_GOAL_ZONE) {
+                            assert(effect_prop.status == REACHED);
+                            effect_prop.status = BEFORE_GOAL_ZONE;
                             second_exploration_queue.push_back(effect);
                         }
                     }
@@ -231,16 +259,17 @@ void LandmarkCutLandmarks::second_exploration(
     }
 }
 
-void LandmarkCutLandmarks::mark_goal_plateau(RelaxedProposition *subgoal) {
-    // NOTE: subgoal can be null if we got here via recursion through
+void LandmarkCutLandmarks::mark_goal_plateau(PropID subgoal) {
+    // NOTE: subgoal can be NO_PROP if we got here via recursion through
     // a zero-cost action that is relaxed unreachable. (This can only
     // happen in domains which have zero-cost actions to start with.)
     // For example, this happens in pegsol-strips #01.
-    if (subgoal && subgoal->status != GOAL_ZONE) {
-        subgoal->status = GOAL_ZONE;
-        for (RelaxedOperator *achiever : subgoal->effect_of)
-            if (achiever->cost == 0)
-                mark_goal_plateau(achiever->h_max_supporter);
+    if (subgoal != NO_PROP &&
+        explored_propositions[subgoal].status != GOAL_ZONE) {
+        explored_propositions[subgoal].status = GOAL_ZONE;
+        for (OpID achiever : get_effect_of(subgoal))
+            if (explored_operators[achiever].cost == 0)
+                mark_goal_plateau(h_max_supporters[achiever]);
     }
 }
 
@@ -249,24 +278,27 @@ void LandmarkCutLandmarks::validate_h_max() const {
     // Using conditional compilation to avoid complaints about unused
     // variables when using NDEBUG. This whole code does nothing useful
     // when assertions are switched off anyway.
-    for (const RelaxedOperator &op : relaxed_operators) {
+    int num_relaxed_operators = relaxed_operators.size();
+    for (OpID op_id = 0; op_id < num_relaxed_operators; ++op_id) {
+        const ExploredOperator &op = explored_operators[op_id];
         if (op.unsatisfied_preconditions) {
             bool reachable = true;
-            for (RelaxedProposition *pre : op.preconditions) {
-                if (pre->status == UNREACHED) {
+            for (PropID pre : get_preconditions(op_id)) {
+                if (explored_propositions[pre].status == UNREACHED) {
                     reachable = false;
                     break;
                 }
             }
             assert(!reachable);
-            assert(!op.h_max_supporter);
+            assert(h_max_supporters[op_id] == NO_PROP);
         } else {
-            assert(op.h_max_supporter);
+            assert(h_max_supporters[op_id] != NO_PROP);
             int h_max_cost = op.h_max_supporter_cost;
-            assert(h_max_cost == op.h_max_supporter->h_max_cost);
-            for (RelaxedProposition *pre : op.preconditions) {
-                assert(pre->status != UNREACHED);
-                assert(pre->h_max_cost <= h_max_cost);
+            assert(h_max_cost ==
+                   explored_propositions[h_max_supporters[op_id]].h_max_cost);
+            for (PropID pre : get_preconditions(op_id)) {
+                assert(explored_propositions[pre].status != UNREACHED);
+                assert(explored_propositions[pre].h_max_cost <= h_max_cost);
             }
         }
     }
@@ -275,47 +307,67 @@ void LandmarkCutLandmarks::validate_h_max() const {
 
 bool LandmarkCutLandmarks::compute_landmarks(
     const State &state, CostCallback cost_callback,
-    LandmarkCallback landmark_callback) {
-    for (RelaxedOperator &op : relaxed_operators) {
-        op.cost = op.base_cost;
+    LandmarkCallback landmark_callback,
+    const vector<Landmark> &initial_landmarks,
+    const vector<int> &initial_landmark_costs) {
+    assert(initial_landmarks.size() == initial_landmark_costs.size());
+    explored_operators = reset_explored_operators;
+    fill(h_max_supporters.begin(), h_max_supporters.end(), NO_PROP);
+    int num_initial_landmarks = initial_landmarks.size();
+    for (int i = 0; i < num_initial_landmarks; ++i) {
+        int landmark_cost = initial_landmark_costs[i];
+        for (int op_id : initial_landmarks[i]) {
+            assert(relaxed_operators[op_id].original_op_id == op_id);
+            int &op_cost = explored_operators[op_id].cost;
+            assert(op_cost >= landmark_cost);
+            op_cost -= landmark_cost;
+        }
     }
-    // The following three variables could be declared inside the loop
-    // ("second_exploration_queue" even inside second_exploration),
-    // but having them here saves reallocations and hence provides a
-    // measurable speed boost.
-    vector<RelaxedOperator *> cut;
-    Landmark landmark;
-    vector<RelaxedProposition *> second_exploration_queue;
-    first_exploration(state);
+
+    state.unpack();
+    const vector<int> &state_values = state.get_unpacked_values();
+    first_exploration(state_values);
     // validate_h_max();  // too expensive to use even in regular debug mode
-    if (artificial_goal.status == UNREACHED)
+    ExploredProposition &goal = explored_propositions[artificial_goal];
+    if (goal.status == UNREACHED)
         return true;
 
+    for (int i = 0; i < num_initial_landmarks; ++i) {
+        if (initial_landmark_costs[i] == 0)
+            continue;
+        if (cost_callback) {
+            cost_callback(initial_landmark_costs[i]);
+        }
+        if (landmark_callback) {
+            landmark_callback(initial_landmarks[i], initial_landmark_costs[i]);
+        }
+    }
+
     int num_iterations = 0;
-    while (artificial_goal.h_max_cost != 0) {
+    while (goal.h_max_cost != 0) {
         ++num_iterations;
-        mark_goal_plateau(&artificial_goal);
+        mark_goal_plateau(artificial_goal);
         assert(cut.empty());
-        second_exploration(state, second_exploration_queue, cut);
+        second_exploration(state_values);
         assert(!cut.empty());
         int cut_cost = numeric_limits<int>::max();
-        for (RelaxedOperator *op : cut)
-            cut_cost = min(cut_cost, op->cost);
-        for (RelaxedOperator *op : cut)
-            op->cost -= cut_cost;
+        for (OpID op_id : cut)
+            cut_cost = min(cut_cost, explored_operators[op_id].cost);
+        for (OpID op_id : cut)
+            explored_operators[op_id].cost -= cut_cost;
 
         if (cost_callback) {
             cost_callback(cut_cost);
         }
         if (landmark_callback) {
             landmark.clear();
-            for (RelaxedOperator *op : cut) {
-                landmark.push_back(op->original_op_id);
+            for (OpID op_id : cut) {
+                landmark.push_back(relaxed_operators[op_id].original_op_id);
             }
             landmark_callback(landmark, cut_cost);
         }
 
-        first_exploration_incremental(cut);
+        first_exploration_incremental();
         // validate_h_max();  // too expensive to use even in regular debug mode
         cut.clear();
 
@@ -325,14 +377,10 @@ bool LandmarkCutLandmarks::compute_landmarks(
           or something based on total_cost, so that we don't need a per-round
           reinitialization.
         */
-        for (auto &var_props : propositions) {
-            for (RelaxedProposition &prop : var_props) {
-                if (prop.status == GOAL_ZONE || prop.status == BEFORE_GOAL_ZONE)
-                    prop.status = REACHED;
-            }
+        for (ExploredProposition &prop : explored_propositions) {
+            if (prop.status == GOAL_ZONE || prop.status == BEFORE_GOAL_ZONE)
+                prop.status = REACHED;
         }
-        artificial_goal.status = REACHED;
-        artificial_precondition.status = REACHED;
     }
     return false;
 }
@@ -1,6 +1,8 @@
 #ifndef HEURISTICS_LM_CUT_LANDMARKS_H
 #define HEURISTICS_LM_CUT_LANDMARKS_H
 
+#include "array_pool.h"
+
 #include "../task_proxy.h"
 
 #include "../algorithms/priority_queues.h"
@@ -12,7 +14,10 @@
 
 namespace lm_cut_heuristic {
 // TODO: Fix duplication with the other relaxation heuristics.
-struct RelaxedProposition;
+using PropID = int;
+using OpID = int;
+
+const PropID NO_PROP = -1;
 
 enum PropositionStatus {
     UNREACHED = 0,
@@ -21,70 +26,129 @@ enum PropositionStatus {
     BEFORE_GOAL_ZONE = 3
 };
 
+/*
+  RelaxedProposition and RelaxedOperator only hold the data that does not
+  change during the search. The data computed for each state is stored in
+  separate, compact arrays of ExploredProposition and ExploredOperator.
+*/
+struct RelaxedProposition {
+    RelaxedProposition();
+    array_pool::ArrayPoolIndex precondition_of;
+    int num_precondition_of;
+    array_pool::ArrayPoolIndex effect_of;
+    int num_effect_of;
+};
+
 struct RelaxedOperator {
+    RelaxedOperator(array_pool::ArrayPoolIndex preconditions,
+                    int num_preconditions,
+                    array_pool::ArrayPoolIndex effects,
+                    int num_effects,
+                    int op_id, int base);
+    array_pool::ArrayPoolIndex preconditions;
+    int num_preconditions;
+    array_pool::ArrayPoolIndex effects;
+    int num_effects;
     int original_op_id;
-    std::vector<RelaxedProposition *> preconditions;
-    std::vector<RelaxedProposition *> effects;
     int base_cost; // 0 for axioms, 1 for regular operators
-
-    int cost;
-    int unsatisfied_preconditions;
-    int h_max_supporter_cost; // h_max_cost of h_max_supporter
-    RelaxedProposition *h_max_supporter;
-    RelaxedOperator(std::vector<RelaxedProposition *> &&pre,
-                    std::vector<RelaxedProposition *> &&eff,
-                    int op_id, int base)
-        : original_op_id(op_id), preconditions(pre), effects(eff), base_cost(base) {
-    }
-
-    inline void update_h_max_supporter();
 };
 
-struct RelaxedProposition {
-    std::vector<RelaxedOperator *> precondition_of;
-    std::vector<RelaxedOperator *> effect_of;
-
+struct ExploredProposition {
     PropositionStatus status;
     int h_max_cost;
 };
 
+struct ExploredOperator {
+    ExploredOperator(int cost, int unsatisfied_preconditions);
+    int cost;
+    int unsatisfied_preconditions;
+    int h_max_supporter_cost; // h_max_cost of the h_max supporter
+};
+
 class LandmarkCutLandmarks {
+public:
+    using Landmark = std::vector<int>;
+    using CostCallback = std::function<void (int)>;
+    using LandmarkCallback = std::function<void (const Landmark &, int)>;
+private:
     std::vector<RelaxedOperator> relaxed_operators;
-    std::vector<std::vector<RelaxedProposition>> propositions;
-    RelaxedProposition artificial_precondition;
-    RelaxedProposition artificial_goal;
+    std::vector<RelaxedProposition> propositions;
+    array_pool::ArrayPool operator_pool;
+    array_pool::ArrayPool proposition_pool;
+    // proposition_offsets[var_id]: first PropID related to variable var_id
+    std::vector<PropID> proposition_offsets;
+    PropID artificial_precondition;
+    PropID artificial_goal;
     int num_propositions;
-    priority_queues::AdaptiveQueue<RelaxedProposition *> priority_queue;
+
+    /*
+      Data computed for each state, indexed by PropID and OpID. The
+      operator data is reset by copying reset_explored_operators. The
+      h_max supporters of the operators are stored in a separate array
+      because the second exploration only needs them.
+    */
+    std::vector<ExploredProposition> explored_propositions;
+    std::vector<ExploredOperator> explored_operators;
+    std::vector<ExploredOperator> reset_explored_operators;
+    std::vector<PropID> h_max_supporters;
+    priority_queues::AdaptiveQueue<PropID> priority_queue;
+
+    /*
+      The following three members are only used in compute_landmarks, but
+      keeping them here saves reallocations and hence provides a measurable
+      speed boost.
+    */
+    std::vector<OpID> cut;
+    Landmark landmark;
+    std::vector<PropID> second_exploration_queue;
 
     void build_relaxed_operator(const OperatorProxy &op);
-    void add_relaxed_operator(std::vector<RelaxedProposition *> &&precondition,
-                              std::vector<RelaxedProposition *> &&effects,
+    void add_relaxed_operator(std::vector<PropID> &&precondition,
+                              std::vector<PropID> &&effects,
                               int op_id, int base_cost);
-    RelaxedProposition *get_proposition(const FactProxy &fact);
+    PropID get_prop_id(int var, int value) const {
+        return proposition_offsets[var] + value;
+    }
+    PropID get_prop_id(const FactProxy &fact) const {
+        return get_prop_id(fact.get_variable().get_id(), fact.get_value());
+    }
+    array_pool::ArrayPoolSlice get_preconditions(OpID op_id) const {
+        const RelaxedOperator &op = relaxed_operators[op_id];
+        return operator_pool.get_slice(op.preconditions, op.num_preconditions);
+    }
+    array_pool::ArrayPoolSlice get_effects(OpID op_id) const {
+        const RelaxedOperator &op = relaxed_operators[op_id];
+        return operator_pool.get_slice(op.effects, op.num_effects);
+    }
+    array_pool::ArrayPoolSlice get_precondition_of(PropID prop_id) const {
+        const RelaxedProposition &prop = propositions[prop_id];
+        return proposition_pool.get_slice(
+            prop.precondition_of, prop.num_precondition_of);
+    }
+    array_pool::ArrayPoolSlice get_effect_of(PropID prop_id) const {
+        const RelaxedProposition &prop = propositions[prop_id];
+        return proposition_pool.get_slice(prop.effect_of, prop.num_effect_of);
+    }
     void setup_exploration_queue();
-    void setup_exploration_queue_state(const State &state);
-    void first_exploration(const State &state);
-    void first_exploration_incremental(std::vector<RelaxedOperator *> &cut);
-    void second_exploration(const State &state,
-                            std::vector<RelaxedProposition *> &second_exploration_queue,
-                            std::vector<RelaxedOperator *> &cut);
-
-    void enqueue_if_necessary(RelaxedProposition *prop, int cost) {
+    void setup_exploration_queue_state(const std::vector<int> &state_values);
+    void first_exploration(const std::vector<int> &state_values);
+    void first_exploration_incremental();
+    void second_exploration(const std::vector<int> &state_values);
+
+    void enqueue_if_necessary(PropID prop_id, int cost) {
         assert(cost >= 0);
-        if (prop->status == UNREACHED || prop->h_max_cost > cost) {
-            prop->status = REACHED;
-            prop->h_max_cost = cost;
-            priority_queue.push(cost, prop);
+        ExploredProposition &prop = explored_propositions[prop_id];
+        if (prop.status == UNREACHED || prop.h_max_cost > cost) {
+            prop.status = REACHED;
+            prop.h_max_cost = cost;
+            priority_queue.push(cost, prop_id);
         }
     }
 
-    void mark_goal_plateau(RelaxedProposition *subgoal);
+    inline void update_h_max_supporter(OpID op_id);
+    void mark_goal_plateau(PropID subgoal);
     void validate_h_max() const;
 public:
-    using Landmark = std::vector<int>;
-    using CostCallback = std::function<void (int)>;
-    using LandmarkCallback = std::function<void (const Landmark &, int)>;
-
     LandmarkCutLandmarks(const TaskProxy &task_proxy);
     virtual ~LandmarkCutLandmarks();
 
@@ -99,18 +163,36 @@ public:
       making a copy of the landmark, so cost_callback should be used if only the
       cost of the landmark is needed.
 
+      initial_landmarks[i] with cost initial_landmark_costs[i] must be
+      landmarks of the state whose costs sum to at most the cost of each of
+      their operators, for example a subset of the landmarks of another
+      state that remain landmarks in this state. They are used like
+      landmarks discovered before the first cut and passed to the callbacks
+      like the discovered landmarks. Initial landmarks with cost 0 are
+      skipped.
+
       Returns true iff state is detected as a dead end.
     */
-    bool compute_landmarks(const State &state, CostCallback cost_callback,
-                           LandmarkCallback landmark_callback);
+    bool compute_landmarks(
+        const State &state, CostCallback cost_callback,
+        LandmarkCallback landmark_callback,
+        const std::vector<Landmark> &initial_landmarks = std::vector<Landmark>(),
+        const std::vector<int> &initial_landmark_costs = std::vector<int>());
 };
 
-inline void RelaxedOperator::update_h_max_supporter() {
-    assert(!unsatisfied_preconditions);
-    for (size_t i = 0; i < preconditions.size(); ++i)
-        if (preconditions[i]->h_max_cost > h_max_supporter->h_max_cost)
-            h_max_supporter = preconditions[i];
-    h_max_supporter_cost = h_max_supporter->h_max_cost;
+inline void LandmarkCutLandmarks::update_h_max_supporter(OpID op_id) {
+    ExploredOperator &op = explored_operators[op_id];
+    assert(!op.unsatisfied_preconditions);
+    PropID &h_max_supporter = h_max_supporters[op_id];
+    int h_max_supporter_cost = explored_propositions[h_max_supporter].h_max_cost;
+    for (PropID precondition : get_preconditions(op_id)) {
+        int precondition_cost = explored_propositions[precondition].h_max_cost;
+        if (precondition_cost > h_max_supporter_cost) {
+            h_max_supporter = precondition;
+            h_max_supporter_cost = precondition_cost;
+        }
+    }
+    op.h_max_supporter_cost = h_max_supporter_cost;
 }
 }
 
@@ -6,6 +6,7 @@
 #include "../utils/logging.h"
 
 #include <cassert>
+#include <limits>
 #include <vector>
 
 using namespace std;
@@ -34,17 +35,12 @@ HSPMaxHeuristic::HSPMaxHeuristic(const Options &opts)
 // heuristic computation
 void HSPMaxHeuristic::setup_exploration_queue() {
     queue.clear();
-
-    for (Proposition &prop : propositions)
-        prop.cost = -1;
+    start_exploration();
 
     // Deal with operators and axioms without preconditions.
-    for (UnaryOperator &op : unary_operators) {
-        op.unsatisfied_preconditions = op.num_preconditions;
-        op.cost = op.base_cost; // will be increased by precondition costs
-
-        if (op.unsatisfied_preconditions == 0)
-            enqueue_if_necessary(op.effect, op.base_cost);
+    for (OpID op_id : get_unconditional_operators()) {
+        const UnaryOperator *op = get_operator(op_id);
+        enqueue_if_necessary(op->effect, op->base_cost);
     }
 }
 
@@ -61,23 +57,28 @@ void HSPMaxHeuristic::relaxed_exploration() {
         pair<int, PropID> top_pair = queue.pop();
         int distance = top_pair.first;
         PropID prop_id = top_pair.second;
-        Proposition *prop = get_proposition(prop_id);
-        int prop_cost = prop->cost;
+        int prop_cost = get_cost(prop_id);
         assert(prop_cost >= 0);
         assert(prop_cost <= distance);
         if (prop_cost < distance)
             continue;
+        const Proposition *prop = get_proposition(prop_id);
         if (prop->is_goal && --unsolved_goals == 0)
             return;
         for (OpID op_id : precondition_of_pool.get_slice(
                  prop->precondition_of, prop->num_precondition_occurences)) {
-            UnaryOperator *unary_op = get_operator(op_id);
-            unary_op->cost = max(unary_op->cost,
-                                 unary_op->base_cost + prop_cost);
-            --unary_op->unsatisfied_preconditions;
-            assert(unary_op->unsatisfied_preconditions >= 0);
-            if (unary_op->unsatisfied_preconditions == 0)
-                enqueue_if_necessary(unary_op->effect, unary_op->cost);
+            ExploredOperator &explored_op = get_explored_operator(op_id);
+            --explored_op.unsatisfied_preconditions;
+            assert(explored_op.unsatisfied_preconditions >= 0);
+            if (explored_op.unsatisfied_preconditions == 0) {
+                /*
+                  Propositions leave the queue in order of increasing
+                  cost, so the last precondition is the most expensive.
+                */
+                const UnaryOperator *unary_op = get_operator(op_id);
+                explored_op.cost = unary_op->base_cost + prop_cost;
+                enqueue_if_necessary(unary_op->effect, explored_op.cost);
+            }
         }
     }
 }
@@ -85,14 +86,18 @@ void HSPMaxHeuristic::relaxed_exploration() {
 int HSPMaxHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
 
-    setup_exploration_queue();
-    setup_exploration_queue_state(state);
-    relaxed_exploration();
+    if (incremental) {
+        explore_incrementally<relaxation_heuristic::CostCombination::MAX>(
+            state, queue, numeric_limits<int>::max());
+    } else {
+        setup_exploration_queue();
+        setup_exploration_queue_state(state);
+        relaxed_exploration();
+    }
 
     int total_cost = 0;
     for (PropID goal_id : goal_propositions) {
-        const Proposition *goal = get_proposition(goal_id);
-        int goal_cost = goal->cost;
+        int goal_cost = get_cost(goal_id);
         if (goal_cost == -1)
             return DEAD_END;
         total_cost = max(total_cost, goal_cost);
@@ -114,7 +119,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_property("safe", "yes for tasks without axioms");
     parser.document_property("preferred operators", "no");
 
-    Heuristic::add_options_to_parser(parser);
+    relaxation_heuristic::RelaxationHeuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
     if (parser.dry_run())
         return nullptr;
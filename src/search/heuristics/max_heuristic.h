@@ -11,8 +11,11 @@ namespace max_heuristic {
 using relaxation_heuristic::PropID;
 using relaxation_heuristic::OpID;
 
+using relaxation_heuristic::NO_OP;
+
 using relaxation_heuristic::Proposition;
 using relaxation_heuristic::UnaryOperator;
+using relaxation_heuristic::ExploredOperator;
 
 class HSPMaxHeuristic : public relaxation_heuristic::RelaxationHeuristic {
     priority_queues::AdaptiveQueue<PropID> queue;
@@ -23,12 +26,12 @@ class HSPMaxHeuristic : public relaxation_heuristic::RelaxationHeuristic {
 
     void enqueue_if_necessary(PropID prop_id, int cost) {
         assert(cost >= 0);
-        Proposition *prop = get_proposition(prop_id);
-        if (prop->cost == -1 || prop->cost > cost) {
-            prop->cost = cost;
+        int old_cost = get_cost(prop_id);
+        if (old_cost == -1 || old_cost > cost) {
+            set_cost(prop_id, cost, NO_OP);
             queue.push(cost, prop_id);
         }
-        assert(prop->cost != -1 && prop->cost <= cost);
+        assert(get_cost(prop_id) != -1 && get_cost(prop_id) <= cost);
     }
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
@@ -1,5 +1,7 @@
 #include "relaxation_heuristic.h"
 
+#include "../option_parser.h"
+
 #include "../task_utils/task_properties.h"
 #include "../utils/collections.h"
 #include "../utils/logging.h"
@@ -15,14 +17,23 @@ using namespace std;
 
 namespace relaxation_heuristic {
 Proposition::Proposition()
-    : cost(-1),
-      reached_by(NO_OP),
-      is_goal(false),
-      marked(false),
+    : is_goal(false),
       num_precondition_occurences(-1) {
 }
 
 
+ExploredProposition::ExploredProposition()
+    : cost(-1),
+      reached_by(NO_OP) {
+}
+
+
+ExploredOperator::ExploredOperator(int cost, int unsatisfied_preconditions)
+    : cost(cost),
+      unsatisfied_preconditions(unsatisfied_preconditions) {
+}
+
+
 UnaryOperator::UnaryOperator(
     int num_preconditions, array_pool::ArrayPoolIndex preconditions,
     PropID effect, int operator_no, int base_cost)
@@ -36,7 +47,9 @@ UnaryOperator::UnaryOperator(
 
 // construction and destruction
 RelaxationHeuristic::RelaxationHeuristic(const options::Options &opts)
-    : Heuristic(opts) {
+    : Heuristic(opts),
+      mark_generation(1),
+      incremental(opts.get<bool>("incremental", false)) {
     // Build propositions.
     propositions.resize(task_properties::get_num_facts(task_proxy));
 
@@ -90,8 +103,189 @@ RelaxationHeuristic::RelaxationHeuristic(const options::Options &opts)
             precondition_of_pool.append(precondition_of_vec);
         propositions[prop_id].num_precondition_occurences = precondition_of_vec.size();
     }
+
+    for (OpID op_id = 0; op_id < num_unary_ops; ++op_id) {
+        if (unary_operators[op_id].num_preconditions == 0)
+            unconditional_operators.push_back(op_id);
+    }
+
+    explored_propositions.resize(num_propositions);
+    reset_explored_operators.reserve(num_unary_ops);
+    for (const UnaryOperator &op : unary_operators)
+        reset_explored_operators.emplace_back(
+            op.base_cost, op.num_preconditions);
+    explored_operators = reset_explored_operators;
+    mark_generations.resize(num_propositions, 0);
+
+    if (incremental)
+        build_achievers();
+}
+
+void RelaxationHeuristic::add_options_to_parser(OptionParser &parser) {
+    Heuristic::add_options_to_parser(parser);
+    parser.add_option<bool>(
+        "incremental",
+        "compute the proposition costs of each state by repairing the costs "
+        "of the previously evaluated state instead of computing them from "
+        "scratch. This yields the same proposition costs, but ties between "
+        "the operators reaching a proposition can be broken differently, "
+        "which can change the preferred operators and the h^FF value.",
+        "false");
+}
+
+void RelaxationHeuristic::build_achievers() {
+    vector<vector<OpID>> achievers_vectors(propositions.size());
+    int num_unary_ops = unary_operators.size();
+    for (OpID op_id = 0; op_id < num_unary_ops; ++op_id)
+        achievers_vectors[unary_operators[op_id].effect].push_back(op_id);
+
+    achievers.reserve(propositions.size());
+    num_achievers.reserve(propositions.size());
+    for (const vector<OpID> &achievers_vec : achievers_vectors) {
+        achievers.push_back(achievers_pool.append(achievers_vec));
+        num_achievers.push_back(achievers_vec.size());
+    }
 }
 
+void RelaxationHeuristic::start_exploration(bool reset_costs) {
+    if (reset_costs) {
+        fill(explored_propositions.begin(), explored_propositions.end(),
+             ExploredProposition());
+        explored_operators = reset_explored_operators;
+    }
+    if (++mark_generation == 0) {
+        // The counter wrapped around, so old marks could look current.
+        fill(mark_generations.begin(), mark_generations.end(), 0);
+        mark_generation = 1;
+    }
+}
+
+template<CostCombination combination>
+bool RelaxationHeuristic::compute_operator_cost(OpID op_id, int max_cost) {
+    const UnaryOperator &op = unary_operators[op_id];
+    int cost = op.base_cost;
+    int unsatisfied_preconditions = 0;
+    bool clamped = false;
+    for (PropID precond : get_preconditions(op_id)) {
+        int precond_cost = get_cost(precond);
+        if (precond_cost == -1) {
+            ++unsatisfied_preconditions;
+        } else if (combination == CostCombination::SUM) {
+            cost += precond_cost;
+            if (cost > max_cost) {
+                cost = max_cost;
+                clamped = true;
+            }
+        } else {
+            cost = max(cost, op.base_cost + precond_cost);
+        }
+    }
+    ExploredOperator &explored_op = explored_operators[op_id];
+    explored_op.cost = cost;
+    explored_op.unsatisfied_preconditions = unsatisfied_preconditions;
+    return clamped && unsatisfied_preconditions == 0;
+}
+
+template<CostCombination combination>
+bool RelaxationHeuristic::explore_incrementally(
+    const State &state, priority_queues::AdaptiveQueue<PropID> &queue,
+    int max_cost) {
+    assert(incremental);
+    assert(queue.empty());
+    state.unpack();
+    const vector<int> &values = state.get_unpacked_values();
+    int num_variables = values.size();
+    bool clamped = false;
+
+    auto reach = [&](PropID prop_id, int cost, OpID op_id) {
+            int old_cost = get_cost(prop_id);
+            if (old_cost == -1 || cost < old_cost) {
+                set_cost(prop_id, cost, op_id);
+                queue.push(cost, prop_id);
+            }
+        };
+
+    auto reach_with = [&](OpID op_id) {
+            clamped |= compute_operator_cost<combination>(op_id, max_cost);
+            const ExploredOperator &explored_op = explored_operators[op_id];
+            if (explored_op.unsatisfied_preconditions == 0)
+                reach(unary_operators[op_id].effect, explored_op.cost, op_id);
+        };
+
+    if (explored_state_values.empty()) {
+        start_exploration();
+        for (OpID op_id : unconditional_operators)
+            reach_with(op_id);
+        for (int var = 0; var < num_variables; ++var)
+            reach(get_prop_id(var, values[var]), 0, NO_OP);
+    } else {
+        assert(static_cast<int>(explored_state_values.size()) == num_variables);
+        // Keep the exploration data of the previous state.
+        start_exploration(false);
+        /*
+          Only the costs of the facts that the new state lacks and of the
+          propositions reached through them can increase. We reset them
+          and recompute them from their achievers afterwards. All other
+          costs can only decrease, which the search below takes care of.
+        */
+        affected_propositions.clear();
+        auto reset = [&](PropID prop_id) {
+                set_cost(prop_id, -1, NO_OP);
+                affected_propositions.push_back(prop_id);
+            };
+        for (int var = 0; var < num_variables; ++var) {
+            if (explored_state_values[var] != values[var])
+                reset(get_prop_id(var, explored_state_values[var]));
+        }
+        for (size_t i = 0; i < affected_propositions.size(); ++i) {
+            const Proposition &prop = propositions[affected_propositions[i]];
+            for (OpID op_id : precondition_of_pool.get_slice(
+                     prop.precondition_of, prop.num_precondition_occurences)) {
+                PropID effect = unary_operators[op_id].effect;
+                if (get_reached_by(effect) == op_id)
+                    reset(effect);
+            }
+        }
+
+        for (int var = 0; var < num_variables; ++var) {
+            if (explored_state_values[var] != values[var])
+                reach(get_prop_id(var, values[var]), 0, NO_OP);
+        }
+        for (PropID prop_id : affected_propositions) {
+            for (OpID op_id : get_achievers(prop_id))
+                reach_with(op_id);
+        }
+    }
+
+    /*
+      Costs can decrease after a proposition has been expanded, so we
+      expand propositions again whenever their cost decreases.
+    */
+    while (!queue.empty()) {
+        pair<int, PropID> top_pair = queue.pop();
+        int distance = top_pair.first;
+        PropID prop_id = top_pair.second;
+        int prop_cost = get_cost(prop_id);
+        assert(prop_cost >= 0 && prop_cost <= distance);
+        if (prop_cost < distance)
+            continue;
+        const Proposition &prop = propositions[prop_id];
+        for (OpID op_id : precondition_of_pool.get_slice(
+                 prop.precondition_of, prop.num_precondition_occurences))
+            reach_with(op_id);
+    }
+
+    explored_state_values = values;
+    return clamped;
+}
+
+template bool RelaxationHeuristic::explore_incrementally<CostCombination::SUM>(
+    const State &state, priority_queues::AdaptiveQueue<PropID> &queue,
+    int max_cost);
+template bool RelaxationHeuristic::explore_incrementally<CostCombination::MAX>(
+    const State &state, priority_queues::AdaptiveQueue<PropID> &queue,
+    int max_cost);
+
 bool RelaxationHeuristic::dead_ends_are_reliable() const {
     return !task_properties::has_axioms(task_proxy);
 }
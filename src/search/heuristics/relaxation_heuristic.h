@@ -5,6 +5,7 @@
 
 #include "../heuristic.h"
 
+#include "../algorithms/priority_queues.h"
 #include "../utils/collections.h"
 
 #include <cassert>
@@ -22,29 +23,34 @@ using OpID = int;
 
 const OpID NO_OP = -1;
 
+/*
+  How the cost of a unary operator is computed from the costs of its
+  preconditions: h^add sums them up and h^max takes their maximum.
+*/
+enum class CostCombination {
+    SUM,
+    MAX
+};
+
+/*
+  Proposition and UnaryOperator only hold the data that does not change
+  during the exploration. The data computed for each state is stored in
+  separate, compact arrays of ExploredProposition and ExploredOperator.
+*/
 struct Proposition {
     Proposition();
-    int cost; // used for h^max cost or h^add cost
-    // TODO: Make sure in constructor that reached_by does not overflow.
-    OpID reached_by : 30;
-    /* The following two variables are conceptually bools, but Visual C++ does
-       not support packing ints and bools together in a bitfield. */
-    unsigned int is_goal : 1;
-    unsigned int marked : 1; // used for preferred operators of h^add and h^FF
+    bool is_goal;
     int num_precondition_occurences;
     array_pool::ArrayPoolIndex precondition_of;
 };
 
-static_assert(sizeof(Proposition) == 16, "Proposition has wrong size");
+static_assert(sizeof(Proposition) == 12, "Proposition has wrong size");
 
 struct UnaryOperator {
     UnaryOperator(int num_preconditions,
                   array_pool::ArrayPoolIndex preconditions,
                   PropID effect,
                   int operator_no, int base_cost);
-    int cost; // Used for h^max cost or h^add cost;
-              // includes operator cost (base_cost)
-    int unsatisfied_preconditions;
     PropID effect;
     int base_cost;
     int num_preconditions;
@@ -52,15 +58,72 @@ struct UnaryOperator {
     int operator_no; // -1 for axioms; index into the task's operators otherwise
 };
 
-static_assert(sizeof(UnaryOperator) == 28, "UnaryOperator has wrong size");
+static_assert(sizeof(UnaryOperator) == 20, "UnaryOperator has wrong size");
+
+struct ExploredProposition {
+    ExploredProposition();
+    int cost; // used for h^max cost or h^add cost; -1 if not reached
+    OpID reached_by;
+};
+
+struct ExploredOperator {
+    explicit ExploredOperator(int cost = 0, int unsatisfied_preconditions = 0);
+    int cost; // includes operator cost (base_cost)
+    int unsatisfied_preconditions;
+};
 
 class RelaxationHeuristic : public Heuristic {
     void build_unary_operators(const OperatorProxy &op);
     void simplify();
+    void build_achievers();
 
     // proposition_offsets[var_no]: first PropID related to variable var_no
     std::vector<PropID> proposition_offsets;
+
+    // Used in incremental mode only.
+    array_pool::ArrayPool achievers_pool;
+    std::vector<array_pool::ArrayPoolIndex> achievers;
+    std::vector<int> num_achievers;
+    /*
+      Values of the state for which the proposition costs hold the result
+      of a complete exploration, or empty if there is no such state.
+    */
+    std::vector<int> explored_state_values;
+    std::vector<PropID> affected_propositions;
+
+    /*
+      Data computed during the exploration, indexed by PropID and OpID,
+      respectively. Before each exploration, we overwrite the operator
+      data with the precomputed reset_explored_operators, which is a
+      single sequential copy. The marks of the propositions are reset by
+      starting a new mark generation: a proposition is marked iff its
+      entry equals mark_generation.
+    */
+    std::vector<ExploredProposition> explored_propositions;
+    std::vector<ExploredOperator> explored_operators;
+    std::vector<ExploredOperator> reset_explored_operators;
+    std::vector<unsigned int> mark_generations;
+    unsigned int mark_generation;
+
+    // Unary operators without preconditions.
+    std::vector<OpID> unconditional_operators;
+
+    // Return true iff the cost of the operator was clamped to max_cost.
+    template<CostCombination combination>
+    bool compute_operator_cost(OpID op_id, int max_cost);
 protected:
+    /*
+      In incremental mode, the costs of the propositions are not computed
+      from scratch for each state. Instead, we repair the costs of the
+      previously explored state: the costs of the facts that the new state
+      lacks and of all propositions that were reached through them are
+      recomputed from their achievers, and cost decreases caused by the new
+      facts are propagated. Since successive states usually differ in few
+      facts, this touches only a small part of the relaxed planning graph.
+      It needs complete explorations, i.e., without stopping when all goals
+      are reached, and more memory for the achievers of each proposition.
+    */
+    const bool incremental;
     std::vector<UnaryOperator> unary_operators;
     std::vector<Proposition> propositions;
     std::vector<PropID> goal_propositions;
@@ -109,9 +172,65 @@ protected:
     const Proposition *get_proposition(int var, int value) const;
     Proposition *get_proposition(int var, int value);
     Proposition *get_proposition(const FactProxy &fact);
+
+    /*
+      Reset the exploration data of all propositions and operators and
+      (in constant time) the marks of all propositions. With
+      reset_costs=false, only the marks are reset.
+    */
+    void start_exploration(bool reset_costs = true);
+
+    const std::vector<OpID> &get_unconditional_operators() const {
+        return unconditional_operators;
+    }
+
+    // Return -1 if the proposition has not been reached.
+    int get_cost(PropID prop_id) const {
+        return explored_propositions[prop_id].cost;
+    }
+
+    OpID get_reached_by(PropID prop_id) const {
+        return explored_propositions[prop_id].reached_by;
+    }
+
+    void set_cost(PropID prop_id, int cost, OpID reached_by) {
+        ExploredProposition &prop = explored_propositions[prop_id];
+        prop.cost = cost;
+        prop.reached_by = reached_by;
+    }
+
+    bool is_marked(PropID prop_id) const {
+        return mark_generations[prop_id] == mark_generation;
+    }
+
+    void mark(PropID prop_id) {
+        mark_generations[prop_id] = mark_generation;
+    }
+
+    ExploredOperator &get_explored_operator(OpID op_id) {
+        return explored_operators[op_id];
+    }
+
+    array_pool::ArrayPoolSlice get_achievers(PropID prop_id) const {
+        return achievers_pool.get_slice(
+            achievers[prop_id], num_achievers[prop_id]);
+    }
+
+    /*
+      Compute the costs of all propositions and their reached_by operators
+      for the given state in incremental mode (see above). Operator costs
+      above max_cost are clamped to max_cost. Return true iff a cost was
+      clamped.
+    */
+    template<CostCombination combination>
+    bool explore_incrementally(
+        const State &state, priority_queues::AdaptiveQueue<PropID> &queue,
+        int max_cost);
 public:
     explicit RelaxationHeuristic(const options::Options &options);
 
+    static void add_options_to_parser(options::OptionParser &parser);
+
     virtual bool dead_ends_are_reliable() const override;
 };
 }
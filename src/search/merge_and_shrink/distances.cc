@@ -5,15 +5,23 @@
 
 #include "../algorithms/priority_queues.h"
 #include "../utils/logging.h"
+#include "../utils/thread_pool.h"
 
 #include <cassert>
 #include <deque>
+#include <numeric>
 
 using namespace std;
 
 namespace merge_and_shrink {
 const int Distances::DISTANCE_UNKNOWN;
 
+/*
+  Below this size, computing init and goal distances concurrently does not
+  pay off the synchronization overhead.
+*/
+static const int MIN_STATES_FOR_CONCURRENT_DISTANCES = 10000;
+
 Distances::Distances(const TransitionSystem &transition_system)
     : transition_system(transition_system) {
     clear_distances();
@@ -47,14 +55,71 @@ bool Distances::is_unit_cost() const {
     return true;
 }
 
+/*
+  Adjacency lists of all states in compressed sparse row format: the
+  successors of a state s in the forward graph (its predecessors in the
+  backward graph) are entries[offsets[s]], ..., entries[offsets[s + 1] - 1].
+  Compared to one vector per state, this needs two allocations in total.
+*/
+template<typename Entry>
+struct Graph {
+    vector<size_t> offsets;
+    vector<Entry> entries;
+};
+
+/*
+  Create the forward or backward graph of the given transition system.
+  make_entry(neighbor, cost) creates the entry for a transition to the
+  neighbor with the given cost.
+*/
+template<typename Entry, typename MakeEntry>
+static Graph<Entry> create_graph(
+    const TransitionSystem &transition_system, bool forward,
+    const MakeEntry &make_entry) {
+    Graph<Entry> graph;
+    graph.offsets.assign(transition_system.get_size() + 1, 0);
+    for (GroupAndTransitions gat : transition_system) {
+        for (const Transition &transition : gat.transitions) {
+            ++graph.offsets[(forward ? transition.src : transition.target) + 1];
+        }
+    }
+    partial_sum(graph.offsets.begin(), graph.offsets.end(), graph.offsets.begin());
+
+    graph.entries.resize(graph.offsets.back());
+    vector<size_t> next_entry(graph.offsets.begin(), graph.offsets.end() - 1);
+    for (GroupAndTransitions gat : transition_system) {
+        int cost = gat.label_group.get_cost();
+        for (const Transition &transition : gat.transitions) {
+            int state = forward ? transition.src : transition.target;
+            int neighbor = forward ? transition.target : transition.src;
+            graph.entries[next_entry[state]++] = make_entry(neighbor, cost);
+        }
+    }
+    return graph;
+}
+
+static Graph<int> create_unit_cost_graph(
+    const TransitionSystem &transition_system, bool forward) {
+    return create_graph<int>(
+        transition_system, forward,
+        [](int neighbor, int) {return neighbor;});
+}
+
+static Graph<pair<int, int>> create_general_cost_graph(
+    const TransitionSystem &transition_system, bool forward) {
+    return create_graph<pair<int, int>>(
+        transition_system, forward,
+        [](int neighbor, int cost) {return make_pair(neighbor, cost);});
+}
+
 static void breadth_first_search(
-    const vector<vector<int>> &graph, deque<int> &queue,
+    const Graph<int> &graph, deque<int> &queue,
     vector<int> &distances) {
     while (!queue.empty()) {
         int state = queue.front();
         queue.pop_front();
-        for (size_t i = 0; i < graph[state].size(); ++i) {
-            int successor = graph[state][i];
+        for (size_t i = graph.offsets[state]; i < graph.offsets[state + 1]; ++i) {
+            int successor = graph.entries[i];
             if (distances[successor] > distances[state] + 1) {
                 distances[successor] = distances[state] + 1;
                 queue.push_back(successor);
@@ -64,13 +129,7 @@ static void breadth_first_search(
 }
 
 void Distances::compute_init_distances_unit_cost() {
-    vector<vector<int>> forward_graph(get_num_states());
-    for (GroupAndTransitions gat : transition_system) {
-        const vector<Transition> &transitions = gat.transitions;
-        for (const Transition &transition : transitions) {
-            forward_graph[transition.src].push_back(transition.target);
-        }
-    }
+    Graph<int> forward_graph = create_unit_cost_graph(transition_system, true);
 
     deque<int> queue;
     queue.push_back(transition_system.get_init_state());
@@ -79,13 +138,7 @@ void Distances::compute_init_distances_unit_cost() {
 }
 
 void Distances::compute_goal_distances_unit_cost() {
-    vector<vector<int>> backward_graph(get_num_states());
-    for (GroupAndTransitions gat : transition_system) {
-        const vector<Transition> &transitions = gat.transitions;
-        for (const Transition &transition : transitions) {
-            backward_graph[transition.target].push_back(transition.src);
-        }
-    }
+    Graph<int> backward_graph = create_unit_cost_graph(transition_system, false);
 
     deque<int> queue;
     for (int state = 0; state < get_num_states(); ++state) {
@@ -98,7 +151,7 @@ void Distances::compute_goal_distances_unit_cost() {
 }
 
 static void dijkstra_search(
-    const vector<vector<pair<int, int>>> &graph,
+    const Graph<pair<int, int>> &graph,
     priority_queues::AdaptiveQueue<int> &queue,
     vector<int> &distances) {
     while (!queue.empty()) {
@@ -109,8 +162,8 @@ static void dijkstra_search(
         assert(state_distance <= distance);
         if (state_distance < distance)
             continue;
-        for (size_t i = 0; i < graph[state].size(); ++i) {
-            const pair<int, int> &transition = graph[state][i];
+        for (size_t i = graph.offsets[state]; i < graph.offsets[state + 1]; ++i) {
+            const pair<int, int> &transition = graph.entries[i];
             int successor = transition.first;
             int cost = transition.second;
             int successor_cost = state_distance + cost;
@@ -123,16 +176,8 @@ static void dijkstra_search(
 }
 
 void Distances::compute_init_distances_general_cost() {
-    vector<vector<pair<int, int>>> forward_graph(get_num_states());
-    for (GroupAndTransitions gat : transition_system) {
-        const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
-        int cost = label_group.get_cost();
-        for (const Transition &transition : transitions) {
-            forward_graph[transition.src].push_back(
-                make_pair(transition.target, cost));
-        }
-    }
+    Graph<pair<int, int>> forward_graph =
+        create_general_cost_graph(transition_system, true);
 
     // TODO: Reuse the same queue for multiple computations to save speed?
     //       Also see compute_goal_distances_general_cost.
@@ -143,16 +188,8 @@ void Distances::compute_init_distances_general_cost() {
 }
 
 void Distances::compute_goal_distances_general_cost() {
-    vector<vector<pair<int, int>>> backward_graph(get_num_states());
-    for (GroupAndTransitions gat : transition_system) {
-        const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
-        int cost = label_group.get_cost();
-        for (const Transition &transition : transitions) {
-            backward_graph[transition.target].push_back(
-                make_pair(transition.src, cost));
-        }
-    }
+    Graph<pair<int, int>> backward_graph =
+        create_general_cost_graph(transition_system, false);
 
     // TODO: Reuse the same queue for multiple computations to save speed?
     //       Also see compute_init_distances_general_cost.
@@ -169,7 +206,8 @@ void Distances::compute_goal_distances_general_cost() {
 void Distances::compute_distances(
     bool compute_init_distances,
     bool compute_goal_distances,
-    utils::LogProxy &log) {
+    utils::LogProxy &log,
+    utils::ThreadPool *thread_pool) {
     assert(compute_init_distances || compute_goal_distances);
     /*
       This method does the following:
@@ -229,25 +267,38 @@ void Distances::compute_distances(
         }
         log << " distances using ";
     }
-    if (is_unit_cost()) {
-        if (log.is_at_least_verbose()) {
-            log << "unit-cost";
-        }
-        if (compute_init_distances) {
-            compute_init_distances_unit_cost();
-        }
-        if (compute_goal_distances) {
-            compute_goal_distances_unit_cost();
-        }
+    bool unit_cost = is_unit_cost();
+    if (log.is_at_least_verbose()) {
+        log << (unit_cost ? "unit-cost" : "general-cost");
+    }
+    // The two computations only read the transition system.
+    auto compute = [this, unit_cost](bool init) {
+            if (unit_cost) {
+                if (init) {
+                    compute_init_distances_unit_cost();
+                } else {
+                    compute_goal_distances_unit_cost();
+                }
+            } else {
+                if (init) {
+                    compute_init_distances_general_cost();
+                } else {
+                    compute_goal_distances_general_cost();
+                }
+            }
+        };
+    if (thread_pool && thread_pool->get_num_threads() > 1 &&
+        compute_init_distances && compute_goal_distances &&
+        num_states >= MIN_STATES_FOR_CONCURRENT_DISTANCES) {
+        thread_pool->run(2, [&compute](int task_id, int) {
+                             compute(task_id == 0);
+                         });
     } else {
-        if (log.is_at_least_verbose()) {
-            log << "general-cost";
-        }
         if (compute_init_distances) {
-            compute_init_distances_general_cost();
+            compute(true);
         }
         if (compute_goal_distances) {
-            compute_goal_distances_general_cost();
+            compute(false);
         }
     }
     if (log.is_at_least_verbose()) {
@@ -266,7 +317,8 @@ void Distances::apply_abstraction(
     const StateEquivalenceRelation &state_equivalence_relation,
     bool compute_init_distances,
     bool compute_goal_distances,
-    utils::LogProxy &log) {
+    utils::LogProxy &log,
+    utils::ThreadPool *thread_pool) {
     if (compute_init_distances) {
         assert(are_init_distances_computed());
         assert(state_equivalence_relation.size() < init_distances.size());
@@ -332,7 +384,7 @@ void Distances::apply_abstraction(
         }
         clear_distances();
         compute_distances(
-            compute_init_distances, compute_goal_distances, log);
+            compute_init_distances, compute_goal_distances, log, thread_pool);
     } else {
         init_distances = move(new_init_distances);
         goal_distances = move(new_goal_distances);
@@ -16,6 +16,7 @@
 
 namespace utils {
 class LogProxy;
+class ThreadPool;
 }
 
 namespace merge_and_shrink {
@@ -49,10 +50,16 @@ public:
         return goal_distances_computed;
     }
 
+    /*
+      If a thread pool is given and both kinds of distances are needed for
+      a large transition system, init and goal distances are computed
+      concurrently.
+    */
     void compute_distances(
         bool compute_init_distances,
         bool compute_goal_distances,
-        utils::LogProxy &log);
+        utils::LogProxy &log,
+        utils::ThreadPool *thread_pool = nullptr);
 
     /*
       Update distances according to the given abstraction. If the abstraction
@@ -67,7 +74,8 @@ public:
         const StateEquivalenceRelation &state_equivalence_relation,
         bool compute_init_distances,
         bool compute_goal_distances,
-        utils::LogProxy &log);
+        utils::LogProxy &log,
+        utils::ThreadPool *thread_pool = nullptr);
 
     int get_init_distance(int state) const {
         assert(are_init_distances_computed());
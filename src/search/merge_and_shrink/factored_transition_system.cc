@@ -50,7 +50,8 @@ FactoredTransitionSystem::FactoredTransitionSystem(
       distances(move(distances)),
       compute_init_distances(compute_init_distances),
       compute_goal_distances(compute_goal_distances),
-      num_active_entries(this->transition_systems.size()) {
+      num_active_entries(this->transition_systems.size()),
+      thread_pool(nullptr) {
     for (size_t index = 0; index < this->transition_systems.size(); ++index) {
         if (compute_init_distances || compute_goal_distances) {
             this->distances[index]->compute_distances(
@@ -67,7 +68,8 @@ FactoredTransitionSystem::FactoredTransitionSystem(FactoredTransitionSystem &&ot
       distances(move(other.distances)),
       compute_init_distances(move(other.compute_init_distances)),
       compute_goal_distances(move(other.compute_goal_distances)),
-      num_active_entries(move(other.num_active_entries)) {
+      num_active_entries(move(other.num_active_entries)),
+      thread_pool(other.thread_pool) {
     /*
       This is just a default move constructor. Unfortunately Visual
       Studio does not support "= default" for move construction or
@@ -147,7 +149,8 @@ bool FactoredTransitionSystem::apply_abstraction(
             state_equivalence_relation,
             compute_init_distances,
             compute_goal_distances,
-            log);
+            log,
+            thread_pool);
     }
     mas_representations[index]->apply_abstraction_to_lookup_table(
         abstraction_mapping);
@@ -186,7 +189,7 @@ int FactoredTransitionSystem::merge(
     // Restore the invariant that distances are computed.
     if (compute_init_distances || compute_goal_distances) {
         distances[new_index]->compute_distances(
-            compute_init_distances, compute_goal_distances, log);
+            compute_init_distances, compute_goal_distances, log, thread_pool);
     }
     --num_active_entries;
     assert(is_component_valid(new_index));
@@ -10,6 +10,7 @@
 
 namespace utils {
 class LogProxy;
+class ThreadPool;
 }
 
 namespace merge_and_shrink {
@@ -68,6 +69,8 @@ class FactoredTransitionSystem {
     const bool compute_init_distances;
     const bool compute_goal_distances;
     int num_active_entries;
+    // Not owned. Used for computing distances and scoring merge candidates.
+    utils::ThreadPool *thread_pool;
 
     /*
       Assert that the factor at the given index is in a consistent state, i.e.
@@ -184,6 +187,18 @@ public:
         return num_active_entries;
     }
 
+    /*
+      Let transformations of this FTS and computations on it use the given
+      thread pool (or none if nullptr). The pool must outlive its use.
+    */
+    void set_thread_pool(utils::ThreadPool *pool) {
+        thread_pool = pool;
+    }
+
+    utils::ThreadPool *get_thread_pool() const {
+        return thread_pool;
+    }
+
     // Used by LabelReduction and MergeScoringFunctionDFP
     const Labels &get_labels() const {
         return *labels;
@@ -22,6 +22,7 @@
 #include "../utils/markup.h"
 #include "../utils/math.h"
 #include "../utils/system.h"
+#include "../utils/thread_pool.h"
 #include "../utils/timer.h"
 
 #include <cassert>
@@ -52,6 +53,7 @@ MergeAndShrinkAlgorithm::MergeAndShrinkAlgorithm(const Options &opts) :
     prune_irrelevant_states(opts.get<bool>("prune_irrelevant_states")),
     log(utils::get_log_from_options(opts)),
     main_loop_max_time(opts.get<double>("main_loop_max_time")),
+    num_threads(opts.get<int>("threads")),
     starting_peak_memory(0) {
     assert(max_states_before_merge > 0);
     assert(max_states >= max_states_before_merge);
@@ -97,6 +99,7 @@ void MergeAndShrinkAlgorithm::dump_options() const {
         log << endl;
 
         log << "Main loop max time in seconds: " << main_loop_max_time << endl;
+        log << "Number of threads: " << num_threads << endl;
         log << endl;
     }
 }
@@ -358,6 +361,12 @@ FactoredTransitionSystem MergeAndShrinkAlgorithm::build_factored_transition_syst
             compute_init_distances,
             compute_goal_distances,
             log);
+    /*
+      The thread pool only lives during the computation, so the returned
+      factored transition system must not refer to it anymore.
+    */
+    utils::ThreadPool thread_pool(num_threads);
+    fts.set_thread_pool(&thread_pool);
     if (log.is_at_least_normal()) {
         log_progress(timer, "after computation of atomic factors", log);
     }
@@ -397,6 +406,7 @@ FactoredTransitionSystem MergeAndShrinkAlgorithm::build_factored_transition_syst
     if (!unsolvable && main_loop_max_time > 0) {
         main_loop(fts, task_proxy);
     }
+    fts.set_thread_pool(nullptr);
     const bool final = true;
     report_peak_memory_delta(final);
     log << "Merge-and-shrink algorithm runtime: " << timer << endl;
@@ -452,6 +462,15 @@ void add_merge_and_shrink_algorithm_options_to_parser(OptionParser &parser) {
         "transformation is runtime-intense.",
         "infinity",
         Bounds("0.0", "infinity"));
+    parser.add_option<int>(
+        "threads",
+        "Number of threads used for computing the scores of merge candidates "
+        "(if all scoring functions support it) and for computing the "
+        "distances of large transition systems. Shrinking, merging and "
+        "label reduction are always sequential. The result does not depend "
+        "on the number of threads.",
+        "1",
+        Bounds("1", "infinity"));
 }
 
 void add_transition_system_size_limit_options_to_parser(OptionParser &parser) {
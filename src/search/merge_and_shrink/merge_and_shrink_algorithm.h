@@ -44,6 +44,8 @@ class MergeAndShrinkAlgorithm {
 
     mutable utils::LogProxy log;
     const double main_loop_max_time;
+    // Number of threads for computing merge scores and distances.
+    const int num_threads;
 
     long starting_peak_memory;
 
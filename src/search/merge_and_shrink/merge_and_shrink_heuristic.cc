@@ -12,6 +12,7 @@
 
 #include "../task_utils/task_properties.h"
 
+#include "../utils/heuristic_cache.h"
 #include "../utils/markup.h"
 #include "../utils/system.h"
 
@@ -26,12 +27,62 @@ namespace merge_and_shrink {
 MergeAndShrinkHeuristic::MergeAndShrinkHeuristic(const options::Options &opts)
     : Heuristic(opts) {
     log << "Initializing merge-and-shrink heuristic..." << endl;
+    string cache_key;
+    if (utils::uses_heuristic_cache()) {
+        cache_key = compute_cache_key("merge-and-shrink");
+        if (load_from_cache(cache_key)) {
+            log << "Loaded " << mas_representations.size()
+                << " factor(s) from the heuristic cache." << endl;
+            log << "Done initializing merge-and-shrink heuristic." << endl << endl;
+            return;
+        }
+    }
     MergeAndShrinkAlgorithm algorithm(opts);
     FactoredTransitionSystem fts = algorithm.build_factored_transition_system(task_proxy);
     extract_factors(fts);
+    if (!cache_key.empty()) {
+        store_in_cache(cache_key);
+    }
     log << "Done initializing merge-and-shrink heuristic." << endl << endl;
 }
 
+bool MergeAndShrinkHeuristic::load_from_cache(const string &key) {
+    unique_ptr<utils::CacheReader> reader =
+        utils::CacheReader::open("merge-and-shrink", key);
+    if (!reader) {
+        return false;
+    }
+    int num_factors = reader->read_int();
+    if (num_factors < 0) {
+        return false;
+    }
+    VariablesProxy variables = task_proxy.get_variables();
+    for (int i = 0; i < num_factors; ++i) {
+        unique_ptr<MergeAndShrinkRepresentation> mas_representation =
+            MergeAndShrinkRepresentation::load(*reader, variables);
+        if (!mas_representation) {
+            mas_representations.clear();
+            return false;
+        }
+        mas_representations.push_back(move(mas_representation));
+    }
+    if (!reader->is_complete()) {
+        mas_representations.clear();
+        return false;
+    }
+    return true;
+}
+
+void MergeAndShrinkHeuristic::store_in_cache(const string &key) const {
+    utils::CacheWriter writer("merge-and-shrink", key);
+    writer.write_int(mas_representations.size());
+    for (const unique_ptr<MergeAndShrinkRepresentation> &mas_representation :
+         mas_representations) {
+        mas_representation->save(writer);
+    }
+    writer.commit();
+}
+
 void MergeAndShrinkHeuristic::extract_factor(
     FactoredTransitionSystem &fts, int index) {
     /*
@@ -4,6 +4,7 @@
 #include "../heuristic.h"
 
 #include <memory>
+#include <string>
 
 namespace merge_and_shrink {
 class FactoredTransitionSystem;
@@ -17,6 +18,9 @@ class MergeAndShrinkHeuristic : public Heuristic {
     bool extract_unsolvable_factor(FactoredTransitionSystem &fts);
     void extract_nontrivial_factors(FactoredTransitionSystem &fts);
     void extract_factors(FactoredTransitionSystem &fts);
+
+    bool load_from_cache(const std::string &key);
+    void store_in_cache(const std::string &key) const;
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
 public:
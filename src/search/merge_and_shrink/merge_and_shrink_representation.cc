@@ -5,7 +5,9 @@
 
 #include "../task_proxy.h"
 
+#include "../utils/heuristic_cache.h"
 #include "../utils/logging.h"
+#include "../utils/memory.h"
 
 #include <algorithm>
 #include <cassert>
@@ -26,6 +28,56 @@ int MergeAndShrinkRepresentation::get_domain_size() const {
     return domain_size;
 }
 
+// Node types in heuristic cache entries.
+static const int LEAF_NODE = 0;
+static const int MERGE_NODE = 1;
+
+unique_ptr<MergeAndShrinkRepresentation> MergeAndShrinkRepresentation::load(
+    utils::CacheReader &reader, const VariablesProxy &variables) {
+    int node_type = reader.read_int();
+    int domain_size = reader.read_int();
+    if (node_type == LEAF_NODE) {
+        int var_id = reader.read_int();
+        vector<int> lookup_table = reader.read_vector<int>();
+        if (!reader.is_valid() || var_id < 0 ||
+            var_id >= static_cast<int>(variables.size()) ||
+            static_cast<int>(lookup_table.size()) !=
+            variables[var_id].get_domain_size()) {
+            return nullptr;
+        }
+        return utils::make_unique_ptr<MergeAndShrinkRepresentationLeaf>(
+            var_id, domain_size, move(lookup_table));
+    } else if (node_type == MERGE_NODE) {
+        unique_ptr<MergeAndShrinkRepresentation> left_child =
+            load(reader, variables);
+        if (!left_child) {
+            return nullptr;
+        }
+        unique_ptr<MergeAndShrinkRepresentation> right_child =
+            load(reader, variables);
+        if (!right_child) {
+            return nullptr;
+        }
+        int num_rows = reader.read_int();
+        if (!reader.is_valid() || num_rows != left_child->get_domain_size()) {
+            return nullptr;
+        }
+        vector<vector<int>> lookup_table;
+        lookup_table.reserve(num_rows);
+        for (int row = 0; row < num_rows; ++row) {
+            lookup_table.push_back(reader.read_vector<int>());
+            if (!reader.is_valid() || static_cast<int>(lookup_table.back().size()) !=
+                right_child->get_domain_size()) {
+                return nullptr;
+            }
+        }
+        return utils::make_unique_ptr<MergeAndShrinkRepresentationMerge>(
+            move(left_child), move(right_child), domain_size,
+            move(lookup_table));
+    }
+    return nullptr;
+}
+
 
 MergeAndShrinkRepresentationLeaf::MergeAndShrinkRepresentationLeaf(
     int var_id, int domain_size)
@@ -35,6 +87,13 @@ MergeAndShrinkRepresentationLeaf::MergeAndShrinkRepresentationLeaf(
     iota(lookup_table.begin(), lookup_table.end(), 0);
 }
 
+MergeAndShrinkRepresentationLeaf::MergeAndShrinkRepresentationLeaf(
+    int var_id, int domain_size, vector<int> &&lookup_table)
+    : MergeAndShrinkRepresentation(domain_size),
+      var_id(var_id),
+      lookup_table(move(lookup_table)) {
+}
+
 void MergeAndShrinkRepresentationLeaf::set_distances(
     const Distances &distances) {
     assert(distances.are_goal_distances_computed());
@@ -81,6 +140,13 @@ void MergeAndShrinkRepresentationLeaf::dump(utils::LogProxy &log) const {
     }
 }
 
+void MergeAndShrinkRepresentationLeaf::save(utils::CacheWriter &writer) const {
+    writer.write_int(LEAF_NODE);
+    writer.write_int(domain_size);
+    writer.write_int(var_id);
+    writer.write_vector(lookup_table);
+}
+
 
 MergeAndShrinkRepresentationMerge::MergeAndShrinkRepresentationMerge(
     unique_ptr<MergeAndShrinkRepresentation> left_child_,
@@ -100,6 +166,16 @@ MergeAndShrinkRepresentationMerge::MergeAndShrinkRepresentationMerge(
     }
 }
 
+MergeAndShrinkRepresentationMerge::MergeAndShrinkRepresentationMerge(
+    unique_ptr<MergeAndShrinkRepresentation> left_child,
+    unique_ptr<MergeAndShrinkRepresentation> right_child,
+    int domain_size, vector<vector<int>> &&lookup_table)
+    : MergeAndShrinkRepresentation(domain_size),
+      left_child(move(left_child)),
+      right_child(move(right_child)),
+      lookup_table(move(lookup_table)) {
+}
+
 void MergeAndShrinkRepresentationMerge::set_distances(
     const Distances &distances) {
     assert(distances.are_goal_distances_computed());
@@ -161,4 +237,15 @@ void MergeAndShrinkRepresentationMerge::dump(utils::LogProxy &log) const {
         right_child->dump(log);
     }
 }
+
+void MergeAndShrinkRepresentationMerge::save(utils::CacheWriter &writer) const {
+    writer.write_int(MERGE_NODE);
+    writer.write_int(domain_size);
+    left_child->save(writer);
+    right_child->save(writer);
+    writer.write_int(lookup_table.size());
+    for (const vector<int> &row : lookup_table) {
+        writer.write_vector(row);
+    }
+}
 }
@@ -5,8 +5,11 @@
 #include <vector>
 
 class State;
+class VariablesProxy;
 
 namespace utils {
+class CacheReader;
+class CacheWriter;
 class LogProxy;
 }
 
@@ -37,6 +40,15 @@ public:
        to PRUNED_STATE. */
     virtual bool is_total() const = 0;
     virtual void dump(utils::LogProxy &log) const = 0;
+
+    // Store the representation in a heuristic cache entry.
+    virtual void save(utils::CacheWriter &writer) const = 0;
+    /*
+      Load a representation stored with save(). Return nullptr if the entry
+      does not contain a valid representation for the given variables.
+    */
+    static std::unique_ptr<MergeAndShrinkRepresentation> load(
+        utils::CacheReader &reader, const VariablesProxy &variables);
 };
 
 
@@ -46,6 +58,8 @@ class MergeAndShrinkRepresentationLeaf : public MergeAndShrinkRepresentation {
     std::vector<int> lookup_table;
 public:
     MergeAndShrinkRepresentationLeaf(int var_id, int domain_size);
+    MergeAndShrinkRepresentationLeaf(
+        int var_id, int domain_size, std::vector<int> &&lookup_table);
     virtual ~MergeAndShrinkRepresentationLeaf() = default;
 
     virtual void set_distances(const Distances &) override;
@@ -54,6 +68,7 @@ public:
     virtual int get_value(const State &state) const override;
     virtual bool is_total() const override;
     virtual void dump(utils::LogProxy &log) const override;
+    virtual void save(utils::CacheWriter &writer) const override;
 };
 
 
@@ -65,6 +80,10 @@ public:
     MergeAndShrinkRepresentationMerge(
         std::unique_ptr<MergeAndShrinkRepresentation> left_child,
         std::unique_ptr<MergeAndShrinkRepresentation> right_child);
+    MergeAndShrinkRepresentationMerge(
+        std::unique_ptr<MergeAndShrinkRepresentation> left_child,
+        std::unique_ptr<MergeAndShrinkRepresentation> right_child,
+        int domain_size, std::vector<std::vector<int>> &&lookup_table);
     virtual ~MergeAndShrinkRepresentationMerge() = default;
 
     virtual void set_distances(const Distances &distances) override;
@@ -73,6 +92,7 @@ public:
     virtual int get_value(const State &state) const override;
     virtual bool is_total() const override;
     virtual void dump(utils::LogProxy &log) const override;
+    virtual void save(utils::CacheWriter &writer) const override;
 };
 }
 
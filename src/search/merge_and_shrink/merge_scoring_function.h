@@ -26,6 +26,15 @@ public:
     virtual bool requires_init_distances() const = 0;
     virtual bool requires_goal_distances() const = 0;
 
+    /*
+      Return true if compute_scores may be called concurrently for disjoint
+      subsets of the merge candidates and the score of a candidate does not
+      depend on the other candidates.
+    */
+    virtual bool is_thread_safe() const {
+        return false;
+    }
+
     // Overriding methods must set initialized to true.
     virtual void initialize(const TaskProxy &) {
         initialized = true;
@@ -23,6 +23,10 @@ public:
     virtual bool requires_goal_distances() const override {
         return true;
     }
+
+    virtual bool is_thread_safe() const override {
+        return true;
+    }
 };
 }
 
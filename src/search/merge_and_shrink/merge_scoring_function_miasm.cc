@@ -70,6 +70,10 @@ vector<double> MergeScoringFunctionMIASM::compute_scores(
     return scores;
 }
 
+bool MergeScoringFunctionMIASM::is_thread_safe() const {
+    return shrink_strategy->is_thread_safe();
+}
+
 string MergeScoringFunctionMIASM::name() const {
     return "miasm";
 }
@@ -127,6 +131,8 @@ static shared_ptr<MergeScoringFunction>_parse(options::OptionParser &parser) {
         "We recommend setting this to match the shrink strategy configuration "
         "given to {{{merge_and_shrink}}}, see note below.");
     add_transition_system_size_limit_options_to_parser(parser);
+    // Needed for the warnings of handle_shrink_limit_options_defaults.
+    utils::add_log_options_to_parser(parser);
 
     options::Options options = parser.parse();
     if (parser.help_mode()) {
@@ -31,6 +31,8 @@ public:
     virtual bool requires_goal_distances() const override {
         return true;
     }
+
+    virtual bool is_thread_safe() const override;
 };
 }
 
@@ -51,6 +51,10 @@ public:
     virtual bool requires_goal_distances() const override {
         return false;
     }
+
+    virtual bool is_thread_safe() const override {
+        return true;
+    }
 };
 }
 
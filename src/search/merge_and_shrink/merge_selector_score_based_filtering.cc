@@ -7,6 +7,8 @@
 #include "../options/options.h"
 #include "../options/plugin.h"
 
+#include "../utils/thread_pool.h"
+
 #include <cassert>
 
 using namespace std;
@@ -19,6 +21,46 @@ MergeSelectorScoreBasedFiltering::MergeSelectorScoreBasedFiltering(
               "scoring_functions")) {
 }
 
+/*
+  Number of candidate chunks per thread when scoring in parallel. Using
+  several chunks per thread balances the load if scores take different
+  amounts of time to compute (e.g. for MIASM).
+*/
+static const int CHUNKS_PER_THREAD = 4;
+
+vector<double> MergeSelectorScoreBasedFiltering::compute_scores(
+    MergeScoringFunction &scoring_function,
+    const FactoredTransitionSystem &fts,
+    const vector<pair<int, int>> &merge_candidates) const {
+    utils::ThreadPool *thread_pool = fts.get_thread_pool();
+    int num_candidates = merge_candidates.size();
+    if (!thread_pool || thread_pool->get_num_threads() == 1 ||
+        num_candidates < 2 || !scoring_function.is_thread_safe()) {
+        return scoring_function.compute_scores(fts, merge_candidates);
+    }
+
+    int num_chunks = min(
+        num_candidates, thread_pool->get_num_threads() * CHUNKS_PER_THREAD);
+    vector<vector<double>> chunk_scores(num_chunks);
+    thread_pool->run(
+        num_chunks, [&](int chunk, int) {
+            auto begin = merge_candidates.begin() +
+                static_cast<long>(chunk) * num_candidates / num_chunks;
+            auto end = merge_candidates.begin() +
+                static_cast<long>(chunk + 1) * num_candidates / num_chunks;
+            chunk_scores[chunk] = scoring_function.compute_scores(
+                fts, vector<pair<int, int>>(begin, end));
+        });
+
+    vector<double> scores;
+    scores.reserve(num_candidates);
+    for (const vector<double> &chunk : chunk_scores) {
+        scores.insert(scores.end(), chunk.begin(), chunk.end());
+    }
+    assert(static_cast<int>(scores.size()) == num_candidates);
+    return scores;
+}
+
 vector<pair<int, int>> MergeSelectorScoreBasedFiltering::get_remaining_candidates(
     const vector<pair<int, int>> &merge_candidates,
     const vector<double> &scores) const {
@@ -47,8 +89,8 @@ pair<int, int> MergeSelectorScoreBasedFiltering::select_merge(
 
     for (const shared_ptr<MergeScoringFunction> &scoring_function :
          merge_scoring_functions) {
-        vector<double> scores = scoring_function->compute_scores(
-            fts, merge_candidates);
+        vector<double> scores = compute_scores(
+            *scoring_function, fts, merge_candidates);
         merge_candidates = get_remaining_candidates(merge_candidates, scores);
         if (merge_candidates.size() == 1) {
             break;
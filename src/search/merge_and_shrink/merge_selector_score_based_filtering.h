@@ -16,6 +16,10 @@ namespace merge_and_shrink {
 class MergeSelectorScoreBasedFiltering : public MergeSelector {
     std::vector<std::shared_ptr<MergeScoringFunction>> merge_scoring_functions;
 
+    std::vector<double> compute_scores(
+        MergeScoringFunction &scoring_function,
+        const FactoredTransitionSystem &fts,
+        const std::vector<std::pair<int, int>> &merge_candidates) const;
     std::vector<std::pair<int, int>> get_remaining_candidates(
         const std::vector<std::pair<int, int>> &merge_candidates,
         const std::vector<double> &scores) const;
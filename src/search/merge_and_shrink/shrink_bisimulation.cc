@@ -18,6 +18,7 @@
 #include <limits>
 #include <iostream>
 #include <memory>
+#include <numeric>
 #include <unordered_map>
 
 using namespace std;
@@ -28,10 +29,14 @@ namespace merge_and_shrink {
    identical successor signature are not distinguished by
    bisimulation.
 
-   Each entry in the vector is a pair of (label group ID, equivalence class of
-   successor). The bisimulation algorithm requires that the vector is
-   sorted and uniquified. */
-using SuccessorSignature = vector<pair<int, int>>;
+   Each entry is a pair of (label group ID, equivalence class of
+   successor). The bisimulation algorithm requires that the entries are
+   sorted and uniquified.
+
+   The successor signatures of all states are stored consecutively in one
+   vector (see compute_signatures), and each signature refers to its part
+   of it. */
+using SuccessorSignatureEntry = pair<int, int>;
 
 /*
   As we use SENTINEL numeric_limits<int>::max() as a sentinel signature and
@@ -52,13 +57,18 @@ const int IRRELEVANT = SENTINEL - 1;
 struct Signature {
     int h_and_goal; // -1 for goal states; h value for non-goal states
     int group;
-    SuccessorSignature succ_signature;
+    const SuccessorSignatureEntry *succ_signature_begin;
+    const SuccessorSignatureEntry *succ_signature_end;
     int state;
 
     Signature(int h, bool is_goal, int group_,
-              const SuccessorSignature &succ_signature_,
+              const SuccessorSignatureEntry *succ_signature_begin_,
+              const SuccessorSignatureEntry *succ_signature_end_,
               int state_)
-        : group(group_), succ_signature(succ_signature_), state(state_) {
+        : group(group_),
+          succ_signature_begin(succ_signature_begin_),
+          succ_signature_end(succ_signature_end_),
+          state(state_) {
         if (is_goal) {
             assert(h == 0);
             h_and_goal = -1;
@@ -67,13 +77,22 @@ struct Signature {
         }
     }
 
+    bool has_same_succ_signature(const Signature &other) const {
+        return succ_signature_end - succ_signature_begin ==
+               other.succ_signature_end - other.succ_signature_begin &&
+               equal(succ_signature_begin, succ_signature_end,
+                     other.succ_signature_begin);
+    }
+
     bool operator<(const Signature &other) const {
         if (h_and_goal != other.h_and_goal)
             return h_and_goal < other.h_and_goal;
         if (group != other.group)
             return group < other.group;
-        if (succ_signature != other.succ_signature)
-            return succ_signature < other.succ_signature;
+        if (!has_same_succ_signature(other))
+            return lexicographical_compare(
+                succ_signature_begin, succ_signature_end,
+                other.succ_signature_begin, other.succ_signature_end);
         return state < other.state;
     }
 
@@ -83,11 +102,12 @@ struct Signature {
                 << ", group = " << group
                 << ", state = " << state
                 << ", succ_sig = [";
-            for (size_t i = 0; i < succ_signature.size(); ++i) {
-                if (i)
+            for (const SuccessorSignatureEntry *entry = succ_signature_begin;
+                 entry != succ_signature_end; ++entry) {
+                if (entry != succ_signature_begin)
                     log << ", ";
-                log << "(" << succ_signature[i].first
-                    << "," << succ_signature[i].second
+                log << "(" << entry->first
+                    << "," << entry->second
                     << ")";
             }
             log << "])" << endl;
@@ -143,22 +163,27 @@ void ShrinkBisimulation::compute_signatures(
     const TransitionSystem &ts,
     const Distances &distances,
     vector<Signature> &signatures,
+    vector<SuccessorSignatureEntry> &succ_signatures,
     const vector<int> &state_to_group) const {
     assert(signatures.empty());
+    int num_states = ts.get_size();
 
-    // Step 1: Compute bare state signatures (without transition information).
-    signatures.push_back(Signature(-2, false, -1, SuccessorSignature(), -1));
-    for (int state = 0; state < ts.get_size(); ++state) {
-        int h = distances.get_goal_distance(state);
-        if (h == INF) {
-            h = IRRELEVANT;
+    /*
+      Step 1: Reserve room for the successor signature of every state in
+      succ_signatures: state s may use the entries from
+      succ_signature_offsets[s] up to succ_signature_offsets[s + 1].
+    */
+    vector<size_t> succ_signature_offsets(num_states + 1, 0);
+    for (GroupAndTransitions gat : ts) {
+        for (const Transition &transition : gat.transitions) {
+            ++succ_signature_offsets[transition.src + 1];
         }
-        Signature signature(h, ts.is_goal_state(state),
-                            state_to_group[state], SuccessorSignature(),
-                            state);
-        signatures.push_back(signature);
     }
-    signatures.push_back(Signature(SENTINEL, false, -1, SuccessorSignature(), -1));
+    partial_sum(succ_signature_offsets.begin(), succ_signature_offsets.end(),
+                succ_signature_offsets.begin());
+    succ_signatures.resize(succ_signature_offsets.back());
+    vector<size_t> succ_signature_ends(
+        succ_signature_offsets.begin(), succ_signature_offsets.end() - 1);
 
     // Step 2: Add transition information.
     int label_group_counter = 0;
@@ -188,9 +213,7 @@ void ShrinkBisimulation::compute_signatures(
     */
     for (GroupAndTransitions gat : ts) {
         const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
-        for (const Transition &transition : transitions) {
-            assert(signatures[transition.src + 1].state == transition.src);
+        for (const Transition &transition : gat.transitions) {
             bool skip_transition = false;
             if (greedy) {
                 int src_h = distances.get_goal_distance(transition.src);
@@ -207,8 +230,8 @@ void ShrinkBisimulation::compute_signatures(
             if (!skip_transition) {
                 int target_group = state_to_group[transition.target];
                 assert(target_group != -1 && target_group != SENTINEL);
-                signatures[transition.src + 1].succ_signature.push_back(
-                    make_pair(label_group_counter, target_group));
+                succ_signatures[succ_signature_ends[transition.src]++] =
+                    make_pair(label_group_counter, target_group);
             }
         }
         ++label_group_counter;
@@ -229,12 +252,25 @@ void ShrinkBisimulation::compute_signatures(
           bisimulation round.
      */
 
-    for (size_t i = 0; i < signatures.size(); ++i) {
-        SuccessorSignature &succ_sig = signatures[i].succ_signature;
-        ::sort(succ_sig.begin(), succ_sig.end());
-        succ_sig.erase(::unique(succ_sig.begin(), succ_sig.end()),
-                       succ_sig.end());
+    signatures.push_back(Signature(-2, false, -1, nullptr, nullptr, -1));
+    for (int state = 0; state < num_states; ++state) {
+        SuccessorSignatureEntry *succ_sig_begin =
+            succ_signatures.data() + succ_signature_offsets[state];
+        SuccessorSignatureEntry *succ_sig_end =
+            succ_signatures.data() + succ_signature_ends[state];
+        ::sort(succ_sig_begin, succ_sig_end);
+        succ_sig_end = ::unique(succ_sig_begin, succ_sig_end);
+
+        int h = distances.get_goal_distance(state);
+        if (h == INF) {
+            h = IRRELEVANT;
+        }
+        signatures.push_back(
+            Signature(h, ts.is_goal_state(state), state_to_group[state],
+                      succ_sig_begin, succ_sig_end, state));
     }
+    signatures.push_back(
+        Signature(SENTINEL, false, -1, nullptr, nullptr, -1));
 
     ::sort(signatures.begin(), signatures.end());
 }
@@ -250,6 +286,8 @@ StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
     vector<int> state_to_group(num_states);
     vector<Signature> signatures;
     signatures.reserve(num_states + 2);
+    // Successor signatures of all states, reused in every iteration.
+    vector<SuccessorSignatureEntry> succ_signatures;
 
     int num_groups = initialize_groups(ts, distances, state_to_group);
     // log << "number of initial groups: " << num_groups << endl;
@@ -263,7 +301,8 @@ StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
         stable = true;
 
         signatures.clear();
-        compute_signatures(ts, distances, signatures, state_to_group);
+        compute_signatures(
+            ts, distances, signatures, succ_signatures, state_to_group);
 
         // Verify size of signatures and presence of sentinels.
         assert(static_cast<int>(signatures.size()) == num_states + 2);
@@ -298,7 +337,7 @@ StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
                 if (prev_sig.group != curr_sig.group) {
                     ++num_old_groups;
                     ++num_new_groups;
-                } else if (prev_sig.succ_signature != curr_sig.succ_signature) {
+                } else if (!prev_sig.has_same_succ_signature(curr_sig)) {
                     ++num_new_groups;
                 }
             }
@@ -324,8 +363,7 @@ StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
                     if (prev_sig.group != curr_sig.group) {
                         // Start first group of a block; keep old group no.
                         new_group_no = curr_sig.group;
-                    } else if (prev_sig.succ_signature
-                               != curr_sig.succ_signature) {
+                    } else if (!prev_sig.has_same_succ_signature(curr_sig)) {
                         new_group_no = num_groups++;
                         assert(num_groups <= target_size);
                     }
@@ -346,6 +384,7 @@ StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
        relation since this is one of the code parts relevant to peak
        memory. */
     utils::release_vector_memory(signatures);
+    utils::release_vector_memory(succ_signatures);
 
     // Generate final result.
     StateEquivalenceRelation equivalence_relation;
@@ -13,7 +13,6 @@
 #include <cassert>
 #include <iostream>
 #include <iterator>
-#include <set>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -28,18 +27,24 @@ ostream &operator<<(ostream &os, const Transition &trans) {
     return os;
 }
 
-// Sorts the given set of transitions and removes duplicates.
-static void normalize_given_transitions(vector<Transition> &transitions) {
-    sort(transitions.begin(), transitions.end());
-    transitions.erase(unique(transitions.begin(), transitions.end()), transitions.end());
+/*
+  Sorts the given range of transitions and moves duplicates to its end.
+  Returns the end of the range without duplicates.
+*/
+static vector<Transition>::iterator normalize_given_transitions(
+    vector<Transition>::iterator begin, vector<Transition>::iterator end) {
+    sort(begin, end);
+    return unique(begin, end);
 }
 
 TSConstIterator::TSConstIterator(
     const LabelEquivalenceRelation &label_equivalence_relation,
-    const vector<vector<Transition>> &transitions_by_group_id,
+    const vector<Transition> &transitions,
+    const vector<size_t> &group_offsets,
     bool end)
     : label_equivalence_relation(label_equivalence_relation),
-      transitions_by_group_id(transitions_by_group_id),
+      transitions(transitions),
+      group_offsets(group_offsets),
       current_group_id((end ? label_equivalence_relation.get_size() : 0)) {
     next_valid_index();
 }
@@ -59,7 +64,9 @@ void TSConstIterator::operator++() {
 GroupAndTransitions TSConstIterator::operator*() const {
     return GroupAndTransitions(
         label_equivalence_relation.get_group(current_group_id),
-        transitions_by_group_id[current_group_id]);
+        TransitionRange(
+            transitions.data() + group_offsets[current_group_id],
+            transitions.data() + group_offsets[current_group_id + 1]));
 }
 
 
@@ -89,7 +96,40 @@ TransitionSystem::TransitionSystem(
     : num_variables(num_variables),
       incorporated_variables(move(incorporated_variables)),
       label_equivalence_relation(move(label_equivalence_relation)),
-      transitions_by_group_id(move(transitions_by_group_id)),
+      num_states(num_states),
+      goal_states(move(goal_states)),
+      init_state(init_state) {
+    size_t num_transitions = 0;
+    for (const vector<Transition> &group_transitions : transitions_by_group_id) {
+        num_transitions += group_transitions.size();
+    }
+    transitions.reserve(num_transitions);
+    group_offsets.reserve(transitions_by_group_id.size() + 1);
+    group_offsets.push_back(0);
+    for (vector<Transition> &group_transitions : transitions_by_group_id) {
+        transitions.insert(
+            transitions.end(), group_transitions.begin(), group_transitions.end());
+        group_offsets.push_back(transitions.size());
+        utils::release_vector_memory(group_transitions);
+    }
+    assert(are_transitions_sorted_unique());
+    assert(in_sync_with_label_equivalence_relation());
+}
+
+TransitionSystem::TransitionSystem(
+    int num_variables,
+    vector<int> &&incorporated_variables,
+    unique_ptr<LabelEquivalenceRelation> &&label_equivalence_relation,
+    vector<Transition> &&transitions,
+    vector<size_t> &&group_offsets,
+    int num_states,
+    vector<bool> &&goal_states,
+    int init_state)
+    : num_variables(num_variables),
+      incorporated_variables(move(incorporated_variables)),
+      label_equivalence_relation(move(label_equivalence_relation)),
+      transitions(move(transitions)),
+      group_offsets(move(group_offsets)),
       num_states(num_states),
       goal_states(move(goal_states)),
       init_state(init_state) {
@@ -103,7 +143,8 @@ TransitionSystem::TransitionSystem(const TransitionSystem &other)
       label_equivalence_relation(
           utils::make_unique_ptr<LabelEquivalenceRelation>(
               *other.label_equivalence_relation)),
-      transitions_by_group_id(other.transitions_by_group_id),
+      transitions(other.transitions),
+      group_offsets(other.group_offsets),
       num_states(other.num_states),
       goal_states(other.goal_states),
       init_state(other.init_state) {
@@ -132,8 +173,7 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
         ts2.incorporated_variables.begin(), ts2.incorporated_variables.end(),
         back_inserter(incorporated_variables));
     vector<vector<int>> label_groups;
-    vector<vector<Transition>> transitions_by_group_id;
-    transitions_by_group_id.reserve(labels.get_max_size());
+    label_groups.reserve(labels.get_max_size());
 
     int ts1_size = ts1.get_size();
     int ts2_size = ts2.get_size();
@@ -161,11 +201,14 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
           l is dead in T1 only and l' is dead in T2 only, so they are not
           locally equivalent in either of the components).
     */
-    int multiplier = ts2_size;
-    vector<int> dead_labels;
+    struct ProductGroup {
+        TransitionRange transitions1;
+        TransitionRange transitions2;
+        vector<int> labels;
+    };
+    vector<ProductGroup> product_groups;
     for (GroupAndTransitions gat : ts1) {
         const LabelGroup &group1 = gat.label_group;
-        const vector<Transition> &transitions1 = gat.transitions;
 
         // Distribute the labels of this group among the "buckets"
         // corresponding to the groups of ts2.
@@ -176,41 +219,62 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
         }
         // Now buckets contains all equivalence classes that are
         // refinements of group1.
-
-        // Now create the new groups together with their transitions.
         for (auto &bucket : buckets) {
-            const vector<Transition> &transitions2 =
-                ts2.get_transitions_for_group_id(bucket.first);
-
-            // Create the new transitions for this bucket
-            vector<Transition> new_transitions;
-            if (!transitions1.empty() && !transitions2.empty()
-                && transitions1.size() > new_transitions.max_size() / transitions2.size())
-                utils::exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
-            new_transitions.reserve(transitions1.size() * transitions2.size());
-            for (const Transition &transition1 : transitions1) {
-                int src1 = transition1.src;
-                int target1 = transition1.target;
-                for (const Transition &transition2 : transitions2) {
-                    int src2 = transition2.src;
-                    int target2 = transition2.target;
-                    int src = src1 * multiplier + src2;
-                    int target = target1 * multiplier + target2;
-                    new_transitions.push_back(Transition(src, target));
-                }
-            }
+            product_groups.push_back(
+                {gat.transitions,
+                 ts2.get_transitions_for_group_id(bucket.first),
+                 move(bucket.second)});
+        }
+    }
+
+    /*
+      Compute the number of transitions of the product first, so that we
+      can allocate the transition array once with the exact size.
+    */
+    size_t num_transitions = 0;
+    size_t max_transitions = vector<Transition>().max_size();
+    for (const ProductGroup &product_group : product_groups) {
+        size_t size1 = product_group.transitions1.size();
+        size_t size2 = product_group.transitions2.size();
+        if (size1 && size2 && (size1 > max_transitions / size2 ||
+                               size1 * size2 > max_transitions - num_transitions))
+            utils::exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
+        num_transitions += size1 * size2;
+    }
+    vector<Transition> transitions;
+    transitions.reserve(num_transitions);
+    vector<size_t> group_offsets;
+    group_offsets.reserve(product_groups.size() + 2);
+    group_offsets.push_back(0);
 
-            // Create a new group if the transitions are not empty
-            vector<int> &new_labels = bucket.second;
-            if (new_transitions.empty()) {
-                dead_labels.insert(dead_labels.end(), new_labels.begin(), new_labels.end());
-            } else {
-                sort(new_transitions.begin(), new_transitions.end());
-                label_groups.push_back(move(new_labels));
-                transitions_by_group_id.push_back(move(new_transitions));
+    // Now create the new groups together with their transitions.
+    int multiplier = ts2_size;
+    vector<int> dead_labels;
+    for (ProductGroup &product_group : product_groups) {
+        size_t group_begin = transitions.size();
+        for (const Transition &transition1 : product_group.transitions1) {
+            int src1 = transition1.src;
+            int target1 = transition1.target;
+            for (const Transition &transition2 : product_group.transitions2) {
+                int src2 = transition2.src;
+                int target2 = transition2.target;
+                int src = src1 * multiplier + src2;
+                int target = target1 * multiplier + target2;
+                transitions.push_back(Transition(src, target));
             }
         }
+
+        // Create a new group if the transitions are not empty
+        vector<int> &new_labels = product_group.labels;
+        if (transitions.size() == group_begin) {
+            dead_labels.insert(dead_labels.end(), new_labels.begin(), new_labels.end());
+        } else {
+            sort(transitions.begin() + group_begin, transitions.end());
+            label_groups.push_back(move(new_labels));
+            group_offsets.push_back(transitions.size());
+        }
     }
+    assert(transitions.size() == num_transitions);
 
     /*
       We collect all dead labels separately, because the bucket refining
@@ -222,10 +286,10 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
     if (!dead_labels.empty()) {
         label_groups.push_back(move(dead_labels));
         // Dead labels have empty transitions
-        transitions_by_group_id.emplace_back();
+        group_offsets.push_back(transitions.size());
     }
 
-    assert(transitions_by_group_id.size() == label_groups.size());
+    assert(group_offsets.size() == label_groups.size() + 1);
 
     unique_ptr<LabelEquivalenceRelation> label_equivalence_relation =
         utils::make_unique_ptr<LabelEquivalenceRelation>(labels, label_groups);
@@ -234,7 +298,8 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
         num_variables,
         move(incorporated_variables),
         move(label_equivalence_relation),
-        move(transitions_by_group_id),
+        move(transitions),
+        move(group_offsets),
         num_states,
         move(goal_states),
         init_state
@@ -246,23 +311,54 @@ void TransitionSystem::compute_locally_equivalent_labels() {
       Compare every group of labels and their transitions to all others and
       merge two groups whenever the transitions are the same.
     */
+    bool merged_groups = false;
     for (int group_id1 = 0; group_id1 < label_equivalence_relation->get_size();
          ++group_id1) {
         if (!label_equivalence_relation->is_empty_group(group_id1)) {
-            const vector<Transition> &transitions1 = transitions_by_group_id[group_id1];
+            TransitionRange transitions1 = get_transitions_for_group_id(group_id1);
             for (int group_id2 = group_id1 + 1;
                  group_id2 < label_equivalence_relation->get_size(); ++group_id2) {
                 if (!label_equivalence_relation->is_empty_group(group_id2)) {
-                    vector<Transition> &transitions2 = transitions_by_group_id[group_id2];
-                    if (transitions1 == transitions2) {
+                    TransitionRange transitions2 = get_transitions_for_group_id(group_id2);
+                    if (transitions1.size() == transitions2.size() &&
+                        equal(transitions1.begin(), transitions1.end(),
+                              transitions2.begin())) {
                         label_equivalence_relation->move_group_into_group(
                             group_id2, group_id1);
-                        utils::release_vector_memory(transitions2);
+                        merged_groups = true;
                     }
                 }
             }
         }
     }
+    if (merged_groups) {
+        remove_transitions_of_empty_groups();
+    }
+}
+
+void TransitionSystem::remove_transitions_of_empty_groups() {
+    /*
+      Move the transitions of all non-empty groups to the front. Since the
+      groups keep their order, no transitions are overwritten before they
+      are moved.
+    */
+    int num_groups = label_equivalence_relation->get_size();
+    size_t num_remaining_transitions = 0;
+    size_t group_begin = 0;
+    for (int group_id = 0; group_id < num_groups; ++group_id) {
+        size_t group_end = group_offsets[group_id + 1];
+        group_offsets[group_id] = num_remaining_transitions;
+        if (!label_equivalence_relation->is_empty_group(group_id)) {
+            move(transitions.begin() + group_begin,
+                 transitions.begin() + group_end,
+                 transitions.begin() + num_remaining_transitions);
+            num_remaining_transitions += group_end - group_begin;
+        }
+        group_begin = group_end;
+    }
+    group_offsets[num_groups] = num_remaining_transitions;
+    transitions.erase(
+        transitions.begin() + num_remaining_transitions, transitions.end());
 }
 
 void TransitionSystem::apply_abstraction(
@@ -294,31 +390,32 @@ void TransitionSystem::apply_abstraction(
     }
     goal_states = move(new_goal_states);
 
-    // Update all transitions.
-    for (vector<Transition> &transitions : transitions_by_group_id) {
-        if (!transitions.empty()) {
-            vector<Transition> new_transitions;
-            /*
-              We reserve more memory than necessary here, but this is better
-              than potentially resizing the vector several times when inserting
-              transitions one after the other. See issue604-v6.
-
-              An alternative could be to not use a new vector, but to modify
-              the existing transitions inplace, and to remove all empty
-              positions in the end. This would be more ugly, though.
-            */
-            new_transitions.reserve(transitions.size());
-            for (size_t i = 0; i < transitions.size(); ++i) {
-                const Transition &transition = transitions[i];
-                int src = abstraction_mapping[transition.src];
-                int target = abstraction_mapping[transition.target];
-                if (src != PRUNED_STATE && target != PRUNED_STATE)
-                    new_transitions.push_back(Transition(src, target));
-            }
-            normalize_given_transitions(new_transitions);
-            transitions = move(new_transitions);
+    /*
+      Update all transitions in place. The transitions of every group only
+      shrink, so we can write the new transitions of a group to the front
+      of the array without overwriting transitions we have not read yet.
+    */
+    int num_groups = label_equivalence_relation->get_size();
+    size_t num_new_transitions = 0;
+    size_t group_begin = 0;
+    for (int group_id = 0; group_id < num_groups; ++group_id) {
+        size_t group_end = group_offsets[group_id + 1];
+        size_t new_group_begin = num_new_transitions;
+        for (size_t i = group_begin; i < group_end; ++i) {
+            Transition transition = transitions[i];
+            int src = abstraction_mapping[transition.src];
+            int target = abstraction_mapping[transition.target];
+            if (src != PRUNED_STATE && target != PRUNED_STATE)
+                transitions[num_new_transitions++] = Transition(src, target);
         }
+        num_new_transitions = normalize_given_transitions(
+            transitions.begin() + new_group_begin,
+            transitions.begin() + num_new_transitions) - transitions.begin();
+        group_offsets[group_id] = new_group_begin;
+        group_begin = group_end;
     }
+    group_offsets[num_groups] = num_new_transitions;
+    transitions.erase(transitions.begin() + num_new_transitions, transitions.end());
 
     compute_locally_equivalent_labels();
 
@@ -379,17 +476,23 @@ void TransitionSystem::apply_label_reduction(
             const vector<int> &old_label_nos = mapping.second;
             assert(old_label_nos.size() >= 2);
             unordered_set<int> seen_group_ids;
-            set<Transition> new_label_transitions;
+            vector<Transition> new_label_transitions;
             for (int old_label_no : old_label_nos) {
                 int group_id = label_equivalence_relation->get_group_id(old_label_no);
                 if (seen_group_ids.insert(group_id).second) {
                     affected_group_ids.insert(group_id);
-                    const vector<Transition> &transitions = transitions_by_group_id[group_id];
-                    new_label_transitions.insert(transitions.begin(), transitions.end());
+                    TransitionRange group_transitions =
+                        get_transitions_for_group_id(group_id);
+                    new_label_transitions.insert(
+                        new_label_transitions.end(),
+                        group_transitions.begin(), group_transitions.end());
                 }
             }
-            new_transitions.emplace_back(
-                new_label_transitions.begin(), new_label_transitions.end());
+            new_label_transitions.erase(
+                normalize_given_transitions(
+                    new_label_transitions.begin(), new_label_transitions.end()),
+                new_label_transitions.end());
+            new_transitions.push_back(move(new_label_transitions));
         }
         assert(label_mapping.size() == new_transitions.size());
 
@@ -407,23 +510,22 @@ void TransitionSystem::apply_label_reduction(
           position.
 
           NOTE: it is important that this happens in increasing order of label
-          numbers to ensure that transitions_by_group_id are synchronized with
-          label groups of label_equivalence_relation.
+          numbers to ensure that group_offsets are synchronized with label
+          groups of label_equivalence_relation.
         */
         for (size_t i = 0; i < label_mapping.size(); ++i) {
-            vector<Transition> &transitions = new_transitions[i];
+            const vector<Transition> &new_label_transitions = new_transitions[i];
             assert(label_equivalence_relation->get_group_id(label_mapping[i].first)
-                   == static_cast<int>(transitions_by_group_id.size()));
-            transitions_by_group_id.push_back(move(transitions));
+                   == static_cast<int>(group_offsets.size()) - 1);
+            transitions.insert(
+                transitions.end(),
+                new_label_transitions.begin(), new_label_transitions.end());
+            group_offsets.push_back(transitions.size());
         }
+        utils::release_vector_memory(new_transitions);
 
-        // Go over all affected group IDs and remove their transitions if the
-        // group is empty.
-        for (int group_id : affected_group_ids) {
-            if (label_equivalence_relation->is_empty_group(group_id)) {
-                utils::release_vector_memory(transitions_by_group_id[group_id]);
-            }
-        }
+        // Remove the transitions of affected groups that became empty.
+        remove_transitions_of_empty_groups();
 
         compute_locally_equivalent_labels();
     }
@@ -440,15 +542,28 @@ string TransitionSystem::tag() const {
 
 bool TransitionSystem::are_transitions_sorted_unique() const {
     for (GroupAndTransitions gat : *this) {
-        if (!utils::is_sorted_unique(gat.transitions))
-            return false;
+        const TransitionRange &group_transitions = gat.transitions;
+        for (size_t i = 1; i < group_transitions.size(); ++i) {
+            if (group_transitions[i - 1] >= group_transitions[i])
+                return false;
+        }
     }
     return true;
 }
 
 bool TransitionSystem::in_sync_with_label_equivalence_relation() const {
-    return label_equivalence_relation->get_size() ==
-           static_cast<int>(transitions_by_group_id.size());
+    int num_groups = label_equivalence_relation->get_size();
+    if (static_cast<int>(group_offsets.size()) != num_groups + 1 ||
+        group_offsets.back() != transitions.size()) {
+        return false;
+    }
+    for (int group_id = 0; group_id < num_groups; ++group_id) {
+        if (label_equivalence_relation->is_empty_group(group_id) &&
+            group_offsets[group_id] != group_offsets[group_id + 1]) {
+            return false;
+        }
+    }
+    return true;
 }
 
 bool TransitionSystem::is_solvable(const Distances &distances) const {
@@ -462,11 +577,8 @@ bool TransitionSystem::is_solvable(const Distances &distances) const {
 }
 
 int TransitionSystem::compute_total_transitions() const {
-    int total = 0;
-    for (GroupAndTransitions gat : *this) {
-        total += gat.transitions.size();
-    }
-    return total;
+    // Empty groups have no transitions.
+    return transitions.size();
 }
 
 string TransitionSystem::get_description() const {
@@ -498,8 +610,7 @@ void TransitionSystem::dump_dot_graph(utils::LogProxy &log) const {
         }
         for (GroupAndTransitions gat : *this) {
             const LabelGroup &label_group = gat.label_group;
-            const vector<Transition> &transitions = gat.transitions;
-            for (const Transition &transition : transitions) {
+            for (const Transition &transition : gat.transitions) {
                 int src = transition.src;
                 int target = transition.target;
                 log << "    node" << src << " -> node" << target << " [label = ";
@@ -531,10 +642,10 @@ void TransitionSystem::dump_labels_and_transitions(utils::LogProxy &log) const {
             }
             log << endl;
             log << "transitions: ";
-            const vector<Transition> &transitions = gat.transitions;
-            for (size_t i = 0; i < transitions.size(); ++i) {
-                int src = transitions[i].src;
-                int target = transitions[i].target;
+            const TransitionRange &group_transitions = gat.transitions;
+            for (size_t i = 0; i < group_transitions.size(); ++i) {
+                int src = group_transitions[i].src;
+                int target = group_transitions[i].target;
                 if (i != 0)
                     log << ",";
                 log << src << " -> " << target;
@@ -41,11 +41,45 @@ struct Transition {
     }
 };
 
+/*
+  The transitions of one label group. They are stored contiguously in the
+  transition array of the transition system, so this is only a view that
+  becomes invalid when the transition system is modified.
+*/
+class TransitionRange {
+    const Transition *begin_;
+    const Transition *end_;
+public:
+    TransitionRange(const Transition *begin, const Transition *end)
+        : begin_(begin), end_(end) {
+    }
+
+    const Transition *begin() const {
+        return begin_;
+    }
+
+    const Transition *end() const {
+        return end_;
+    }
+
+    std::size_t size() const {
+        return end_ - begin_;
+    }
+
+    bool empty() const {
+        return begin_ == end_;
+    }
+
+    const Transition &operator[](std::size_t index) const {
+        return begin_[index];
+    }
+};
+
 struct GroupAndTransitions {
     const LabelGroup &label_group;
-    const std::vector<Transition> &transitions;
+    const TransitionRange transitions;
     GroupAndTransitions(const LabelGroup &label_group,
-                        const std::vector<Transition> &transitions)
+                        const TransitionRange &transitions)
         : label_group(label_group),
           transitions(transitions) {
     }
@@ -59,14 +93,16 @@ class TSConstIterator {
       easily exchanged.
     */
     const LabelEquivalenceRelation &label_equivalence_relation;
-    const std::vector<std::vector<Transition>> &transitions_by_group_id;
+    const std::vector<Transition> &transitions;
+    const std::vector<std::size_t> &group_offsets;
     // current_group_id is the actual iterator
     int current_group_id;
 
     void next_valid_index();
 public:
     TSConstIterator(const LabelEquivalenceRelation &label_equivalence_relation,
-                    const std::vector<std::vector<Transition>> &transitions_by_group_id,
+                    const std::vector<Transition> &transitions,
+                    const std::vector<std::size_t> &group_offsets,
                     bool end);
     void operator++();
     GroupAndTransitions operator*() const;
@@ -104,17 +140,18 @@ private:
     std::unique_ptr<LabelEquivalenceRelation> label_equivalence_relation;
 
     /*
-      The transitions of a label group are indexed via its ID. The ID of a
-      group does not change, and hence its transitions are never moved.
-
-      We tested different alternatives to store the transitions, but they all
-      performed worse: storing a vector transitions in the label group increases
-      memory usage and runtime; storing the transitions more compactly and
-      incrementally increasing the size of transitions_of_groups whenever a
-      new label group is added also increases runtime. See also issue492 and
-      issue521.
+      The transitions of all label groups in compressed sparse row format:
+      the transitions of the group with ID g are
+      transitions[group_offsets[g]], ..., transitions[group_offsets[g + 1] - 1],
+      sorted by source and target. Empty groups have no transitions. The ID
+      of a group does not change.
+
+      Compared to one vector per group, this needs one allocation instead of
+      one per group, and abstractions and label mappings can be applied in
+      place by compacting the array from left to right.
     */
-    std::vector<std::vector<Transition>> transitions_by_group_id;
+    std::vector<Transition> transitions;
+    std::vector<std::size_t> group_offsets;
 
     int num_states;
     std::vector<bool> goal_states;
@@ -126,8 +163,13 @@ private:
     */
     void compute_locally_equivalent_labels();
 
-    const std::vector<Transition> &get_transitions_for_group_id(int group_id) const {
-        return transitions_by_group_id[group_id];
+    // Remove the transitions of groups that have become empty.
+    void remove_transitions_of_empty_groups();
+
+    TransitionRange get_transitions_for_group_id(int group_id) const {
+        return TransitionRange(
+            transitions.data() + group_offsets[group_id],
+            transitions.data() + group_offsets[group_id + 1]);
     }
 
     // Statistics and output
@@ -142,6 +184,15 @@ public:
         int num_states,
         std::vector<bool> &&goal_states,
         int init_state);
+    TransitionSystem(
+        int num_variables,
+        std::vector<int> &&incorporated_variables,
+        std::unique_ptr<LabelEquivalenceRelation> &&label_equivalence_relation,
+        std::vector<Transition> &&transitions,
+        std::vector<std::size_t> &&group_offsets,
+        int num_states,
+        std::vector<bool> &&goal_states,
+        int init_state);
     TransitionSystem(const TransitionSystem &other);
     ~TransitionSystem();
     /*
@@ -179,13 +230,15 @@ public:
 
     TSConstIterator begin() const {
         return TSConstIterator(*label_equivalence_relation,
-                               transitions_by_group_id,
+                               transitions,
+                               group_offsets,
                                false);
     }
 
     TSConstIterator end() const {
         return TSConstIterator(*label_equivalence_relation,
-                               transitions_by_group_id,
+                               transitions,
+                               group_offsets,
                                true);
     }
 
@@ -0,0 +1,261 @@
+#include "bucket_open_list.h"
+
+#include "../evaluator.h"
+#include "../open_list.h"
+#include "../option_parser.h"
+#include "../plugin.h"
+
+#include "../utils/memory.h"
+
+#include <cassert>
+#include <deque>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+namespace bucket_open_list {
+static const int INF = numeric_limits<int>::max();
+
+/*
+  Array of buckets indexed by non-negative keys with an extra bucket for
+  the key infinity. We remember a lower bound on the smallest key of a
+  non-empty bucket, so we never scan buckets below it.
+*/
+template<class Bucket>
+class BucketArray {
+    vector<Bucket> buckets;
+    Bucket infinite_bucket;
+    int min_key;
+public:
+    BucketArray()
+        : min_key(0) {
+    }
+
+    Bucket &get_bucket(int key) {
+        assert(key >= 0);
+        if (key == INF) {
+            return infinite_bucket;
+        }
+        if (key >= static_cast<int>(buckets.size())) {
+            buckets.resize(key + 1);
+        }
+        if (key < min_key) {
+            min_key = key;
+        }
+        return buckets[key];
+    }
+
+    // The array must contain a non-empty bucket.
+    Bucket &get_min_bucket() {
+        int num_buckets = buckets.size();
+        while (min_key < num_buckets && buckets[min_key].empty()) {
+            ++min_key;
+        }
+        if (min_key == num_buckets) {
+            assert(!infinite_bucket.empty());
+            return infinite_bucket;
+        }
+        return buckets[min_key];
+    }
+
+    void clear() {
+        buckets.clear();
+        infinite_bucket.clear();
+        min_key = 0;
+    }
+};
+
+template<class Entry>
+class BucketOpenList : public OpenList<Entry> {
+    using Bucket = deque<Entry>;
+
+    /*
+      All entries with the same value of the first evaluator, indexed by
+      the value of the second evaluator.
+    */
+    struct Layer {
+        BucketArray<Bucket> buckets;
+        int size = 0;
+
+        bool empty() const {
+            return size == 0;
+        }
+
+        void clear() {
+            buckets.clear();
+            size = 0;
+        }
+    };
+
+    BucketArray<Layer> layers;
+    int size;
+
+    shared_ptr<Evaluator> primary_evaluator;
+    shared_ptr<Evaluator> secondary_evaluator;
+    // If true, entries with equal keys are removed in LIFO order, else FIFO.
+    bool lifo;
+    /*
+      If allow_unsafe_pruning is true, we ignore (don't insert) states
+      which the primary evaluator considers a dead end, even if it is
+      not a safe heuristic.
+    */
+    bool allow_unsafe_pruning;
+
+protected:
+    virtual void do_insertion(EvaluationContext &eval_context,
+                              const Entry &entry) override;
+
+public:
+    explicit BucketOpenList(const Options &opts);
+    virtual ~BucketOpenList() override = default;
+
+    virtual Entry remove_min() override;
+    virtual bool empty() const override;
+    virtual void clear() override;
+    virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual bool is_dead_end(
+        EvaluationContext &eval_context) const override;
+    virtual bool is_reliable_dead_end(
+        EvaluationContext &eval_context) const override;
+};
+
+
+template<class Entry>
+BucketOpenList<Entry>::BucketOpenList(const Options &opts)
+    : OpenList<Entry>(opts.get<bool>("pref_only")),
+      size(0),
+      primary_evaluator(opts.get_list<shared_ptr<Evaluator>>("evals")[0]),
+      secondary_evaluator(opts.get_list<shared_ptr<Evaluator>>("evals")[1]),
+      lifo(opts.get<bool>("lifo")),
+      allow_unsafe_pruning(opts.get<bool>("unsafe_pruning")) {
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::do_insertion(
+    EvaluationContext &eval_context, const Entry &entry) {
+    int primary_key = eval_context.get_evaluator_value_or_infinity(
+        primary_evaluator.get());
+    int secondary_key = eval_context.get_evaluator_value_or_infinity(
+        secondary_evaluator.get());
+    Layer &layer = layers.get_bucket(primary_key);
+    layer.buckets.get_bucket(secondary_key).push_back(entry);
+    ++layer.size;
+    ++size;
+}
+
+template<class Entry>
+Entry BucketOpenList<Entry>::remove_min() {
+    assert(size > 0);
+    Layer &layer = layers.get_min_bucket();
+    Bucket &bucket = layer.buckets.get_min_bucket();
+    assert(!bucket.empty());
+    Entry result = lifo ? bucket.back() : bucket.front();
+    if (lifo)
+        bucket.pop_back();
+    else
+        bucket.pop_front();
+    --layer.size;
+    --size;
+    return result;
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::empty() const {
+    return size == 0;
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::clear() {
+    layers.clear();
+    size = 0;
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::get_path_dependent_evaluators(
+    set<Evaluator *> &evals) {
+    primary_evaluator->get_path_dependent_evaluators(evals);
+    secondary_evaluator->get_path_dependent_evaluators(evals);
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::is_dead_end(
+    EvaluationContext &eval_context) const {
+    // Same semantics as for the tie-breaking open list.
+    if (is_reliable_dead_end(eval_context))
+        return true;
+    bool primary_is_infinite =
+        eval_context.is_evaluator_value_infinite(primary_evaluator.get());
+    if (allow_unsafe_pruning && primary_is_infinite)
+        return true;
+    return primary_is_infinite &&
+           eval_context.is_evaluator_value_infinite(secondary_evaluator.get());
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::is_reliable_dead_end(
+    EvaluationContext &eval_context) const {
+    for (Evaluator *evaluator :
+         {primary_evaluator.get(), secondary_evaluator.get()})
+        if (eval_context.is_evaluator_value_infinite(evaluator) &&
+            evaluator->dead_ends_are_reliable())
+            return true;
+    return false;
+}
+
+BucketOpenListFactory::BucketOpenListFactory(const Options &options)
+    : options(options) {
+}
+
+unique_ptr<StateOpenList>
+BucketOpenListFactory::create_state_open_list() {
+    return utils::make_unique_ptr<BucketOpenList<StateOpenListEntry>>(options);
+}
+
+unique_ptr<EdgeOpenList>
+BucketOpenListFactory::create_edge_open_list() {
+    return utils::make_unique_ptr<BucketOpenList<EdgeOpenListEntry>>(options);
+}
+
+static shared_ptr<OpenListFactory> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Bucket-based tie-breaking open list",
+        "Orders entries like the tie-breaking open list with two evaluators, "
+        "but stores them in an array of buckets indexed by the value of the "
+        "first evaluator, each of which is an array of buckets indexed by the "
+        "value of the second evaluator.");
+    parser.document_note(
+        "Evaluator values",
+        "Both evaluators must only produce non-negative values, e.g. g, h "
+        "and g + h. Memory usage grows with the largest finite value of "
+        "each evaluator, so this open list is only suited for tasks with "
+        "small operator costs.");
+    parser.add_list_option<shared_ptr<Evaluator>>(
+        "evals",
+        "two evaluators: entries are ordered by the first evaluator "
+        "and ties are broken by the second one");
+    parser.add_option<bool>(
+        "pref_only",
+        "insert only nodes generated by preferred operators", "false");
+    parser.add_option<bool>(
+        "unsafe_pruning",
+        "allow unsafe pruning when the main evaluator regards a state a dead end",
+        "true");
+    parser.add_option<bool>(
+        "lifo",
+        "remove entries with equal evaluator values in last-in-first-out "
+        "order instead of first-in-first-out order",
+        "false");
+    Options opts = parser.parse();
+    if (!parser.help_mode() &&
+        opts.get_list<shared_ptr<Evaluator>>("evals").size() != 2) {
+        parser.error("bucket open list needs exactly two evaluators");
+    }
+    if (parser.dry_run())
+        return nullptr;
+    else
+        return make_shared<BucketOpenListFactory>(opts);
+}
+
+static Plugin<OpenListFactory> _plugin("bucket_tiebreaking", _parse);
+}
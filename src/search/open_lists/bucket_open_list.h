@@ -0,0 +1,28 @@
+#ifndef OPEN_LISTS_BUCKET_OPEN_LIST_H
+#define OPEN_LISTS_BUCKET_OPEN_LIST_H
+
+#include "../open_list_factory.h"
+#include "../option_parser_util.h"
+
+/*
+  Open list for two integer-valued evaluators (typically f and h) that
+  breaks ties like the tie-breaking open list, but stores its entries in
+  a two-level array of buckets indexed by the first and then by the
+  second evaluator value instead of a map. This makes insertion and
+  removal constant-time operations (amortized over the values skipped
+  when searching for the next non-empty bucket).
+*/
+
+namespace bucket_open_list {
+class BucketOpenListFactory : public OpenListFactory {
+    Options options;
+public:
+    explicit BucketOpenListFactory(const Options &options);
+    virtual ~BucketOpenListFactory() override = default;
+
+    virtual std::unique_ptr<StateOpenList> create_state_open_list() override;
+    virtual std::unique_ptr<EdgeOpenList> create_edge_open_list() override;
+};
+}
+
+#endif
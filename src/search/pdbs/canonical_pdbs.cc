@@ -41,4 +41,37 @@ int CanonicalPDBs::get_value(const State &state) const {
     }
     return max_h;
 }
+
+void CanonicalPDBs::get_values(
+    const vector<const int *> &states, vector<int> &values) const {
+    assert(!pattern_cliques->empty());
+    int num_states = states.size();
+    vector<vector<int>> h_values(pdbs->size());
+    for (size_t pdb_index = 0; pdb_index < pdbs->size(); ++pdb_index) {
+        (*pdbs)[pdb_index]->get_values(states, h_values[pdb_index]);
+    }
+    values.assign(num_states, 0);
+    for (int i = 0; i < num_states; ++i) {
+        bool is_dead_end = false;
+        for (const vector<int> &pdb_h_values : h_values) {
+            if (pdb_h_values[i] == numeric_limits<int>::max()) {
+                is_dead_end = true;
+                break;
+            }
+        }
+        if (is_dead_end) {
+            values[i] = numeric_limits<int>::max();
+            continue;
+        }
+        int max_h = 0;
+        for (const PatternClique &clique : *pattern_cliques) {
+            int clique_h = 0;
+            for (PatternID pdb_index : clique) {
+                clique_h += h_values[pdb_index][i];
+            }
+            max_h = max(max_h, clique_h);
+        }
+        values[i] = max_h;
+    }
+}
 }
@@ -4,6 +4,7 @@
 #include "types.h"
 
 #include <memory>
+#include <vector>
 
 class State;
 
@@ -19,6 +20,9 @@ public:
     ~CanonicalPDBs() = default;
 
     int get_value(const State &state) const;
+    // Batch version of get_value (see PatternDatabase::get_values).
+    void get_values(
+        const std::vector<const int *> &states, std::vector<int> &values) const;
 };
 }
 
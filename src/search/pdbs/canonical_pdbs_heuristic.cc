@@ -90,6 +90,23 @@ void add_canonical_pdbs_options_to_parser(options::OptionParser &parser) {
         Bounds("0.0", "infinity"));
 }
 
+void CanonicalPDBsHeuristic::compute_heuristics(
+    const vector<State> &ancestor_states, vector<int> &values) {
+    vector<int> state_values;
+    vector<const int *> states =
+        convert_states(task_proxy, ancestor_states, state_values);
+    canonical_pdbs.get_values(states, values);
+    for (int &h : values) {
+        if (h == numeric_limits<int>::max()) {
+            h = DEAD_END;
+        }
+    }
+}
+
+bool CanonicalPDBsHeuristic::supports_batch_evaluation() const {
+    return true;
+}
+
 static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_synopsis(
         "Canonical PDB",
@@ -16,10 +16,15 @@ class CanonicalPDBsHeuristic : public Heuristic {
 
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
+    virtual void compute_heuristics(
+        const std::vector<State> &ancestor_states,
+        std::vector<int> &values) override;
 
 public:
     explicit CanonicalPDBsHeuristic(const options::Options &opts);
     virtual ~CanonicalPDBsHeuristic() = default;
+
+    virtual bool supports_batch_evaluation() const override;
 };
 
 void add_canonical_pdbs_options_to_parser(options::OptionParser &parser);
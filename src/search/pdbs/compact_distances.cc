@@ -0,0 +1,88 @@
+#include "compact_distances.h"
+
+#include "../utils/collections.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace pdbs {
+template<typename Entry>
+static vector<Entry> convert_distances(const vector<int> &distances) {
+    vector<Entry> result;
+    result.reserve(distances.size());
+    for (int distance : distances) {
+        if (distance == numeric_limits<int>::max()) {
+            result.push_back(numeric_limits<Entry>::max());
+        } else {
+            result.push_back(static_cast<Entry>(distance));
+        }
+    }
+    return result;
+}
+
+template<typename Entry>
+static void lookup_entries(const Entry *entries, vector<int> &indices) {
+    for (int &index : indices) {
+        Entry distance = entries[index];
+        index = distance == numeric_limits<Entry>::max() ?
+            numeric_limits<int>::max() : distance;
+    }
+}
+
+CompactDistances::CompactDistances()
+    : entries(nullptr),
+      num_entries(0),
+      bytes_per_entry(sizeof(int)) {
+}
+
+/*
+  Moving the vectors keeps their buffers, so the entries pointer stays valid
+  when the table is moved.
+*/
+CompactDistances::CompactDistances(vector<int> &&distances)
+    : num_entries(distances.size()) {
+    int max_finite_distance = 0;
+    for (int distance : distances) {
+        if (distance != numeric_limits<int>::max()) {
+            max_finite_distance = max(max_finite_distance, distance);
+        }
+    }
+    // The largest value of each entry type is reserved for infinity.
+    if (max_finite_distance < numeric_limits<uint8_t>::max()) {
+        bytes_per_entry = 1;
+        distances_8 = convert_distances<uint8_t>(distances);
+        utils::release_vector_memory(distances);
+        entries = distances_8.data();
+    } else if (max_finite_distance < numeric_limits<uint16_t>::max()) {
+        bytes_per_entry = 2;
+        distances_16 = convert_distances<uint16_t>(distances);
+        utils::release_vector_memory(distances);
+        entries = distances_16.data();
+    } else {
+        bytes_per_entry = sizeof(int);
+        distances_32 = move(distances);
+        entries = distances_32.data();
+    }
+}
+
+CompactDistances::CompactDistances(
+    const shared_ptr<const void> &mapping, const void *entries,
+    int num_entries, int bytes_per_entry)
+    : mapping(mapping),
+      entries(entries),
+      num_entries(num_entries),
+      bytes_per_entry(bytes_per_entry) {
+}
+
+void CompactDistances::lookup(vector<int> &indices) const {
+    // Dispatch once for all indices instead of once per entry.
+    if (bytes_per_entry == 1) {
+        lookup_entries(static_cast<const uint8_t *>(entries), indices);
+    } else if (bytes_per_entry == 2) {
+        lookup_entries(static_cast<const uint16_t *>(entries), indices);
+    } else {
+        lookup_entries(static_cast<const int *>(entries), indices);
+    }
+}
+}
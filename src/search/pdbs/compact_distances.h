@@ -0,0 +1,75 @@
+#ifndef PDBS_COMPACT_DISTANCES_H
+#define PDBS_COMPACT_DISTANCES_H
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace pdbs {
+/*
+  Table of goal distances of abstract states that stores each entry with 8,
+  16 or 32 bits, depending on the largest finite distance. The largest value
+  of the entry type represents infinite distances, which are returned as
+  numeric_limits<int>::max() like in the uncompressed table.
+
+  The entries are either owned by the table or live in a memory-mapped
+  heuristic cache entry (see utils/heuristic_cache.h) that the table keeps
+  mapped.
+*/
+class CompactDistances {
+    std::vector<uint8_t> distances_8;
+    std::vector<uint16_t> distances_16;
+    std::vector<int> distances_32;
+    std::shared_ptr<const void> mapping;
+    const void *entries;
+    int num_entries;
+    int bytes_per_entry;
+
+    template<typename Entry>
+    static int decode(Entry distance) {
+        return distance == std::numeric_limits<Entry>::max() ?
+               std::numeric_limits<int>::max() : distance;
+    }
+public:
+    CompactDistances();
+    // Infinite distances must be given as numeric_limits<int>::max().
+    explicit CompactDistances(std::vector<int> &&distances);
+    // Use entries that are stored in the given mapping.
+    CompactDistances(
+        const std::shared_ptr<const void> &mapping, const void *entries,
+        int num_entries, int bytes_per_entry);
+    // Copies would refer to the entries of the original.
+    CompactDistances(const CompactDistances &) = delete;
+    CompactDistances &operator=(const CompactDistances &) = delete;
+    CompactDistances(CompactDistances &&) = default;
+    CompactDistances &operator=(CompactDistances &&) = default;
+
+    int operator[](int index) const {
+        if (bytes_per_entry == 1) {
+            return decode(static_cast<const uint8_t *>(entries)[index]);
+        } else if (bytes_per_entry == 2) {
+            return decode(static_cast<const uint16_t *>(entries)[index]);
+        } else {
+            return static_cast<const int *>(entries)[index];
+        }
+    }
+
+    // Replace each of the given indices by the entry at that index.
+    void lookup(std::vector<int> &indices) const;
+
+    int size() const {
+        return num_entries;
+    }
+
+    int get_bytes_per_entry() const {
+        return bytes_per_entry;
+    }
+
+    const void *get_entries() const {
+        return entries;
+    }
+};
+}
+
+#endif
@@ -204,7 +204,8 @@ void PatternCollectionGeneratorGenetic::evaluate(vector<double> &fitness_values)
         } else {
             /* Generate the pattern collection heuristic and get its fitness
                value. */
-            ZeroOnePDBs zero_one_pdbs(task_proxy, *pattern_collection);
+            ZeroOnePDBs zero_one_pdbs(
+                task_proxy, *pattern_collection, pdb_builder.get());
             fitness = zero_one_pdbs.compute_approx_mean_finite_h();
             // Update the best heuristic found so far.
             if (fitness > best_fitness) {
@@ -383,7 +384,7 @@ static shared_ptr<PatternCollectionGenerator> _parse(OptionParser &parser) {
         "false");
 
     utils::add_rng_options(parser);
-    add_generator_options_to_parser(parser);
+    add_collection_generator_options_to_parser(parser);
 
     Options opts = parser.parse();
     if (parser.dry_run())
@@ -3,6 +3,7 @@
 #include "canonical_pdbs_heuristic.h"
 #include "incremental_canonical_pdbs.h"
 #include "pattern_database.h"
+#include "pdb_builder.h"
 #include "utils.h"
 #include "validation.h"
 
@@ -23,6 +24,7 @@
 #include "../utils/timer.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <iostream>
 #include <limits>
@@ -133,7 +135,7 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
     PDBCollection &candidate_pdbs) {
     const Pattern &pattern = pdb.get_pattern();
     int pdb_size = pdb.get_size();
-    int max_pdb_size = 0;
+    PatternCollection new_patterns;
     for (int pattern_var : pattern) {
         assert(utils::in_bounds(pattern_var, relevant_neighbours));
         const vector<int> &connected_vars = relevant_neighbours[pattern_var];
@@ -160,16 +162,21 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
                       surpass the size limit.
                     */
                     generated_patterns.insert(new_pattern);
-                    candidate_pdbs.push_back(
-                        make_shared<PatternDatabase>(task_proxy, new_pattern));
-                    max_pdb_size = max(max_pdb_size,
-                                       candidate_pdbs.back()->get_size());
+                    new_patterns.push_back(move(new_pattern));
                 }
             } else {
                 ++num_rejected;
             }
         }
     }
+
+    // The PDBs of the new candidates are independent of each other.
+    int max_pdb_size = 0;
+    for (shared_ptr<PatternDatabase> &new_pdb :
+         pdb_builder->compute_pdbs(task_proxy, new_patterns)) {
+        max_pdb_size = max(max_pdb_size, new_pdb->get_size());
+        candidate_pdbs.push_back(move(new_pdb));
+    }
     return max_pdb_size;
 }
 
@@ -206,50 +213,73 @@ pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
     int improvement = 0;
     int best_pdb_index = -1;
 
-    // Iterate over all candidates and search for the best improving pattern/pdb
+    /*
+      If a candidate's size added to the current collection's size exceeds
+      the maximum collection size, then forget the pdb. Candidates set to
+      nullptr are too large or have already been added to the canonical
+      heuristic.
+    */
+    vector<int> candidate_ids;
     for (size_t i = 0; i < candidate_pdbs.size(); ++i) {
-        if (hill_climbing_timer->is_expired())
-            throw HillClimbingTimeout();
-
-        const shared_ptr<PatternDatabase> &pdb = candidate_pdbs[i];
-        if (!pdb) {
-            /* candidate pattern is too large or has already been added to
-               the canonical heuristic. */
-            continue;
-        }
-        /*
-          If a candidate's size added to the current collection's size exceeds
-          the maximum collection size, then forget the pdb.
-        */
-        int combined_size = current_pdbs->get_size() + pdb->get_size();
-        if (combined_size > collection_max_size) {
-            candidate_pdbs[i] = nullptr;
-            continue;
+        shared_ptr<PatternDatabase> &pdb = candidate_pdbs[i];
+        if (pdb) {
+            int combined_size = current_pdbs->get_size() + pdb->get_size();
+            if (combined_size > collection_max_size) {
+                pdb = nullptr;
+            } else {
+                candidate_ids.push_back(i);
+            }
         }
+    }
 
-        /*
-          Calculate the "counting approximation" for all sample states: count
-          the number of samples for which the current pattern collection
-          heuristic would be improved if the new pattern was included into it.
-        */
-        /*
-          TODO: The original implementation by Haslum et al. uses m/t as a
-          statistical confidence interval to stop the A*-search (which they use,
-          see above) earlier.
-        */
-        int count = 0;
-        vector<PatternClique> pattern_cliques =
-            current_pdbs->get_pattern_cliques(pdb->get_pattern());
-        for (int sample_id = 0; sample_id < num_samples; ++sample_id) {
-            const State &sample = samples[sample_id];
-            assert(utils::in_bounds(sample_id, samples_h_values));
-            int h_collection = samples_h_values[sample_id];
-            if (is_heuristic_improved(
-                    *pdb, sample, h_collection,
-                    *current_pdbs->get_pattern_databases(), pattern_cliques)) {
-                ++count;
+    /*
+      Calculate the "counting approximation" for all sample states: count
+      the number of samples for which the current pattern collection
+      heuristic would be improved if the new pattern was included into it.
+      The candidates are evaluated in parallel. Worker threads must not
+      throw, so they only record that the time limit has been reached.
+    */
+    /*
+      TODO: The original implementation by Haslum et al. uses m/t as a
+      statistical confidence interval to stop the A*-search (which they use,
+      see above) earlier.
+    */
+    for (const State &sample : samples) {
+        sample.unpack();
+    }
+    int num_candidates = candidate_ids.size();
+    vector<int> counts(num_candidates, 0);
+    atomic<bool> timeout(false);
+    pdb_builder->get_thread_pool().run(
+        num_candidates,
+        [&](int candidate, int) {
+            if (timeout || hill_climbing_timer->is_expired()) {
+                timeout = true;
+                return;
             }
-        }
+            const PatternDatabase &pdb = *candidate_pdbs[candidate_ids[candidate]];
+            vector<PatternClique> pattern_cliques =
+                current_pdbs->get_pattern_cliques(pdb.get_pattern());
+            int count = 0;
+            for (int sample_id = 0; sample_id < num_samples; ++sample_id) {
+                const State &sample = samples[sample_id];
+                assert(utils::in_bounds(sample_id, samples_h_values));
+                int h_collection = samples_h_values[sample_id];
+                if (is_heuristic_improved(
+                        pdb, sample, h_collection,
+                        *current_pdbs->get_pattern_databases(), pattern_cliques)) {
+                    ++count;
+                }
+            }
+            counts[candidate] = count;
+        });
+    if (timeout)
+        throw HillClimbingTimeout();
+
+    // Iterate over all candidates and search for the best improving pattern/pdb
+    for (int candidate = 0; candidate < num_candidates; ++candidate) {
+        int count = counts[candidate];
+        int i = candidate_ids[candidate];
         if (count > improvement) {
             improvement = count;
             best_pdb_index = i;
@@ -553,7 +583,7 @@ void add_hillclimbing_options(OptionParser &parser) {
         "infinity",
         Bounds("0.0", "infinity"));
     utils::add_rng_options(parser);
-    add_generator_options_to_parser(parser);
+    add_collection_generator_options_to_parser(parser);
 }
 
 void check_hillclimbing_options(
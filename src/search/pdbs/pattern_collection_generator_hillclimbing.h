@@ -77,7 +77,8 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
     /*
       Searches for the best improving pdb in candidate_pdbs according to the
       counting approximation and the given samples. Returns the improvement and
-      the index of the best pdb in candidate_pdbs.
+      the index of the best pdb in candidate_pdbs. The candidates are evaluated
+      with the threads of the PDB builder.
     */
     std::pair<int, int> find_best_improving_pdb(
         const std::vector<State> &samples,
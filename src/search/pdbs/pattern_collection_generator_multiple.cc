@@ -324,7 +324,7 @@ void add_multiple_options_to_parser(options::OptionParser &parser) {
         "generation is terminated already the first time stagnation_limit is "
         "hit.",
         "true");
-    add_generator_options_to_parser(parser);
+    add_collection_generator_options_to_parser(parser);
     utils::add_rng_options(parser);
 }
 }
@@ -310,7 +310,7 @@ static shared_ptr<PatternCollectionGenerator> _parse(OptionParser &parser) {
         "Only consider the union of two disjoint patterns if the union has "
         "more information than the individual patterns.",
         "true");
-    add_generator_options_to_parser(parser);
+    add_collection_generator_options_to_parser(parser);
 
     Options opts = parser.parse();
     if (parser.dry_run())
@@ -2,6 +2,7 @@
 
 #include "pattern_database.h"
 #include "pattern_cliques.h"
+#include "pdb_builder.h"
 #include "validation.h"
 
 #include "../utils/logging.h"
@@ -23,6 +24,7 @@ PatternCollectionInformation::PatternCollectionInformation(
       patterns(patterns),
       pdbs(nullptr),
       pattern_cliques(nullptr),
+      pdb_builder(nullptr),
       log(log) {
     assert(patterns);
     validate_and_normalize_patterns(task_proxy, *patterns, log);
@@ -62,11 +64,16 @@ void PatternCollectionInformation::create_pdbs_if_missing() {
         if (log.is_at_least_normal()) {
             log << "Computing PDBs for pattern collection..." << endl;
         }
-        pdbs = make_shared<PDBCollection>();
-        for (const Pattern &pattern : *patterns) {
-            shared_ptr<PatternDatabase> pdb =
-                make_shared<PatternDatabase>(task_proxy, pattern);
-            pdbs->push_back(pdb);
+        if (pdb_builder) {
+            pdbs = make_shared<PDBCollection>(
+                pdb_builder->compute_pdbs(task_proxy, *patterns));
+        } else {
+            pdbs = make_shared<PDBCollection>();
+            for (const Pattern &pattern : *patterns) {
+                shared_ptr<PatternDatabase> pdb =
+                    make_shared<PatternDatabase>(task_proxy, pattern);
+                pdbs->push_back(pdb);
+            }
         }
         if (log.is_at_least_normal()) {
             log << "Done computing PDBs for pattern collection: "
@@ -101,6 +108,11 @@ void PatternCollectionInformation::set_pattern_cliques(
     assert(information_is_valid());
 }
 
+void PatternCollectionInformation::set_pdb_builder(
+    const shared_ptr<PDBBuilder> &pdb_builder_) {
+    pdb_builder = pdb_builder_;
+}
+
 shared_ptr<PatternCollection> PatternCollectionInformation::get_patterns() const {
     assert(patterns);
     return patterns;
@@ -115,4 +127,8 @@ shared_ptr<vector<PatternClique>> PatternCollectionInformation::get_pattern_cliq
     create_pattern_cliques_if_missing();
     return pattern_cliques;
 }
+
+shared_ptr<PDBBuilder> PatternCollectionInformation::get_pdb_builder() const {
+    return pdb_builder;
+}
 }
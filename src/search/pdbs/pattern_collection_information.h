@@ -12,6 +12,8 @@ class LogProxy;
 }
 
 namespace pdbs {
+class PDBBuilder;
+
 /*
   This class contains everything we know about a pattern collection. It will
   always contain patterns, but can also contain the computed PDBs and maximal
@@ -29,6 +31,8 @@ class PatternCollectionInformation {
     std::shared_ptr<PatternCollection> patterns;
     std::shared_ptr<PDBCollection> pdbs;
     std::shared_ptr<std::vector<PatternClique>> pattern_cliques;
+    // Computes missing PDBs. If it is not set, they are computed one by one.
+    std::shared_ptr<PDBBuilder> pdb_builder;
     utils::LogProxy &log;
 
     void create_pdbs_if_missing();
@@ -45,6 +49,7 @@ public:
     void set_pdbs(const std::shared_ptr<PDBCollection> &pdbs);
     void set_pattern_cliques(
         const std::shared_ptr<std::vector<PatternClique>> &pattern_cliques);
+    void set_pdb_builder(const std::shared_ptr<PDBBuilder> &pdb_builder);
 
     TaskProxy get_task_proxy() const {
         return task_proxy;
@@ -53,6 +58,8 @@ public:
     std::shared_ptr<PatternCollection> get_patterns() const;
     std::shared_ptr<PDBCollection> get_pdbs();
     std::shared_ptr<std::vector<PatternClique>> get_pattern_cliques();
+    // Returns nullptr if no builder is set.
+    std::shared_ptr<PDBBuilder> get_pdb_builder() const;
 };
 }
 
@@ -1,20 +1,26 @@
 #include "pattern_database.h"
 
 #include "match_tree.h"
+#include "utils.h"
 
 #include "../algorithms/priority_queues.h"
 #include "../task_utils/task_properties.h"
 #include "../utils/collections.h"
+#include "../utils/heuristic_cache.h"
 #include "../utils/logging.h"
 #include "../utils/math.h"
 #include "../utils/rng.h"
+#include "../utils/thread_pool.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdlib>
 #include <iostream>
 #include <limits>
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -78,7 +84,8 @@ PatternDatabase::PatternDatabase(
     const vector<int> &operator_costs,
     bool compute_plan,
     const shared_ptr<utils::RandomNumberGenerator> &rng,
-    bool compute_wildcard_plan)
+    bool compute_wildcard_plan,
+    utils::ThreadPool *thread_pool)
     : pattern(pattern) {
     task_properties::verify_no_axioms(task_proxy);
     task_properties::verify_no_conditional_effects(task_proxy);
@@ -101,7 +108,8 @@ PatternDatabase::PatternDatabase(
             utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
         }
     }
-    create_pdb(task_proxy, operator_costs, compute_plan, rng, compute_wildcard_plan);
+    create_pdb(task_proxy, operator_costs, compute_plan, rng,
+               compute_wildcard_plan, thread_pool);
 }
 
 void PatternDatabase::multiply_out(
@@ -197,7 +205,7 @@ void PatternDatabase::build_abstract_operators(
 void PatternDatabase::create_pdb(
     const TaskProxy &task_proxy, const vector<int> &operator_costs,
     bool compute_plan, const shared_ptr<utils::RandomNumberGenerator> &rng,
-    bool compute_wildcard_plan) {
+    bool compute_wildcard_plan, utils::ThreadPool *thread_pool) {
     VariablesProxy variables = task_proxy.get_variables();
     vector<int> variable_to_index(variables.size(), -1);
     for (size_t i = 0; i < pattern.size(); ++i) {
@@ -217,13 +225,6 @@ void PatternDatabase::create_pdb(
             op, op_cost, variable_to_index, variables, operators);
     }
 
-    // build the match tree
-    MatchTree match_tree(task_proxy, pattern, hash_multipliers);
-    for (size_t op_id = 0; op_id < operators.size(); ++op_id) {
-        const AbstractOperator &op = operators[op_id];
-        match_tree.insert(op_id, op.get_regression_preconditions());
-    }
-
     // compute abstract goal var-val pairs
     vector<FactPair> abstract_goals;
     for (FactProxy goal : task_proxy.get_goals()) {
@@ -234,20 +235,54 @@ void PatternDatabase::create_pdb(
         }
     }
 
+    /*
+      The distances only depend on the abstract operators and goals. Plans
+      are not stored in the cache, so PDBs with plans are always computed.
+    */
+    string cache_key;
+    if (utils::uses_heuristic_cache() && !compute_plan) {
+        cache_key = compute_cache_key(operators, abstract_goals, variables);
+        if (load_distances_from_cache(cache_key)) {
+            return;
+        }
+    }
+
+    // build the match tree
+    MatchTree match_tree(task_proxy, pattern, hash_multipliers);
+    for (size_t op_id = 0; op_id < operators.size(); ++op_id) {
+        const AbstractOperator &op = operators[op_id];
+        match_tree.insert(op_id, op.get_regression_preconditions());
+    }
+
+    vector<int> distances;
     distances.reserve(num_states);
     // first implicit entry: priority, second entry: index for an abstract state
     priority_queues::AdaptiveQueue<int> pq;
 
+    /*
+      The parallel search cannot record generating operators, so plans are
+      always computed with the sequential Dijkstra search below.
+    */
+    bool search_in_parallel =
+        thread_pool && thread_pool->get_num_threads() > 1 && !compute_plan;
+
     // initialize queue
     for (int state_index = 0; state_index < num_states; ++state_index) {
         if (is_goal_state(state_index, abstract_goals, variables)) {
-            pq.push(0, state_index);
+            if (!search_in_parallel) {
+                pq.push(0, state_index);
+            }
             distances.push_back(0);
         } else {
             distances.push_back(numeric_limits<int>::max());
         }
     }
 
+    if (search_in_parallel) {
+        compute_distances_in_parallel(
+            match_tree, operators, *thread_pool, distances);
+    }
+
     if (compute_plan) {
         /*
           If computing a plan during Dijkstra, we store, for each state,
@@ -338,6 +373,164 @@ void PatternDatabase::create_pdb(
         }
         utils::release_vector_memory(generating_op_ids);
     }
+    this->distances = CompactDistances(move(distances));
+    if (!cache_key.empty()) {
+        store_distances_in_cache(cache_key);
+    }
+}
+
+string PatternDatabase::compute_cache_key(
+    const vector<AbstractOperator> &operators,
+    const vector<FactPair> &abstract_goals,
+    const VariablesProxy &variables) const {
+    utils::CacheKey key("pdb");
+    key.feed(num_states);
+    for (int var_id : pattern) {
+        key.feed(variables[var_id].get_domain_size());
+    }
+    key.feed(abstract_goals);
+    key.feed(static_cast<uint64_t>(operators.size()));
+    for (const AbstractOperator &op : operators) {
+        key.feed(op.get_regression_preconditions());
+        key.feed(op.get_hash_effect());
+        key.feed(op.get_cost());
+    }
+    return key.finish();
+}
+
+bool PatternDatabase::load_distances_from_cache(const string &key) {
+    unique_ptr<utils::CacheReader> reader =
+        utils::CacheReader::open("pdb", key);
+    if (!reader) {
+        return false;
+    }
+    int bytes_per_entry = reader->read_int();
+    const void *entries = nullptr;
+    size_t num_entries = 0;
+    if (bytes_per_entry == 1) {
+        entries = reader->read_array<uint8_t>(num_entries);
+    } else if (bytes_per_entry == 2) {
+        entries = reader->read_array<uint16_t>(num_entries);
+    } else if (bytes_per_entry == sizeof(int)) {
+        entries = reader->read_array<int>(num_entries);
+    }
+    if (!entries || !reader->is_complete() ||
+        num_entries != static_cast<size_t>(num_states)) {
+        return false;
+    }
+    distances = CompactDistances(
+        reader->get_mapping(), entries, num_entries, bytes_per_entry);
+    return true;
+}
+
+void PatternDatabase::store_distances_in_cache(const string &key) const {
+    utils::CacheWriter writer("pdb", key);
+    int bytes_per_entry = distances.get_bytes_per_entry();
+    writer.write_int(bytes_per_entry);
+    const void *entries = distances.get_entries();
+    if (bytes_per_entry == 1) {
+        writer.write_array(static_cast<const uint8_t *>(entries), num_states);
+    } else if (bytes_per_entry == 2) {
+        writer.write_array(static_cast<const uint16_t *>(entries), num_states);
+    } else {
+        writer.write_array(static_cast<const int *>(entries), num_states);
+    }
+    writer.commit();
+}
+
+void PatternDatabase::compute_distances_in_parallel(
+    const MatchTree &match_tree, const vector<AbstractOperator> &operators,
+    utils::ThreadPool &thread_pool, vector<int> &distances) const {
+    /*
+      Layers with fewer states are expanded by the calling thread alone
+      since distributing them costs more than it saves.
+    */
+    const int MIN_PARALLEL_LAYER_SIZE = 1024;
+    const int CHUNKS_PER_THREAD = 4;
+    int num_threads = thread_pool.get_num_threads();
+
+    vector<atomic<int>> atomic_distances(num_states);
+    // Maps distances to the states reached with that distance.
+    map<int, vector<int>> layers;
+    for (int state_index = 0; state_index < num_states; ++state_index) {
+        atomic_distances[state_index].store(
+            distances[state_index], memory_order_relaxed);
+        if (distances[state_index] == 0) {
+            layers[0].push_back(state_index);
+        }
+    }
+
+    /*
+      Each thread collects the (distance, state) pairs of the states whose
+      distance it lowered. They are added to the layers after the current
+      layer is expanded. Pairs for states whose distance is lowered again
+      later become stale and are skipped like in the sequential search.
+    */
+    vector<vector<pair<int, int>>> reached_states(num_threads);
+    vector<vector<int>> applicable_operator_ids(num_threads);
+    while (!layers.empty()) {
+        int distance = layers.begin()->first;
+        vector<int> layer = move(layers.begin()->second);
+        layers.erase(layers.begin());
+
+        int layer_size = layer.size();
+        auto expand_states = [&](int begin, int end, int thread_id) {
+                vector<int> &op_ids = applicable_operator_ids[thread_id];
+                vector<pair<int, int>> &reached = reached_states[thread_id];
+                for (int i = begin; i < end; ++i) {
+                    int state_index = layer[i];
+                    if (atomic_distances[state_index].load(
+                            memory_order_relaxed) != distance) {
+                        continue;
+                    }
+                    op_ids.clear();
+                    match_tree.get_applicable_operator_ids(state_index, op_ids);
+                    for (int op_id : op_ids) {
+                        const AbstractOperator &op = operators[op_id];
+                        int predecessor = state_index + op.get_hash_effect();
+                        int alternative_cost = distance + op.get_cost();
+                        atomic<int> &old_distance = atomic_distances[predecessor];
+                        int old_cost = old_distance.load(memory_order_relaxed);
+                        while (alternative_cost < old_cost) {
+                            if (old_distance.compare_exchange_weak(
+                                    old_cost, alternative_cost,
+                                    memory_order_relaxed)) {
+                                reached.emplace_back(alternative_cost, predecessor);
+                                break;
+                            }
+                        }
+                    }
+                }
+            };
+        if (layer_size < MIN_PARALLEL_LAYER_SIZE) {
+            expand_states(0, layer_size, 0);
+        } else {
+            int num_chunks = min(layer_size, num_threads * CHUNKS_PER_THREAD);
+            thread_pool.run(
+                num_chunks,
+                [&](int chunk, int thread_id) {
+                    int begin = static_cast<long long>(layer_size) * chunk / num_chunks;
+                    int end = static_cast<long long>(layer_size) * (chunk + 1) / num_chunks;
+                    expand_states(begin, end, thread_id);
+                });
+        }
+
+        /*
+          Zero-cost operators reach states with the current distance. They
+          form a new layer with the same distance, which is expanded next.
+        */
+        for (vector<pair<int, int>> &reached : reached_states) {
+            for (const pair<int, int> &entry : reached) {
+                layers[entry.first].push_back(entry.second);
+            }
+            reached.clear();
+        }
+    }
+
+    for (int state_index = 0; state_index < num_states; ++state_index) {
+        distances[state_index] =
+            atomic_distances[state_index].load(memory_order_relaxed);
+    }
 }
 
 bool PatternDatabase::is_goal_state(
@@ -369,12 +562,27 @@ int PatternDatabase::get_value(const vector<int> &state) const {
     return distances[hash_index(state)];
 }
 
+void PatternDatabase::get_values(
+    const vector<const int *> &states, vector<int> &values) const {
+    int num_states_in_batch = states.size();
+    values.assign(num_states_in_batch, 0);
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        int var = pattern[i];
+        int multiplier = hash_multipliers[i];
+        for (int j = 0; j < num_states_in_batch; ++j) {
+            values[j] += multiplier * states[j][var];
+        }
+    }
+    distances.lookup(values);
+}
+
 double PatternDatabase::compute_mean_finite_h() const {
     double sum = 0;
     int size = 0;
-    for (size_t i = 0; i < distances.size(); ++i) {
-        if (distances[i] != numeric_limits<int>::max()) {
-            sum += distances[i];
+    for (int i = 0; i < distances.size(); ++i) {
+        int distance = distances[i];
+        if (distance != numeric_limits<int>::max()) {
+            sum += distance;
             ++size;
         }
     }
@@ -386,12 +594,6 @@ double PatternDatabase::compute_mean_finite_h() const {
 }
 
 bool PatternDatabase::is_operator_relevant(const OperatorProxy &op) const {
-    for (EffectProxy effect : op.get_effects()) {
-        int var_id = effect.get_fact().get_variable().get_id();
-        if (binary_search(pattern.begin(), pattern.end(), var_id)) {
-            return true;
-        }
-    }
-    return false;
+    return pdbs::is_operator_relevant(pattern, op);
 }
 }
@@ -1,19 +1,24 @@
 #ifndef PDBS_PATTERN_DATABASE_H
 #define PDBS_PATTERN_DATABASE_H
 
+#include "compact_distances.h"
 #include "types.h"
 
 #include "../task_proxy.h"
 
+#include <string>
 #include <utility>
 #include <vector>
 
 namespace utils {
 class LogProxy;
 class RandomNumberGenerator;
+class ThreadPool;
 }
 
 namespace pdbs {
+class MatchTree;
+
 class AbstractOperator {
     /*
       This class represents an abstract operator how it is needed for
@@ -92,7 +97,7 @@ class PatternDatabase {
       final h-values for abstract-states.
       dead-ends are represented by numeric_limits<int>::max()
     */
-    std::vector<int> distances;
+    CompactDistances distances;
 
     std::vector<int> generating_op_ids;
     std::vector<std::vector<OperatorID>> wildcard_plan;
@@ -141,7 +146,32 @@ class PatternDatabase {
         const std::vector<int> &operator_costs,
         bool compute_plan,
         const std::shared_ptr<utils::RandomNumberGenerator> &rng,
-        bool compute_wildcard_plan);
+        bool compute_wildcard_plan,
+        utils::ThreadPool *thread_pool);
+
+    /*
+      Computes the same distances as the Dijkstra search in create_pdb,
+      but expands all states with the currently smallest distance in
+      parallel. Distances of predecessors are lowered with atomic
+      operations. distances must contain 0 for goal states and
+      numeric_limits<int>::max() for all other states.
+    */
+    void compute_distances_in_parallel(
+        const MatchTree &match_tree,
+        const std::vector<AbstractOperator> &operators,
+        utils::ThreadPool &thread_pool,
+        std::vector<int> &distances) const;
+
+    /*
+      Support for the heuristic cache (see utils/heuristic_cache.h). The key
+      covers everything the distances depend on.
+    */
+    std::string compute_cache_key(
+        const std::vector<AbstractOperator> &operators,
+        const std::vector<FactPair> &abstract_goals,
+        const VariablesProxy &variables) const;
+    bool load_distances_from_cache(const std::string &key);
+    void store_distances_in_cache(const std::string &key) const;
 
     /*
       For a given abstract state (given as index), the according values
@@ -174,6 +204,8 @@ public:
        compute_wildcard_plan: when computing a plan (see compute_plan), compute
        a wildcard plan, i.e., a sequence of parallel operators inducing an
        optimal plan. Otherwise, compute a simple plan (a sequence of operators).
+       thread_pool: if given, compute the distances with all threads of the
+       pool. Plans are always computed with a single thread.
     */
     PatternDatabase(
         const TaskProxy &task_proxy,
@@ -181,11 +213,21 @@ public:
         const std::vector<int> &operator_costs = std::vector<int>(),
         bool compute_plan = false,
         const std::shared_ptr<utils::RandomNumberGenerator> &rng = nullptr,
-        bool compute_wildcard_plan = false);
+        bool compute_wildcard_plan = false,
+        utils::ThreadPool *thread_pool = nullptr);
     ~PatternDatabase() = default;
 
     int get_value(const std::vector<int> &state) const;
 
+    /*
+      Compute the values of several states at once: values[i] is the value
+      of the state whose unpacked values start at states[i]. The hash
+      indices are computed one pattern variable at a time for all states,
+      so the table lookups of the states are independent of each other.
+    */
+    void get_values(
+        const std::vector<const int *> &states, std::vector<int> &values) const;
+
     // Returns the pattern (i.e. all variables used) of the PDB
     const Pattern &get_pattern() const {
         return pattern;
@@ -1,14 +1,19 @@
 #include "pattern_generator.h"
 
+#include "pdb_builder.h"
 #include "utils.h"
 
+#include "../option_parser.h"
 #include "../plugin.h"
 
 using namespace std;
 
 namespace pdbs {
 PatternCollectionGenerator::PatternCollectionGenerator(const options::Options &opts)
-    : log(utils::get_log_from_options(opts)) {
+    : log(utils::get_log_from_options(opts)),
+      pdb_builder(make_shared<PDBBuilder>(
+                      opts.get<int>("threads"),
+                      opts.get<int>("concurrent_pdb_max_size"))) {
 }
 
 PatternCollectionInformation PatternCollectionGenerator::generate(
@@ -18,6 +23,7 @@ PatternCollectionInformation PatternCollectionGenerator::generate(
     }
     utils::Timer timer;
     PatternCollectionInformation pci = compute_patterns(task);
+    pci.set_pdb_builder(pdb_builder);
     dump_pattern_collection_generation_statistics(
         name(), timer(), pci, log);
     return pci;
@@ -46,6 +52,22 @@ void add_generator_options_to_parser(options::OptionParser &parser) {
     utils::add_log_options_to_parser(parser);
 }
 
+void add_collection_generator_options_to_parser(options::OptionParser &parser) {
+    parser.add_option<int>(
+        "threads",
+        "number of threads for computing independent PDBs at the same time",
+        "1",
+        Bounds("1", "infinity"));
+    parser.add_option<int>(
+        "concurrent_pdb_max_size",
+        "maximal number of abstract states of all PDBs computed at the same "
+        "time. A larger PDB is computed alone. This limits the memory used "
+        "with threads > 1 and has no effect otherwise.",
+        "20000000",
+        Bounds("1", "infinity"));
+    add_generator_options_to_parser(parser);
+}
+
 static PluginTypePlugin<PatternCollectionGenerator> _type_plugin_collection(
     "PatternCollectionGenerator",
     "Factory for pattern collections");
@@ -22,12 +22,19 @@ class RandomNumberGenerator;
 }
 
 namespace pdbs {
+class PDBBuilder;
+
 class PatternCollectionGenerator {
     virtual std::string name() const = 0;
     virtual PatternCollectionInformation compute_patterns(
         const std::shared_ptr<AbstractTask> &task) = 0;
 protected:
     mutable utils::LogProxy log;
+    /*
+      Used for all PDBs of pattern collections computed by the generator,
+      including the PDBs of the returned collection.
+    */
+    std::shared_ptr<PDBBuilder> pdb_builder;
 public:
     explicit PatternCollectionGenerator(const options::Options &opts);
     virtual ~PatternCollectionGenerator() = default;
@@ -50,6 +57,12 @@ public:
 };
 
 extern void add_generator_options_to_parser(options::OptionParser &parser);
+/*
+  Add the options of add_generator_options_to_parser and the options for
+  computing the PDBs of the generated pattern collections.
+*/
+extern void add_collection_generator_options_to_parser(
+    options::OptionParser &parser);
 }
 
 #endif
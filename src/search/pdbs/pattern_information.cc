@@ -22,9 +22,11 @@ bool PatternInformation::information_is_valid() const {
     return !pdb || pdb->get_pattern() == pattern;
 }
 
-void PatternInformation::create_pdb_if_missing() {
+void PatternInformation::create_pdb_if_missing(utils::ThreadPool *thread_pool) {
     if (!pdb) {
-        pdb = make_shared<PatternDatabase>(task_proxy, pattern);
+        pdb = make_shared<PatternDatabase>(
+            task_proxy, pattern, vector<int>(), false, nullptr, false,
+            thread_pool);
     }
 }
 
@@ -37,8 +39,9 @@ const Pattern &PatternInformation::get_pattern() const {
     return pattern;
 }
 
-shared_ptr<PatternDatabase> PatternInformation::get_pdb() {
-    create_pdb_if_missing();
+shared_ptr<PatternDatabase> PatternInformation::get_pdb(
+    utils::ThreadPool *thread_pool) {
+    create_pdb_if_missing(thread_pool);
     return pdb;
 }
 }
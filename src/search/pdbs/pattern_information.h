@@ -9,6 +9,7 @@
 
 namespace utils {
 class LogProxy;
+class ThreadPool;
 }
 
 namespace pdbs {
@@ -28,7 +29,7 @@ class PatternInformation {
     Pattern pattern;
     std::shared_ptr<PatternDatabase> pdb;
 
-    void create_pdb_if_missing();
+    void create_pdb_if_missing(utils::ThreadPool *thread_pool);
 
     bool information_is_valid() const;
 public:
@@ -42,7 +43,12 @@ public:
     }
 
     const Pattern &get_pattern() const;
-    std::shared_ptr<PatternDatabase> get_pdb();
+    /*
+      If the PDB has to be computed and thread_pool is given, all threads
+      of the pool are used to compute it.
+    */
+    std::shared_ptr<PatternDatabase> get_pdb(
+        utils::ThreadPool *thread_pool = nullptr);
 };
 }
 
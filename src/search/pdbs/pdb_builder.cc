@@ -0,0 +1,60 @@
+#include "pdb_builder.h"
+
+#include "pattern_database.h"
+#include "utils.h"
+
+#include <cassert>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+using namespace std;
+
+namespace pdbs {
+PDBBuilder::PDBBuilder(int num_threads, int max_concurrent_states)
+    : thread_pool(num_threads),
+      max_concurrent_states(max_concurrent_states) {
+}
+
+PDBCollection PDBBuilder::compute_pdbs(
+    const TaskProxy &task_proxy,
+    const PatternCollection &patterns,
+    const vector<vector<int>> &operator_costs) {
+    assert(operator_costs.empty() || operator_costs.size() == patterns.size());
+    int num_patterns = patterns.size();
+    PDBCollection pdbs(num_patterns);
+
+    mutex states_mutex;
+    condition_variable states_released;
+    int num_states_in_construction = 0;
+
+    thread_pool.run(
+        num_patterns,
+        [&](int pattern_id, int) {
+            const Pattern &pattern = patterns[pattern_id];
+            int num_states = compute_pdb_size(task_proxy, pattern);
+            {
+                unique_lock<mutex> lock(states_mutex);
+                states_released.wait(lock, [&]() {
+                    return num_states_in_construction == 0 ||
+                           num_states <= max_concurrent_states -
+                           num_states_in_construction;
+                });
+                num_states_in_construction += num_states;
+            }
+            if (operator_costs.empty()) {
+                pdbs[pattern_id] =
+                    make_shared<PatternDatabase>(task_proxy, pattern);
+            } else {
+                pdbs[pattern_id] = make_shared<PatternDatabase>(
+                    task_proxy, pattern, operator_costs[pattern_id]);
+            }
+            {
+                lock_guard<mutex> lock(states_mutex);
+                num_states_in_construction -= num_states;
+            }
+            states_released.notify_all();
+        });
+    return pdbs;
+}
+}
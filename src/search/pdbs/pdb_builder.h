@@ -0,0 +1,49 @@
+#ifndef PDBS_PDB_BUILDER_H
+#define PDBS_PDB_BUILDER_H
+
+#include "types.h"
+
+#include "../task_proxy.h"
+
+#include "../utils/thread_pool.h"
+
+#include <vector>
+
+namespace pdbs {
+/*
+  Computes the PDBs of pattern collections. With several threads,
+  independent PDBs are computed concurrently, but the PDBs under
+  construction at the same time have at most max_concurrent_states
+  abstract states in total. A larger PDB is computed when no other PDB is
+  under construction. The resulting PDBs do not depend on the number of
+  threads.
+
+  Pattern collection generators share their builder with the
+  PatternCollectionInformation objects they create, so that the PDBs of the
+  final collection are computed with the same threads.
+*/
+class PDBBuilder {
+    utils::ThreadPool thread_pool;
+    const int max_concurrent_states;
+public:
+    PDBBuilder(int num_threads, int max_concurrent_states);
+
+    /*
+      Compute the PDBs of the given patterns in the given order. If
+      operator_costs is not empty, the PDB of patterns[i] uses the operator
+      costs operator_costs[i] (see PatternDatabase).
+    */
+    PDBCollection compute_pdbs(
+        const TaskProxy &task_proxy,
+        const PatternCollection &patterns,
+        const std::vector<std::vector<int>> &operator_costs =
+            std::vector<std::vector<int>>());
+
+    // The pool can be used for other work while no PDBs are computed.
+    utils::ThreadPool &get_thread_pool() {
+        return thread_pool;
+    }
+};
+}
+
+#endif
@@ -2,10 +2,13 @@
 
 #include "pattern_database.h"
 #include "pattern_generator.h"
+#include "utils.h"
 
 #include "../option_parser.h"
 #include "../plugin.h"
 
+#include "../utils/thread_pool.h"
+
 #include <limits>
 #include <memory>
 
@@ -17,7 +20,8 @@ shared_ptr<PatternDatabase> get_pdb_from_options(const shared_ptr<AbstractTask>
     shared_ptr<PatternGenerator> pattern_generator =
         opts.get<shared_ptr<PatternGenerator>>("pattern");
     PatternInformation pattern_info = pattern_generator->generate(task);
-    return pattern_info.get_pdb();
+    utils::ThreadPool thread_pool(opts.get<int>("threads"));
+    return pattern_info.get_pdb(&thread_pool);
 }
 
 PDBHeuristic::PDBHeuristic(const Options &opts)
@@ -33,6 +37,23 @@ int PDBHeuristic::compute_heuristic(const State &ancestor_state) {
     return h;
 }
 
+void PDBHeuristic::compute_heuristics(
+    const vector<State> &ancestor_states, vector<int> &values) {
+    vector<int> state_values;
+    vector<const int *> states =
+        convert_states(task_proxy, ancestor_states, state_values);
+    pdb->get_values(states, values);
+    for (int &h : values) {
+        if (h == numeric_limits<int>::max()) {
+            h = DEAD_END;
+        }
+    }
+}
+
+bool PDBHeuristic::supports_batch_evaluation() const {
+    return true;
+}
+
 static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_synopsis("Pattern database heuristic", "TODO");
     parser.document_language_support("action costs", "supported");
@@ -47,6 +68,11 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "pattern",
         "pattern generation method",
         "greedy()");
+    parser.add_option<int>(
+        "threads",
+        "number of threads used to compute the PDB",
+        "1",
+        Bounds("1", "infinity"));
     Heuristic::add_options_to_parser(parser);
 
     Options opts = parser.parse();
@@ -15,6 +15,9 @@ class PDBHeuristic : public Heuristic {
     std::shared_ptr<PatternDatabase> pdb;
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
+    virtual void compute_heuristics(
+        const std::vector<State> &ancestor_states,
+        std::vector<int> &values) override;
 public:
     /*
       Important: It is assumed that the pattern (passed via Options) is
@@ -27,6 +30,8 @@ public:
     */
     PDBHeuristic(const options::Options &opts);
     virtual ~PDBHeuristic() override = default;
+
+    virtual bool supports_batch_evaluation() const override;
 };
 }
 
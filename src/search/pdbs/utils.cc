@@ -14,6 +14,8 @@
 #include "../utils/math.h"
 #include "../utils/rng.h"
 
+#include <algorithm>
+#include <cassert>
 #include <limits>
 
 using namespace std;
@@ -44,6 +46,37 @@ int compute_total_pdb_size(
     return size;
 }
 
+bool is_operator_relevant(const Pattern &pattern, const OperatorProxy &op) {
+    for (EffectProxy effect : op.get_effects()) {
+        int var_id = effect.get_fact().get_variable().get_id();
+        if (binary_search(pattern.begin(), pattern.end(), var_id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+vector<const int *> convert_states(
+    const TaskProxy &task_proxy, const vector<State> &ancestor_states,
+    vector<int> &state_values) {
+    int num_states = ancestor_states.size();
+    int num_variables = task_proxy.get_variables().size();
+    state_values.resize(num_states * num_variables);
+    vector<int> values;
+    for (int i = 0; i < num_states; ++i) {
+        task_proxy.convert_ancestor_state_values(ancestor_states[i], values);
+        assert(static_cast<int>(values.size()) == num_variables);
+        copy(values.begin(), values.end(),
+             state_values.begin() + i * num_variables);
+    }
+    vector<const int *> states;
+    states.reserve(num_states);
+    for (int i = 0; i < num_states; ++i) {
+        states.push_back(state_values.data() + i * num_variables);
+    }
+    return states;
+}
+
 vector<FactPair> get_goals_in_random_order(
     const TaskProxy &task_proxy, utils::RandomNumberGenerator &rng) {
     vector<FactPair> goals = task_properties::get_fact_pairs(task_proxy.get_goals());
@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace utils {
 class LogProxy;
@@ -23,6 +24,21 @@ extern int compute_pdb_size(const TaskProxy &task_proxy, const Pattern &pattern)
 extern int compute_total_pdb_size(
     const TaskProxy &task_proxy, const PatternCollection &pattern_collection);
 
+// Returns true iff op has an effect on a variable in the pattern.
+extern bool is_operator_relevant(
+    const Pattern &pattern, const OperatorProxy &op);
+
+/*
+  Convert the given states to the task of task_proxy, store their values
+  one after another in state_values and return pointers to the values of
+  each state, as needed for evaluating PDBs on several states at once (see
+  PatternDatabase::get_values). The pointers stay valid as long as
+  state_values is not modified.
+*/
+extern std::vector<const int *> convert_states(
+    const TaskProxy &task_proxy, const std::vector<State> &ancestor_states,
+    std::vector<int> &state_values);
+
 extern std::vector<FactPair> get_goals_in_random_order(
     const TaskProxy &task_proxy, utils::RandomNumberGenerator &rng);
 extern std::vector<int> get_non_goal_variables(const TaskProxy &task_proxy);
@@ -1,6 +1,8 @@
 #include "zero_one_pdbs.h"
 
 #include "pattern_database.h"
+#include "pdb_builder.h"
+#include "utils.h"
 
 #include "../task_proxy.h"
 
@@ -15,26 +17,40 @@ using namespace std;
 
 namespace pdbs {
 ZeroOnePDBs::ZeroOnePDBs(
-    const TaskProxy &task_proxy, const PatternCollection &patterns) {
+    const TaskProxy &task_proxy, const PatternCollection &patterns,
+    PDBBuilder *pdb_builder) {
     vector<int> remaining_operator_costs;
     OperatorsProxy operators = task_proxy.get_operators();
     remaining_operator_costs.reserve(operators.size());
     for (OperatorProxy op : operators)
         remaining_operator_costs.push_back(op.get_cost());
 
-    pattern_databases.reserve(patterns.size());
+    /*
+      Set cost of operators relevant for a pattern to 0 for all later
+      patterns (action cost partitioning). Relevance only depends on the
+      patterns, so we can compute all cost functions before the PDBs, which
+      are then independent of each other.
+    */
+    vector<vector<int>> operator_costs;
+    operator_costs.reserve(patterns.size());
     for (const Pattern &pattern : patterns) {
-        shared_ptr<PatternDatabase> pdb = make_shared<PatternDatabase>(
-            task_proxy, pattern, remaining_operator_costs);
-
-        /* Set cost of relevant operators to 0 for further iterations
-           (action cost partitioning). */
+        operator_costs.push_back(remaining_operator_costs);
         for (OperatorProxy op : operators) {
-            if (pdb->is_operator_relevant(op))
+            if (is_operator_relevant(pattern, op))
                 remaining_operator_costs[op.get_id()] = 0;
         }
+    }
 
-        pattern_databases.push_back(pdb);
+    if (pdb_builder) {
+        pattern_databases = pdb_builder->compute_pdbs(
+            task_proxy, patterns, operator_costs);
+    } else {
+        pattern_databases.reserve(patterns.size());
+        for (size_t i = 0; i < patterns.size(); ++i) {
+            pattern_databases.push_back(make_shared<PatternDatabase>(
+                                            task_proxy, patterns[i],
+                                            operator_costs[i]));
+        }
     }
 }
 
@@ -55,6 +71,22 @@ int ZeroOnePDBs::get_value(const State &state) const {
     return h_val;
 }
 
+void ZeroOnePDBs::get_values(
+    const vector<const int *> &states, vector<int> &values) const {
+    values.assign(states.size(), 0);
+    vector<int> pdb_values;
+    for (const shared_ptr<PatternDatabase> &pdb : pattern_databases) {
+        pdb->get_values(states, pdb_values);
+        for (size_t i = 0; i < states.size(); ++i) {
+            if (pdb_values[i] == numeric_limits<int>::max()) {
+                values[i] = numeric_limits<int>::max();
+            } else if (values[i] != numeric_limits<int>::max()) {
+                values[i] += pdb_values[i];
+            }
+        }
+    }
+}
+
 double ZeroOnePDBs::compute_approx_mean_finite_h() const {
     double approx_mean_finite_h = 0;
     for (const shared_ptr<PatternDatabase> &pdb : pattern_databases) {
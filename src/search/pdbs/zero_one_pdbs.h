@@ -11,13 +11,20 @@ class LogProxy;
 }
 
 namespace pdbs {
+class PDBBuilder;
+
 class ZeroOnePDBs {
     PDBCollection pattern_databases;
 public:
-    ZeroOnePDBs(const TaskProxy &task_proxy, const PatternCollection &patterns);
+    // If pdb_builder is given, it is used to compute the PDBs.
+    ZeroOnePDBs(const TaskProxy &task_proxy, const PatternCollection &patterns,
+                PDBBuilder *pdb_builder = nullptr);
     ~ZeroOnePDBs() = default;
 
     int get_value(const State &state) const;
+    // Batch version of get_value (see PatternDatabase::get_values).
+    void get_values(
+        const std::vector<const int *> &states, std::vector<int> &values) const;
     /*
       Returns the sum of all mean finite h-values of every PDB.
       This is an approximation of the real mean finite h-value of the Heuristic,
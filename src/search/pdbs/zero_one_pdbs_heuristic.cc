@@ -1,6 +1,7 @@
 #include "zero_one_pdbs_heuristic.h"
 
 #include "pattern_generator.h"
+#include "utils.h"
 
 #include "../option_parser.h"
 #include "../plugin.h"
@@ -19,7 +20,8 @@ ZeroOnePDBs get_zero_one_pdbs_from_options(
     shared_ptr<PatternCollection> patterns =
         pattern_collection_info.get_patterns();
     TaskProxy task_proxy(*task);
-    return ZeroOnePDBs(task_proxy, *patterns);
+    return ZeroOnePDBs(task_proxy, *patterns,
+                       pattern_collection_info.get_pdb_builder().get());
 }
 
 ZeroOnePDBsHeuristic::ZeroOnePDBsHeuristic(
@@ -36,6 +38,23 @@ int ZeroOnePDBsHeuristic::compute_heuristic(const State &ancestor_state) {
     return h;
 }
 
+void ZeroOnePDBsHeuristic::compute_heuristics(
+    const vector<State> &ancestor_states, vector<int> &values) {
+    vector<int> state_values;
+    vector<const int *> states =
+        convert_states(task_proxy, ancestor_states, state_values);
+    zero_one_pdbs.get_values(states, values);
+    for (int &h : values) {
+        if (h == numeric_limits<int>::max()) {
+            h = DEAD_END;
+        }
+    }
+}
+
+bool ZeroOnePDBsHeuristic::supports_batch_evaluation() const {
+    return true;
+}
+
 static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_synopsis(
         "Zero-One PDB",
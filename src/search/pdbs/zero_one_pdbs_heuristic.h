@@ -12,9 +12,14 @@ class ZeroOnePDBsHeuristic : public Heuristic {
     ZeroOnePDBs zero_one_pdbs;
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
+    virtual void compute_heuristics(
+        const std::vector<State> &ancestor_states,
+        std::vector<int> &values) override;
 public:
     ZeroOnePDBsHeuristic(const options::Options &opts);
     virtual ~ZeroOnePDBsHeuristic() = default;
+
+    virtual bool supports_batch_evaluation() const override;
 };
 }
 
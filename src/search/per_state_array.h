@@ -46,19 +46,21 @@ public:
 template<class Element>
 class PerStateArray : public subscriber::Subscriber<StateRegistry> {
     const std::vector<Element> default_array;
+    using EntryArrayVector = segmented_vector::SegmentedArrayVector<
+        Element, utils::MappedStorageAllocator<Element>>;
     using EntryArrayVectorMap = std::unordered_map<const StateRegistry *,
-                                                   segmented_vector::SegmentedArrayVector<Element> *>;
+                                                   EntryArrayVector *>;
     EntryArrayVectorMap entry_arrays_by_registry;
 
     mutable const StateRegistry *cached_registry;
-    mutable segmented_vector::SegmentedArrayVector<Element> *cached_entries;
+    mutable EntryArrayVector *cached_entries;
 
-    segmented_vector::SegmentedArrayVector<Element> *get_entries(const StateRegistry *registry) {
+    EntryArrayVector *get_entries(const StateRegistry *registry) {
         if (cached_registry != registry) {
             cached_registry = registry;
             auto it = entry_arrays_by_registry.find(registry);
             if (it == entry_arrays_by_registry.end()) {
-                cached_entries = new segmented_vector::SegmentedArrayVector<Element>(
+                cached_entries = new EntryArrayVector(
                     default_array.size());
                 entry_arrays_by_registry[registry] = cached_entries;
                 registry->subscribe(this);
@@ -70,7 +72,7 @@ class PerStateArray : public subscriber::Subscriber<StateRegistry> {
         return cached_entries;
     }
 
-    const segmented_vector::SegmentedArrayVector<Element> *get_entries(
+    const EntryArrayVector *get_entries(
         const StateRegistry *registry) const {
         if (cached_registry != registry) {
             const auto it = entry_arrays_by_registry.find(registry);
@@ -78,7 +80,7 @@ class PerStateArray : public subscriber::Subscriber<StateRegistry> {
                 return nullptr;
             } else {
                 cached_registry = registry;
-                cached_entries = const_cast<segmented_vector::SegmentedArrayVector<Element> *>(
+                cached_entries = const_cast<EntryArrayVector *>(
                     it->second);
             }
         }
@@ -109,7 +111,7 @@ public:
                       << "state." << std::endl;
             utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
         }
-        segmented_vector::SegmentedArrayVector<Element> *entries = get_entries(registry);
+        EntryArrayVector *entries = get_entries(registry);
         int state_id = state.get_id().value;
         assert(state.get_id() != StateID::no_state);
         size_t virtual_size = registry->size();
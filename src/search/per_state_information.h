@@ -6,6 +6,7 @@
 #include "algorithms/segmented_vector.h"
 #include "algorithms/subscriber.h"
 #include "utils/collections.h"
+#include "utils/mapped_storage.h"
 
 #include <cassert>
 #include <iostream>
@@ -39,12 +40,13 @@
 template<class Entry>
 class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
     const Entry default_value;
-    using EntryVectorMap = std::unordered_map<const StateRegistry *,
-                                              segmented_vector::SegmentedVector<Entry> * >;
+    using EntryVector = segmented_vector::SegmentedVector<
+        Entry, utils::MappedStorageAllocator<Entry>>;
+    using EntryVectorMap = std::unordered_map<const StateRegistry *, EntryVector *>;
     EntryVectorMap entries_by_registry;
 
     mutable const StateRegistry *cached_registry;
-    mutable segmented_vector::SegmentedVector<Entry> *cached_entries;
+    mutable EntryVector *cached_entries;
 
     /*
       Returns the SegmentedVector associated with the given StateRegistry.
@@ -52,12 +54,12 @@ class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
       Both the registry and the returned vector are cached to speed up
       consecutive calls with the same registry.
     */
-    segmented_vector::SegmentedVector<Entry> *get_entries(const StateRegistry *registry) {
+    EntryVector *get_entries(const StateRegistry *registry) {
         if (cached_registry != registry) {
             cached_registry = registry;
             auto it = entries_by_registry.find(registry);
             if (it == entries_by_registry.end()) {
-                cached_entries = new segmented_vector::SegmentedVector<Entry>();
+                cached_entries = new EntryVector();
                 entries_by_registry[registry] = cached_entries;
                 registry->subscribe(this);
             } else {
@@ -74,14 +76,14 @@ class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
       Otherwise, both the registry and the returned vector are cached to speed
       up consecutive calls with the same registry.
     */
-    const segmented_vector::SegmentedVector<Entry> *get_entries(const StateRegistry *registry) const {
+    const EntryVector *get_entries(const StateRegistry *registry) const {
         if (cached_registry != registry) {
             const auto it = entries_by_registry.find(registry);
             if (it == entries_by_registry.end()) {
                 return nullptr;
             } else {
                 cached_registry = registry;
-                cached_entries = const_cast<segmented_vector::SegmentedVector<Entry> *>(it->second);
+                cached_entries = const_cast<EntryVector *>(it->second);
             }
         }
         assert(cached_registry == registry);
@@ -117,7 +119,7 @@ public:
                       << "unregistered state." << std::endl;
             utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
         }
-        segmented_vector::SegmentedVector<Entry> *entries = get_entries(registry);
+        EntryVector *entries = get_entries(registry);
         int state_id = state.get_id().value;
         assert(state.get_id() != StateID::no_state);
         size_t virtual_size = registry->size();
@@ -135,7 +137,7 @@ public:
                       << "unregistered state." << std::endl;
             utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
         }
-        const segmented_vector::SegmentedVector<Entry> *entries = get_entries(registry);
+        const EntryVector *entries = get_entries(registry);
         if (!entries) {
             return default_value;
         }
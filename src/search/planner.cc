@@ -9,6 +9,7 @@
 #include "utils/system.h"
 #include "utils/timer.h"
 
+#include <fstream>
 #include <iostream>
 
 using namespace std;
@@ -27,6 +28,21 @@ int main(int argc, const char **argv) {
         utils::g_log << "reading input..." << endl;
         tasks::read_root_task(cin);
         utils::g_log << "done reading input!" << endl;
+        if (static_cast<string>(argv[1]) == "--write-binary-task") {
+            if (argc != 3) {
+                utils::g_log << usage(argv[0]) << endl;
+                utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+            }
+            ofstream out(argv[2], ios::binary);
+            tasks::write_binary_root_task(out);
+            out.close();
+            if (!out) {
+                cerr << "Could not write binary task to " << argv[2] << endl;
+                utils::exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+            }
+            utils::g_log << "wrote binary task to " << argv[2] << endl;
+            utils::exit_with(ExitCode::SUCCESS);
+        }
         TaskProxy task_proxy(*tasks::g_root_task);
         unit_cost = task_properties::is_unit_cost(task_proxy);
     }
@@ -53,11 +53,14 @@ SearchEngine::SearchEngine(const Options &opts)
       log(utils::get_log_from_options(opts)),
       state_registry(task_proxy),
       successor_generator(get_successor_generator(task_proxy, log)),
-      search_space(state_registry, log),
+      search_space(state_registry, successor_generator,
+                   opts.get<OperatorCost>("cost_type"), log),
       statistics(log),
       cost_type(opts.get<OperatorCost>("cost_type")),
       is_unit_cost(task_properties::is_unit_cost(task_proxy)),
-      max_time(opts.get<double>("max_time")) {
+      max_time(opts.get<double>("max_time")),
+      max_search_space_bytes(numeric_limits<size_t>::max()),
+      stop_requested(false) {
     if (opts.get<int>("bound") < 0) {
         cerr << "error: negative cost bound " << opts.get<int>("bound") << endl;
         utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
@@ -343,6 +346,16 @@ void SearchEngine::search() {
             status = TIMEOUT;
             break;
         }
+        if (search_space.get_num_bytes() > max_search_space_bytes) {
+            log << "Memory limit reached. Abort search." << endl;
+            status = TIMEOUT;
+            break;
+        }
+        if (stop_requested) {
+            log << "Search stopped on request." << endl;
+            status = TIMEOUT;
+            break;
+        }
     }
     // TODO: Revise when and which search times are logged.
     log << "Actual search time: " << timer.get_elapsed_time() << endl;
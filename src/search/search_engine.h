@@ -12,6 +12,7 @@
 
 #include "utils/logging.h"
 
+#include <atomic>
 #include <vector>
 #include <string>
 
@@ -77,10 +78,10 @@ protected:
     TaskProxy task_proxy;
     std::string shared_memory_name;
     // std::vector<std::vector<std::string>> previous_states_names;
-    StringVectorVector *previous_states_names;
-    VecIntSet *previous_states_set;
-    bip::managed_shared_memory* previous_states_segment;
-    VoidAllocator* previous_states_alloc_inst;
+    StringVectorVector *previous_states_names = nullptr;
+    VecIntSet *previous_states_set = nullptr;
+    bip::managed_shared_memory* previous_states_segment = nullptr;
+    VoidAllocator* previous_states_alloc_inst = nullptr;
     std::set<std::vector<int>> previous_state_values;
     std::vector<std::vector<FactProxy>> previous_states_facts;
     std::set<std::vector<int>> previous_states;
@@ -97,6 +98,9 @@ protected:
     OperatorCost cost_type;
     bool is_unit_cost;
     double max_time;
+    // Limit for the memory of the search space (see SearchSpace::get_num_bytes).
+    std::size_t max_search_space_bytes;
+    std::atomic<bool> stop_requested;
 
     virtual void initialize();
     virtual SearchStatus step() = 0;
@@ -116,6 +120,14 @@ public:
     const SearchStatistics &get_statistics() const {return statistics;}
     void set_bound(int b) {bound = b;}
     int get_bound() {return bound;}
+    void set_max_time(double time) {max_time = time;}
+    void set_max_search_space_bytes(std::size_t bytes) {max_search_space_bytes = bytes;}
+    /*
+      Let the search stop after the current step as if it had reached its
+      time limit. Unlike all other methods, this can be called while
+      search() runs in another thread.
+    */
+    void request_stop() {stop_requested = true;}
     PlanManager &get_plan_manager() {return plan_manager;}
     void set_shared_memory_name(std::string shared_memory_name) { this->shared_memory_name = shared_memory_name; }
     void set_no_cache(bool no_cache) { this->no_cache = no_cache; }
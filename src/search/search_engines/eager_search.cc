@@ -10,6 +10,8 @@
 #include "../task_utils/successor_generator.h"
 
 #include "../utils/logging.h"
+#include "../utils/memory.h"
+#include "../utils/thread_pool.h"
 
 #include <cassert>
 #include <cstdlib>
@@ -33,11 +35,46 @@ EagerSearch::EagerSearch(const Options &opts)
       f_evaluator(opts.get<shared_ptr<Evaluator>>("f_eval", nullptr)),
       preferred_operator_evaluators(opts.get_list<shared_ptr<Evaluator>>("preferred")),
       lazy_evaluator(opts.get<shared_ptr<Evaluator>>("lazy_evaluator", nullptr)),
-      pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")) {
+      pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")),
+      parallel_evaluator(opts.get<shared_ptr<Evaluator>>("parallel_evaluator", nullptr)),
+      batch_evaluator(opts.get<shared_ptr<Evaluator>>("batch_evaluator", nullptr)) {
     if (lazy_evaluator && !lazy_evaluator->does_cache_estimates()) {
         cerr << "lazy_evaluator must cache its estimates" << endl;
         utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
     }
+    if (parallel_evaluator) {
+        parallel_evaluator_copies =
+            opts.get_list<shared_ptr<Evaluator>>("parallel_evaluator_copies");
+        set<Evaluator *> evals;
+        parallel_evaluator->get_path_dependent_evaluators(evals);
+        if (!evals.empty()) {
+            cerr << "parallel evaluation does not support path-dependent "
+                 << "evaluators" << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+        }
+        for (const shared_ptr<Evaluator> &copy : parallel_evaluator_copies) {
+            if (copy == parallel_evaluator) {
+                cerr << "parallel evaluation needs a separate evaluator "
+                     << "object for each thread" << endl;
+                utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+            }
+        }
+        thread_pool = utils::make_unique_ptr<utils::ThreadPool>(
+            parallel_evaluator_copies.size() + 1);
+        batch_evaluator = nullptr;
+    }
+    if (batch_evaluator) {
+        set<Evaluator *> evals;
+        batch_evaluator->get_path_dependent_evaluators(evals);
+        if (!evals.empty()) {
+            cerr << "batch evaluation does not support path-dependent "
+                 << "evaluators" << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+        }
+    }
+}
+
+EagerSearch::~EagerSearch() {
 }
 
 void EagerSearch::initialize() {
@@ -45,6 +82,10 @@ void EagerSearch::initialize() {
         << (reopen_closed_nodes ? " with" : " without")
         << " reopening closed nodes, (real) bound = " << bound
         << endl;
+    if (thread_pool) {
+        log << "Evaluating successors with " << thread_pool->get_num_threads()
+            << " threads" << endl;
+    }
     assert(open_list);
 
     set<Evaluator *> evals;
@@ -82,6 +123,17 @@ void EagerSearch::initialize() {
         evaluator->notify_initial_state(initial_state);
     }
 
+    /*
+      Evaluate the initial state once with every copy of the parallel
+      evaluator before we start using threads. This way, data that
+      evaluators set up lazily (e.g., per-state caches, which subscribe to
+      the state registry) is not created concurrently.
+    */
+    for (const shared_ptr<Evaluator> &evaluator : parallel_evaluator_copies) {
+        EvaluationContext copy_eval_context(initial_state, 0, true, nullptr);
+        copy_eval_context.get_result(evaluator.get());
+    }
+
     /*
       Note: we consider the initial state as reached by a preferred
       operator.
@@ -196,12 +248,50 @@ SearchStatus EagerSearch::step() {
                                     preferred_operators);
     }
 
-    for (OperatorID op_id : applicable_ops) {
+    /*
+      With parallel or batch evaluation, we generate all successors first
+      and evaluate the new ones concurrently or in one batch. The loop
+      below then handles the successors in the usual order and finds the
+      precomputed estimates in the evaluation contexts, so the search
+      behaves exactly as with one state at a time.
+    */
+    Evaluator *precomputing_evaluator =
+        thread_pool ? parallel_evaluator.get() : batch_evaluator.get();
+    vector<State> succ_states;
+    vector<EvaluationResult> precomputed_results;
+    if (precomputing_evaluator) {
+        OperatorsProxy operators = task_proxy.get_operators();
+        applicable_ops.erase(
+            remove_if(applicable_ops.begin(), applicable_ops.end(),
+                      [&](OperatorID op_id) {
+                          int cost = operators[op_id].get_cost();
+                          return node->get_real_g() + cost >= bound;
+                      }),
+            applicable_ops.end());
+        succ_states.reserve(applicable_ops.size());
+        for (OperatorID op_id : applicable_ops) {
+            succ_states.push_back(
+                state_registry.get_successor_state(s, operators[op_id]));
+        }
+        if (thread_pool) {
+            evaluate_new_successors_in_parallel(
+                *node, succ_states, applicable_ops, preferred_operators,
+                precomputed_results);
+        } else {
+            evaluate_new_successors_in_batch(
+                *node, succ_states, applicable_ops, preferred_operators,
+                precomputed_results);
+        }
+    }
+
+    for (size_t i = 0; i < applicable_ops.size(); ++i) {
+        OperatorID op_id = applicable_ops[i];
         OperatorProxy op = task_proxy.get_operators()[op_id];
         if ((node->get_real_g() + op.get_cost()) >= bound)
             continue;
 
-        State succ_state = state_registry.get_successor_state(s, op);
+        State succ_state = precomputing_evaluator ?
+            succ_states[i] : state_registry.get_successor_state(s, op);
         statistics.inc_generated();
         bool is_preferred = preferred_operators.contains(op_id);
 
@@ -226,6 +316,10 @@ SearchStatus EagerSearch::step() {
 
             EvaluationContext succ_eval_context(
                 succ_state, succ_g, is_preferred, &statistics);
+            if (precomputing_evaluator) {
+                succ_eval_context.store_result(
+                    precomputing_evaluator, precomputed_results[i]);
+            }
             statistics.inc_evaluated_states();
 
             if (open_list->is_dead_end(succ_eval_context)) {
@@ -288,6 +382,74 @@ SearchStatus EagerSearch::step() {
     return IN_PROGRESS;
 }
 
+void EagerSearch::evaluate_new_successors_in_parallel(
+    const SearchNode &node, const vector<State> &succ_states,
+    const vector<OperatorID> &ops,
+    const ordered_set::OrderedSet<OperatorID> &preferred_operators,
+    vector<EvaluationResult> &results) {
+    assert(succ_states.size() == ops.size());
+    vector<int> new_successors;
+    for (size_t i = 0; i < succ_states.size(); ++i) {
+        if (search_space.get_node(succ_states[i]).is_new()) {
+            new_successors.push_back(i);
+        }
+    }
+
+    results.assign(succ_states.size(), EvaluationResult());
+    OperatorsProxy operators = task_proxy.get_operators();
+    thread_pool->run(
+        new_successors.size(),
+        [&](int task_id, int thread_id) {
+            int i = new_successors[task_id];
+            Evaluator *evaluator = (thread_id == 0) ?
+                parallel_evaluator.get() :
+                parallel_evaluator_copies[thread_id - 1].get();
+            int succ_g = node.get_g() + get_adjusted_cost(operators[ops[i]]);
+            EvaluationContext eval_context(
+                succ_states[i], succ_g, preferred_operators.contains(ops[i]),
+                nullptr);
+            results[i] = eval_context.get_result(evaluator);
+        });
+
+    /*
+      Let the search thread's evaluator cache the estimates computed by the
+      other threads, so that evaluating the successors again (e.g. when they
+      are expanded) does not recompute them.
+    */
+    for (int i : new_successors) {
+        parallel_evaluator->cache_estimate(
+            succ_states[i], results[i].get_evaluator_value());
+    }
+}
+
+void EagerSearch::evaluate_new_successors_in_batch(
+    const SearchNode &node, const vector<State> &succ_states,
+    const vector<OperatorID> &ops,
+    const ordered_set::OrderedSet<OperatorID> &preferred_operators,
+    vector<EvaluationResult> &results) {
+    assert(succ_states.size() == ops.size());
+    vector<int> new_successors;
+    vector<EvaluationContext> eval_contexts;
+    eval_contexts.reserve(succ_states.size());
+    OperatorsProxy operators = task_proxy.get_operators();
+    for (size_t i = 0; i < succ_states.size(); ++i) {
+        if (search_space.get_node(succ_states[i]).is_new()) {
+            new_successors.push_back(i);
+            int succ_g = node.get_g() + get_adjusted_cost(operators[ops[i]]);
+            eval_contexts.emplace_back(
+                succ_states[i], succ_g, preferred_operators.contains(ops[i]),
+                nullptr);
+        }
+    }
+
+    vector<EvaluationResult> batch_results;
+    batch_evaluator->compute_results(eval_contexts, batch_results);
+    results.assign(succ_states.size(), EvaluationResult());
+    for (size_t j = 0; j < new_successors.size(); ++j) {
+        results[new_successors[j]] = batch_results[j];
+    }
+}
+
 void EagerSearch::reward_progress() {
     // Boost the "preferred operator" open lists somewhat whenever
     // one of the heuristics finds a state with a new best h value.
@@ -15,6 +15,10 @@ class OptionParser;
 class Options;
 }
 
+namespace utils {
+class ThreadPool;
+}
+
 namespace eager_search {
 class EagerSearch : public SearchEngine {
     const bool reopen_closed_nodes;
@@ -28,6 +32,34 @@ class EagerSearch : public SearchEngine {
 
     std::shared_ptr<PruningMethod> pruning_method;
 
+    /*
+      If parallel_evaluator is set, the new successors of an expanded state
+      are evaluated with it concurrently. Thread 0 (the search thread) uses
+      parallel_evaluator itself and thread i > 0 uses
+      parallel_evaluator_copies[i - 1], so threads never share evaluator data.
+    */
+    std::shared_ptr<Evaluator> parallel_evaluator;
+    std::vector<std::shared_ptr<Evaluator>> parallel_evaluator_copies;
+    std::unique_ptr<utils::ThreadPool> thread_pool;
+
+    /*
+      If batch_evaluator is set (and parallel_evaluator is not), the new
+      successors of an expanded state are evaluated with it in a single
+      call to Evaluator::compute_results.
+    */
+    std::shared_ptr<Evaluator> batch_evaluator;
+
+    void evaluate_new_successors_in_parallel(
+        const SearchNode &node, const std::vector<State> &succ_states,
+        const std::vector<OperatorID> &ops,
+        const ordered_set::OrderedSet<OperatorID> &preferred_operators,
+        std::vector<EvaluationResult> &results);
+    void evaluate_new_successors_in_batch(
+        const SearchNode &node, const std::vector<State> &succ_states,
+        const std::vector<OperatorID> &ops,
+        const ordered_set::OrderedSet<OperatorID> &preferred_operators,
+        std::vector<EvaluationResult> &results);
+
     void start_f_value_statistics(EvaluationContext &eval_context);
     void update_f_value_statistics(EvaluationContext &eval_context);
     void reward_progress();
@@ -38,7 +70,7 @@ protected:
 
 public:
     explicit EagerSearch(const options::Options &opts);
-    virtual ~EagerSearch() = default;
+    virtual ~EagerSearch() override;
 
     virtual void print_statistics() const override;
 
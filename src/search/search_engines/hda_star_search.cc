@@ -0,0 +1,431 @@
+#include "hda_star_search.h"
+
+#include "search_common.h"
+
+#include "../evaluation_context.h"
+#include "../evaluator.h"
+#include "../open_list_factory.h"
+#include "../option_parser.h"
+#include "../per_state_information.h"
+#include "../plugin.h"
+
+#include "../algorithms/mpsc_queue.h"
+#include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
+#include "../utils/countdown_timer.h"
+#include "../utils/hash.h"
+#include "../utils/logging.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <thread>
+
+using namespace std;
+
+namespace hda_star_search {
+static const int INF = numeric_limits<int>::max();
+
+struct NodeInfo {
+    enum NodeStatus {NEW = 0, OPEN = 1, CLOSED = 2, DEAD_END = 3};
+
+    NodeStatus status;
+    int g;
+    int real_g;
+    int h;
+    /*
+      The parent of a state can be owned by another worker, so we store the
+      worker together with the ID in that worker's registry.
+    */
+    int parent_worker;
+    StateID parent_id;
+    OperatorID creating_operator;
+
+    NodeInfo()
+        : status(NEW), g(-1), real_g(-1), h(-1), parent_worker(-1),
+          parent_id(StateID::no_state), creating_operator(-1) {
+    }
+};
+
+struct StateMessage {
+    vector<PackedStateBin> buffer;
+    int g;
+    int real_g;
+    int parent_worker;
+    StateID parent_id;
+    OperatorID creating_operator;
+
+    StateMessage(vector<PackedStateBin> &&buffer, int g, int real_g,
+                 int parent_worker, StateID parent_id,
+                 OperatorID creating_operator)
+        : buffer(move(buffer)), g(g), real_g(real_g),
+          parent_worker(parent_worker), parent_id(parent_id),
+          creating_operator(creating_operator) {
+    }
+};
+
+struct Worker {
+    StateRegistry registry;
+    shared_ptr<Evaluator> eval;
+    unique_ptr<StateOpenList> open_list;
+    PerStateInformation<NodeInfo> node_infos;
+    mpsc_queue::MPSCQueue<StateMessage> inbox;
+    SearchStatistics statistics;
+
+    StateID goal_id;
+    int goal_cost;
+
+    // Scratch space reused between expansions.
+    vector<OperatorID> applicable_ops;
+    vector<PackedStateBin> succ_buffer;
+
+    Worker(const TaskProxy &task_proxy, const shared_ptr<Evaluator> &eval,
+           unique_ptr<StateOpenList> open_list, utils::LogProxy &log)
+        : registry(task_proxy),
+          eval(eval),
+          open_list(move(open_list)),
+          statistics(log),
+          goal_id(StateID::no_state),
+          goal_cost(INF),
+          succ_buffer(registry.get_state_packer().get_num_bins()) {
+    }
+};
+
+HDAStarSearch::HDAStarSearch(const Options &opts)
+    : SearchEngine(opts),
+      num_active(0),
+      incumbent_cost(INF),
+      timed_out(false) {
+    task_properties::verify_no_axioms(task_proxy);
+    for (const shared_ptr<Evaluator> &eval :
+         opts.get_list<shared_ptr<Evaluator>>("evals")) {
+        set<Evaluator *> path_dependent_evals;
+        eval->get_path_dependent_evaluators(path_dependent_evals);
+        if (!path_dependent_evals.empty()) {
+            cerr << "hdastar does not support path-dependent evaluators"
+                 << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+        }
+        Options open_list_opts;
+        open_list_opts.set("eval", eval);
+        open_list_opts.set<utils::Verbosity>(
+            "verbosity", opts.get<utils::Verbosity>("verbosity"));
+        shared_ptr<OpenListFactory> open_list_factory =
+            search_common::create_astar_open_list_factory_and_f_eval(
+                open_list_opts).first;
+        workers.push_back(utils::make_unique_ptr<Worker>(
+                              task_proxy, eval,
+                              open_list_factory->create_state_open_list(),
+                              log));
+    }
+}
+
+HDAStarSearch::~HDAStarSearch() {
+}
+
+int HDAStarSearch::get_owner(const PackedStateBin *buffer) const {
+    utils::HashState hash_state;
+    int num_bins = state_registry.get_state_packer().get_num_bins();
+    for (int i = 0; i < num_bins; ++i) {
+        hash_state.feed(buffer[i]);
+    }
+    /*
+      The hash tables of the state registries use the low bits of the same
+      hash, so we use the high bits to pick the owner. Otherwise, all states
+      of a worker would map to a fraction of the buckets of its hash table.
+    */
+    uint64_t hash = hash_state.get_hash32();
+    return static_cast<int>((hash * workers.size()) >> 32);
+}
+
+void HDAStarSearch::update_incumbent(Worker &worker, StateID goal_id, int cost) {
+    if (cost < worker.goal_cost) {
+        worker.goal_id = goal_id;
+        worker.goal_cost = cost;
+    }
+    int incumbent = incumbent_cost.load();
+    while (cost < incumbent &&
+           !incumbent_cost.compare_exchange_weak(incumbent, cost)) {
+    }
+}
+
+void HDAStarSearch::receive_state(
+    Worker &worker, const PackedStateBin *buffer, int g, int real_g,
+    int parent_worker, StateID parent_id, OperatorID creating_operator) {
+    // Heuristic values are non-negative, so f >= g.
+    if (g >= incumbent_cost.load(memory_order_relaxed)) {
+        return;
+    }
+    State state = worker.registry.insert_packed_state(buffer);
+    NodeInfo &info = worker.node_infos[state];
+    if (info.status == NodeInfo::DEAD_END ||
+        (info.status != NodeInfo::NEW && info.g <= g)) {
+        return;
+    }
+
+    EvaluationContext eval_context(state, g, false, &worker.statistics);
+    if (info.status == NodeInfo::NEW) {
+        worker.statistics.inc_evaluated_states();
+        if (worker.open_list->is_dead_end(eval_context)) {
+            info.status = NodeInfo::DEAD_END;
+            worker.statistics.inc_dead_ends();
+            return;
+        }
+        info.h = eval_context.get_evaluator_value(worker.eval.get());
+    } else {
+        if (info.status == NodeInfo::CLOSED) {
+            worker.statistics.inc_reopened();
+        }
+        // Reuse the heuristic value instead of evaluating the state again.
+        EvaluationResult result;
+        result.set_evaluator_value(info.h);
+        result.set_count_evaluation(false);
+        eval_context.store_result(worker.eval.get(), result);
+    }
+
+    info.status = NodeInfo::OPEN;
+    info.g = g;
+    info.real_g = real_g;
+    info.parent_worker = parent_worker;
+    info.parent_id = parent_id;
+    info.creating_operator = creating_operator;
+    if (g + info.h < incumbent_cost.load(memory_order_relaxed)) {
+        worker.open_list->insert(eval_context, state.get_id());
+    }
+}
+
+void HDAStarSearch::expand(int worker_id, StateID id) {
+    Worker &worker = *workers[worker_id];
+    State state = worker.registry.lookup_state(id);
+    NodeInfo &info = worker.node_infos[state];
+    /*
+      States that are reached again with a lower g value are inserted into
+      the open list again, so we can encounter outdated entries here.
+    */
+    if (info.status != NodeInfo::OPEN ||
+        info.g + info.h >= incumbent_cost.load(memory_order_relaxed)) {
+        return;
+    }
+    info.status = NodeInfo::CLOSED;
+    worker.statistics.inc_expanded();
+
+    if (task_properties::is_goal_state(task_proxy, state)) {
+        update_incumbent(worker, id, info.g);
+        return;
+    }
+
+    worker.applicable_ops.clear();
+    successor_generator.generate_applicable_ops(state, worker.applicable_ops);
+    worker.statistics.inc_generated_ops(worker.applicable_ops.size());
+
+    const int_packer::IntPacker &state_packer =
+        worker.registry.get_state_packer();
+    OperatorsProxy operators = task_proxy.get_operators();
+    for (OperatorID op_id : worker.applicable_ops) {
+        OperatorProxy op = operators[op_id];
+        int succ_real_g = info.real_g + op.get_cost();
+        if (succ_real_g >= bound) {
+            continue;
+        }
+        int succ_g = info.g + get_adjusted_cost(op);
+
+        PackedStateBin *buffer = worker.succ_buffer.data();
+        copy_n(state.get_buffer(), worker.succ_buffer.size(), buffer);
+        for (EffectProxy effect : op.get_effects()) {
+            if (does_fire(effect, state)) {
+                FactPair effect_fact = effect.get_fact().get_pair();
+                state_packer.set(buffer, effect_fact.var, effect_fact.value);
+            }
+        }
+        worker.statistics.inc_generated();
+
+        int owner = get_owner(buffer);
+        if (owner == worker_id) {
+            receive_state(worker, buffer, succ_g, succ_real_g,
+                          worker_id, id, op_id);
+        } else {
+            // Count the message as active before it becomes visible.
+            num_active.fetch_add(1);
+            workers[owner]->inbox.push(
+                StateMessage(vector<PackedStateBin>(worker.succ_buffer),
+                             succ_g, succ_real_g, worker_id, id, op_id));
+        }
+    }
+}
+
+void HDAStarSearch::run_worker(int worker_id, const utils::CountdownTimer &timer) {
+    Worker &worker = *workers[worker_id];
+    vector<StateMessage> messages;
+    int num_expansions = 0;
+    while (!timed_out.load(memory_order_relaxed)) {
+        worker.inbox.pop_all(messages);
+        for (const StateMessage &message : messages) {
+            receive_state(worker, message.buffer.data(), message.g,
+                          message.real_g, message.parent_worker,
+                          message.parent_id, message.creating_operator);
+        }
+        num_active.fetch_sub(messages.size());
+        messages.clear();
+
+        if (!worker.open_list->empty()) {
+            expand(worker_id, worker.open_list->remove_min());
+            if (++num_expansions % 1000 == 0 && timer.is_expired()) {
+                timed_out = true;
+            }
+        } else {
+            // Wait until we receive a message or all workers are idle.
+            num_active.fetch_sub(1);
+            while (worker.inbox.empty()) {
+                if (num_active.load() == 0 ||
+                    timed_out.load(memory_order_relaxed)) {
+                    return;
+                }
+                this_thread::yield();
+            }
+            num_active.fetch_add(1);
+        }
+    }
+}
+
+void HDAStarSearch::extract_plan() {
+    int goal_worker = -1;
+    for (size_t i = 0; i < workers.size(); ++i) {
+        if (workers[i]->goal_cost == incumbent_cost.load()) {
+            goal_worker = i;
+            break;
+        }
+    }
+    assert(goal_worker != -1);
+
+    Plan plan;
+    int worker_id = goal_worker;
+    StateID id = workers[goal_worker]->goal_id;
+    while (true) {
+        Worker &worker = *workers[worker_id];
+        const NodeInfo &info =
+            worker.node_infos[worker.registry.lookup_state(id)];
+        if (info.creating_operator == OperatorID::no_operator) {
+            assert(info.parent_id == StateID::no_state);
+            break;
+        }
+        plan.push_back(info.creating_operator);
+        worker_id = info.parent_worker;
+        id = info.parent_id;
+    }
+    reverse(plan.begin(), plan.end());
+    set_plan(plan);
+}
+
+SearchStatus HDAStarSearch::step() {
+    int num_workers = workers.size();
+    log << "Conducting hash-distributed A* search with " << num_workers
+        << " threads, (real) bound = " << bound << endl;
+
+    const State &initial_state = state_registry.get_initial_state();
+    int initial_owner = get_owner(initial_state.get_buffer());
+    vector<PackedStateBin> initial_buffer(
+        initial_state.get_buffer(),
+        initial_state.get_buffer() + state_registry.get_state_packer().get_num_bins());
+    num_active = num_workers + 1;
+    workers[initial_owner]->inbox.push(
+        StateMessage(move(initial_buffer), 0, 0, -1, StateID::no_state,
+                     OperatorID::no_operator));
+
+    utils::CountdownTimer timer(max_time);
+    vector<thread> threads;
+    for (int worker_id = 0; worker_id < num_workers; ++worker_id) {
+        threads.emplace_back(&HDAStarSearch::run_worker, this, worker_id,
+                             cref(timer));
+    }
+    for (thread &t : threads) {
+        t.join();
+    }
+
+    for (const unique_ptr<Worker> &worker : workers) {
+        statistics.inc_expanded(worker->statistics.get_expanded());
+        statistics.inc_evaluated_states(worker->statistics.get_evaluated_states());
+        statistics.inc_evaluations(worker->statistics.get_evaluations());
+        statistics.inc_generated(worker->statistics.get_generated());
+        statistics.inc_reopened(worker->statistics.get_reopened());
+        statistics.inc_generated_ops(worker->statistics.get_generated_ops());
+        statistics.inc_dead_ends(worker->statistics.get_dead_ends());
+    }
+
+    if (timed_out) {
+        log << "Time limit reached. Abort search." << endl;
+        return TIMEOUT;
+    }
+    if (incumbent_cost.load() == INF) {
+        log << "Completely explored state space -- no solution!" << endl;
+        return FAILED;
+    }
+    log << "Solution found!" << endl;
+    extract_plan();
+    return SOLVED;
+}
+
+void HDAStarSearch::print_statistics() const {
+    statistics.print_detailed_statistics();
+    int num_registered_states = 0;
+    for (size_t i = 0; i < workers.size(); ++i) {
+        const Worker &worker = *workers[i];
+        log << "Worker " << i << ": " << worker.statistics.get_expanded()
+            << " expanded, " << worker.registry.size()
+            << " registered states" << endl;
+        num_registered_states += worker.registry.size();
+    }
+    log << "Number of registered states: " << num_registered_states << endl;
+}
+
+static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Hash-distributed A* search",
+        "Parallel A* that distributes states over threads by the hash of "
+        "their packed data (Kishimoto, Fukunaga and Botea, ICAPS 2009). "
+        "Each thread owns the states that hash to it and expands them in "
+        "the order of its own open list (f = g + h, ties broken by h). "
+        "Closed nodes are re-opened.");
+    parser.document_note(
+        "Heuristic instances",
+        "Each thread uses its own instance of the heuristic, which is "
+        "created by parsing the configuration of eval once per thread. "
+        "Therefore, eval must be given inline rather than as a "
+        "predefinition, and its components must not be predefined either. "
+        "Path-dependent evaluators are not supported.");
+    parser.document_note(
+        "Optimality",
+        "With an admissible heuristic, the returned plan is optimal. The "
+        "search terminates only when no thread holds a state whose f value "
+        "is lower than the cost of the best plan found so far.");
+    parser.document_language_support("axioms", "not supported");
+    parser.document_language_support("conditional effects", "supported");
+
+    parser.add_option<shared_ptr<Evaluator>>("eval", "evaluator for h-value");
+    parser.add_option<int>(
+        "threads",
+        "number of worker threads",
+        "1",
+        Bounds("1", "infinity"));
+    SearchEngine::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    shared_ptr<HDAStarSearch> engine;
+    if (!parser.dry_run()) {
+        vector<shared_ptr<Evaluator>> evals = {
+            opts.get<shared_ptr<Evaluator>>("eval")};
+        int num_threads = opts.get<int>("threads");
+        if (num_threads > 1) {
+            vector<shared_ptr<Evaluator>> copies =
+                search_common::create_evaluator_copies(
+                    parser, "eval", 0, num_threads - 1);
+            evals.insert(evals.end(), copies.begin(), copies.end());
+        }
+        opts.set("evals", evals);
+        engine = make_shared<HDAStarSearch>(opts);
+    }
+    return engine;
+}
+
+static Plugin<SearchEngine> _plugin("hdastar", _parse);
+}
@@ -0,0 +1,70 @@
+#ifndef SEARCH_ENGINES_HDA_STAR_SEARCH_H
+#define SEARCH_ENGINES_HDA_STAR_SEARCH_H
+
+#include "../search_engine.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace options {
+class Options;
+}
+
+namespace utils {
+class CountdownTimer;
+}
+
+namespace hda_star_search {
+struct Worker;
+
+/*
+  Hash-distributed A* (Kishimoto, Fukunaga and Botea, ICAPS 2009).
+
+  Each worker thread owns a shard of the state space, consisting of its own
+  state registry, open list and per-state search information. The owner of
+  a state is determined by a hash of its packed data. Successors owned by
+  other workers are sent to them through lock-free message queues, so the
+  workers never access each other's shards. Every worker evaluates states
+  with its own instance of the heuristic.
+
+  Workers prune states whose f value is not lower than the cost of the best
+  plan found so far. The search ends when all workers are idle and no
+  messages are in flight, so with an admissible heuristic the best plan
+  found is optimal. Parent pointers can cross shards and are followed after
+  all workers have finished to extract the plan.
+*/
+class HDAStarSearch : public SearchEngine {
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    /*
+      Number of workers that are not idle plus the number of messages that
+      have been sent but not processed yet. Idle workers only become active
+      again when they receive a message, so once num_active drops to zero it
+      stays zero and the search is finished.
+    */
+    std::atomic<int> num_active;
+    std::atomic<int> incumbent_cost;
+    std::atomic<bool> timed_out;
+
+    int get_owner(const PackedStateBin *buffer) const;
+    void update_incumbent(Worker &worker, StateID goal_id, int cost);
+    void receive_state(
+        Worker &worker, const PackedStateBin *buffer, int g, int real_g,
+        int parent_worker, StateID parent_id, OperatorID creating_operator);
+    void expand(int worker_id, StateID id);
+    void run_worker(int worker_id, const utils::CountdownTimer &timer);
+    void extract_plan();
+
+protected:
+    virtual SearchStatus step() override;
+
+public:
+    explicit HDAStarSearch(const options::Options &opts);
+    virtual ~HDAStarSearch() override;
+
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
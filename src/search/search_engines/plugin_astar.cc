@@ -1,6 +1,7 @@
 #include "eager_search.h"
 #include "search_common.h"
 
+#include "../evaluator.h"
 #include "../option_parser.h"
 #include "../plugin.h"
 
@@ -32,6 +33,34 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
         "lazy_evaluator",
         "An evaluator that re-evaluates a state before it is expanded.",
         OptionParser::NONE);
+    parser.add_option<bool>(
+        "bucket_open_list",
+        "use a bucket-based open list (bucket_tiebreaking) instead of "
+        "tiebreaking. Both expand states in the same order, but the "
+        "bucket-based one needs the g and h values to be small integers.",
+        "false");
+    parser.add_option<int>(
+        "evaluation_threads",
+        "number of threads used for evaluating the successors of an expanded "
+        "state with eval. Each thread uses its own instance of eval, so eval "
+        "must not be a predefined evaluator when using more than one thread.",
+        "1",
+        Bounds("1", "infinity"));
+    parser.document_note(
+        "evaluation_threads",
+        "Successor states are still registered and inserted into the open "
+        "list by a single thread in the usual order, so the search behaves "
+        "exactly as with one thread. Parallel evaluation only pays off if "
+        "evaluating eval dominates the cost of an expansion, e.g. for lmcut(). "
+        "Evaluator instances must not share mutable data, so components "
+        "of eval must not be predefined either. Path-dependent evaluators "
+        "are not supported.");
+    parser.document_note(
+        "Batch evaluation",
+        "With a single evaluation thread, the new successors of an expanded "
+        "state are evaluated in one batch if eval supports it (currently "
+        "pdb(), cpdbs() and zopdbs()). This computes the same estimates as "
+        "evaluating the successors one by one, but faster.");
 
     eager_search::add_options_to_parser(parser);
     Options opts = parser.parse();
@@ -44,6 +73,18 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
         opts.set("reopen_closed", true);
         vector<shared_ptr<Evaluator>> preferred_list;
         opts.set("preferred", preferred_list);
+        int num_threads = opts.get<int>("evaluation_threads");
+        if (num_threads > 1) {
+            opts.set("parallel_evaluator", opts.get<shared_ptr<Evaluator>>("eval"));
+            opts.set("parallel_evaluator_copies",
+                     search_common::create_evaluator_copies(
+                         parser, "eval", 0, num_threads - 1));
+        } else {
+            shared_ptr<Evaluator> eval = opts.get<shared_ptr<Evaluator>>("eval");
+            if (eval->supports_batch_evaluation()) {
+                opts.set("batch_evaluator", eval);
+            }
+        }
         engine = make_shared<eager_search::EagerSearch>(opts);
     }
 
@@ -0,0 +1,232 @@
+#include "portfolio_search.h"
+
+#include "../option_parser.h"
+#include "../plugin.h"
+
+#include "../utils/countdown_timer.h"
+#include "../utils/logging.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+using namespace std;
+
+namespace portfolio_search {
+PortfolioSearch::PortfolioSearch(
+    const Options &opts, options::Registry &registry,
+    const options::Predefinitions &predefinitions)
+    : SearchEngine(opts),
+      engine_configs(opts.get_list<ParseTree>("engine_configs")),
+      relative_times(opts.get_list<int>("relative_times")),
+      registry(registry),
+      predefinitions(predefinitions),
+      optimal(opts.get<bool>("optimal")),
+      num_threads(opts.get<int>("threads")),
+      component_max_bytes(opts.get<size_t>("component_max_bytes")),
+      next_component(0),
+      remaining_relative_time(0),
+      best_bound(bound),
+      stopped(false) {
+    for (int relative_time : relative_times) {
+        remaining_relative_time += relative_time;
+    }
+}
+
+shared_ptr<SearchEngine> PortfolioSearch::start_next_component(
+    int thread_id, const utils::CountdownTimer &timer) {
+    lock_guard<std::mutex> lock(mutex);
+    int num_components = engine_configs.size();
+    double remaining_time = timer.get_remaining_time();
+    if (stopped || next_component == num_components || remaining_time <= 0) {
+        return nullptr;
+    }
+    int index = next_component++;
+    int relative_time = relative_times[index];
+    /*
+      Timers measure the CPU time of the whole process, which passes
+      num_threads times as fast as long as all threads are busy. For the
+      last component we have relative_time == remaining_relative_time, so
+      it can use all of the remaining time.
+    */
+    double component_time = min(
+        remaining_time,
+        remaining_time * relative_time / remaining_relative_time * num_threads);
+    remaining_relative_time -= relative_time;
+
+    ostringstream stream;
+    kptree::print_tree_bracketed(engine_configs[index], stream);
+    log << "Starting portfolio component " << index << " with time limit "
+        << component_time << "s: " << stream.str() << endl;
+
+    OptionParser parser(engine_configs[index], registry, predefinitions, false);
+    shared_ptr<SearchEngine> component =
+        parser.start_parsing<shared_ptr<SearchEngine>>();
+    component->set_bound(best_bound);
+    component->set_max_time(component_time);
+    component->set_max_search_space_bytes(component_max_bytes);
+    running_components[thread_id] = component;
+    return component;
+}
+
+void PortfolioSearch::finish_component(int thread_id, SearchEngine &component) {
+    lock_guard<std::mutex> lock(mutex);
+    running_components[thread_id] = nullptr;
+    if (component.found_solution()) {
+        const Plan &found_plan = component.get_plan();
+        int plan_cost = calculate_plan_cost(found_plan, task_proxy);
+        if (plan_cost < best_bound) {
+            plan_manager.save_plan(found_plan, task_proxy, !optimal);
+            best_bound = plan_cost;
+            set_plan(found_plan);
+            log << "Best solution cost so far: " << best_bound << endl;
+        }
+        if (optimal && !stopped) {
+            log << "Solution found - stop portfolio" << endl;
+            stopped = true;
+            for (const shared_ptr<SearchEngine> &other : running_components) {
+                if (other) {
+                    other->request_stop();
+                }
+            }
+        }
+    }
+    component.print_statistics();
+
+    const SearchStatistics &component_stats = component.get_statistics();
+    statistics.inc_expanded(component_stats.get_expanded());
+    statistics.inc_evaluated_states(component_stats.get_evaluated_states());
+    statistics.inc_evaluations(component_stats.get_evaluations());
+    statistics.inc_generated(component_stats.get_generated());
+    statistics.inc_generated_ops(component_stats.get_generated_ops());
+    statistics.inc_reopened(component_stats.get_reopened());
+}
+
+void PortfolioSearch::run_thread(
+    int thread_id, const utils::CountdownTimer &timer) {
+    while (shared_ptr<SearchEngine> component =
+               start_next_component(thread_id, timer)) {
+        component->search();
+        finish_component(thread_id, *component);
+    }
+}
+
+SearchStatus PortfolioSearch::step() {
+    log << "Running portfolio of " << engine_configs.size()
+        << " search engines with " << num_threads << " thread(s)" << endl;
+    utils::CountdownTimer timer(max_time);
+    running_components.resize(num_threads);
+    if (num_threads == 1) {
+        run_thread(0, timer);
+    } else {
+        vector<thread> threads;
+        for (int thread_id = 0; thread_id < num_threads; ++thread_id) {
+            threads.emplace_back(&PortfolioSearch::run_thread, this,
+                                 thread_id, cref(timer));
+        }
+        for (thread &t : threads) {
+            t.join();
+        }
+    }
+    return found_solution() ? SOLVED : FAILED;
+}
+
+void PortfolioSearch::print_statistics() const {
+    log << "Cumulative statistics:" << endl;
+    statistics.print_detailed_statistics();
+}
+
+void PortfolioSearch::save_plan_if_necessary() {
+    // We don't need to save here, as we save each improved plan right away.
+}
+
+static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Portfolio search",
+        "Runs the given search engines one after the other (or several at "
+        "the same time with threads > 1) in this process, so all of them "
+        "share the task and the data computed for it, e.g., the successor "
+        "generator and the causal graph. Each engine gets the share of the "
+        "remaining time (max_time) given by its relative time, like the "
+        "portfolios of the driver, and the cost of the best plan found so "
+        "far as its bound.");
+    parser.document_note(
+        "Threads",
+        "With threads > 1, the engines that run at the same time must not "
+        "share evaluators, so evaluators must not be predefined. The "
+        "max_time of the portfolio is measured in CPU time of the whole "
+        "process, so it is used up faster with several threads. Output of "
+        "concurrent engines is interleaved.");
+    parser.document_note(
+        "Memory",
+        "component_max_bytes limits the memory of each engine for its "
+        "registered states and search nodes. An engine that exceeds it stops "
+        "like after reaching its time limit. Memory for evaluators is not "
+        "counted.");
+    parser.add_list_option<ParseTree>(
+        "engine_configs", "search engines of the portfolio in order");
+    parser.add_list_option<int>(
+        "relative_times",
+        "relative time of each engine (default: 1 for all engines)",
+        "[]");
+    parser.add_option<bool>(
+        "optimal",
+        "stop after the first engine that finds a solution. Otherwise, "
+        "continue with the remaining engines to find cheaper plans.",
+        "false");
+    parser.add_option<int>(
+        "threads",
+        "number of engines that run at the same time",
+        "1",
+        Bounds("1", "infinity"));
+    parser.add_option<int>(
+        "component_memory",
+        "memory limit in MiB for registered states and search nodes of "
+        "each engine",
+        "infinity",
+        Bounds("1", "infinity"));
+    SearchEngine::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    opts.verify_list_non_empty<ParseTree>("engine_configs");
+    if (parser.help_mode()) {
+        return nullptr;
+    }
+
+    int num_engines = opts.get_list<ParseTree>("engine_configs").size();
+    vector<int> relative_times = opts.get_list<int>("relative_times");
+    if (relative_times.empty()) {
+        relative_times.assign(num_engines, 1);
+    } else if (static_cast<int>(relative_times.size()) != num_engines) {
+        parser.error("need one relative time per search engine");
+    }
+    if (any_of(relative_times.begin(), relative_times.end(),
+               [](int time) {return time <= 0;})) {
+        parser.error("relative times must be positive");
+    }
+    opts.set("relative_times", relative_times);
+
+    int component_memory = opts.get<int>("component_memory");
+    size_t component_max_bytes = numeric_limits<size_t>::max();
+    if (component_memory != numeric_limits<int>::max()) {
+        component_max_bytes = static_cast<size_t>(component_memory) << 20;
+    }
+    opts.set("component_max_bytes", component_max_bytes);
+
+    if (parser.dry_run()) {
+        //check if the supplied search engines can be parsed
+        for (const ParseTree &config : opts.get_list<ParseTree>("engine_configs")) {
+            OptionParser test_parser(config, parser.get_registry(),
+                                     parser.get_predefinitions(), true);
+            test_parser.start_parsing<shared_ptr<SearchEngine>>();
+        }
+        return nullptr;
+    } else {
+        return make_shared<PortfolioSearch>(opts, parser.get_registry(),
+                                            parser.get_predefinitions());
+    }
+}
+
+static Plugin<SearchEngine> _plugin("portfolio", _parse);
+}
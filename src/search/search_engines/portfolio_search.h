@@ -0,0 +1,71 @@
+#ifndef SEARCH_ENGINES_PORTFOLIO_SEARCH_H
+#define SEARCH_ENGINES_PORTFOLIO_SEARCH_H
+
+#include "../option_parser_util.h"
+#include "../search_engine.h"
+
+#include "../options/registries.h"
+#include "../options/predefinitions.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace options {
+class Options;
+}
+
+namespace utils {
+class CountdownTimer;
+}
+
+namespace portfolio_search {
+/*
+  Run a portfolio of search engines in this process, as the driver does for
+  portfolio files with one planner call per component. All components share
+  the root task and everything computed for it, e.g., the successor
+  generator and the causal graph.
+
+  Components are started in the given order. Each one gets the share of the
+  remaining time given by its relative time and the cost of the best plan
+  found so far as its bound. With several threads, the next component is
+  started as soon as a thread becomes free.
+*/
+class PortfolioSearch : public SearchEngine {
+    const std::vector<options::ParseTree> engine_configs;
+    const std::vector<int> relative_times;
+    /*
+      We need to copy the registry and predefinitions here since they live
+      longer than the objects referenced in the constructor.
+    */
+    options::Registry registry;
+    options::Predefinitions predefinitions;
+    const bool optimal;
+    const int num_threads;
+    const std::size_t component_max_bytes;
+
+    // Protects all members below, the plan manager and the statistics.
+    std::mutex mutex;
+    int next_component;
+    int remaining_relative_time;
+    int best_bound;
+    bool stopped;
+    std::vector<std::shared_ptr<SearchEngine>> running_components;
+
+    std::shared_ptr<SearchEngine> start_next_component(
+        int thread_id, const utils::CountdownTimer &timer);
+    void finish_component(int thread_id, SearchEngine &component);
+    void run_thread(int thread_id, const utils::CountdownTimer &timer);
+
+    virtual SearchStatus step() override;
+
+public:
+    PortfolioSearch(const options::Options &opts, options::Registry &registry,
+                    const options::Predefinitions &predefinitions);
+
+    virtual void save_plan_if_necessary() override;
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
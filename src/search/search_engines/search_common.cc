@@ -1,6 +1,7 @@
 #include "search_common.h"
 
 #include "../open_list_factory.h"
+#include "../option_parser.h"
 #include "../option_parser_util.h"
 
 #include "../evaluators/g_evaluator.h"
@@ -9,6 +10,7 @@
 
 #include "../open_lists/alternation_open_list.h"
 #include "../open_lists/best_first_open_list.h"
+#include "../open_lists/bucket_open_list.h"
 #include "../open_lists/tiebreaking_open_list.h"
 
 #include <memory>
@@ -145,8 +147,49 @@ create_astar_open_list_factory_and_f_eval(const Options &opts) {
     options.set("evals", evals);
     options.set("pref_only", false);
     options.set("unsafe_pruning", false);
-    shared_ptr<OpenListFactory> open =
-        make_shared<tiebreaking_open_list::TieBreakingOpenListFactory>(options);
+    shared_ptr<OpenListFactory> open;
+    if (opts.get<bool>("bucket_open_list", false)) {
+        options.set("lifo", false);
+        open = make_shared<bucket_open_list::BucketOpenListFactory>(options);
+    } else {
+        open = make_shared<tiebreaking_open_list::TieBreakingOpenListFactory>(options);
+    }
     return make_pair(open, f);
 }
+
+vector<shared_ptr<Evaluator>> create_evaluator_copies(
+    OptionParser &parser, const string &key, int position, int num_copies) {
+    const ParseTree &parse_tree = *parser.get_parse_tree();
+    auto arg = end_of_roots_children(parse_tree);
+    int num_positional = 0;
+    for (auto it = first_child_of_root(parse_tree);
+         it != end_of_roots_children(parse_tree); ++it) {
+        if (it->key == key ||
+            (it->key.empty() && num_positional++ == position)) {
+            arg = it;
+            break;
+        }
+    }
+    if (arg == end_of_roots_children(parse_tree)) {
+        parser.error("could not find configuration of " + key);
+    }
+    ParseTree eval_tree = subtree(parse_tree, arg);
+    eval_tree.begin()->key = "";
+    if (parser.get_predefinitions().contains(eval_tree.begin()->value)) {
+        parser.error(
+            "cannot create copies of the predefined evaluator " +
+            eval_tree.begin()->value + " for " + key +
+            "; please specify it inline");
+    }
+
+    vector<shared_ptr<Evaluator>> copies;
+    copies.reserve(num_copies);
+    for (int i = 0; i < num_copies; ++i) {
+        OptionParser eval_parser(
+            eval_tree, parser.get_registry(), parser.get_predefinitions(),
+            parser.dry_run());
+        copies.push_back(eval_parser.start_parsing<shared_ptr<Evaluator>>());
+    }
+    return copies;
+}
 }
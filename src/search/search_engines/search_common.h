@@ -19,11 +19,14 @@
 */
 
 #include <memory>
+#include <string>
+#include <vector>
 
 class Evaluator;
 class OpenListFactory;
 
 namespace options {
+class OptionParser;
 class Options;
 }
 
@@ -73,10 +76,26 @@ extern std::shared_ptr<OpenListFactory> create_wastar_open_list_factory(
 
   The resulting open list factory produces a tie-breaking open list
   ordered primarily on g + h and secondarily on h. Uses "eval" from
-  the passed-in Options object as the h evaluator.
+  the passed-in Options object as the h evaluator. If the optional
+  "bucket_open_list" option is true, the open list is a bucket-based
+  tie-breaking open list with the same order.
 */
 extern std::pair<std::shared_ptr<OpenListFactory>, const std::shared_ptr<Evaluator>>
 create_astar_open_list_factory_and_f_eval(const options::Options &opts);
+
+/*
+  Create num_copies independent instances of the evaluator passed to the
+  plugin that is currently being parsed, by parsing the configuration of the
+  evaluator again. The evaluator is the argument with the given key or, if no
+  argument uses the key, the positional argument with the given index.
+
+  This is used to give each thread its own evaluator object. Since parsing a
+  predefined evaluator returns the predefined object, the evaluator must be
+  specified inline.
+*/
+extern std::vector<std::shared_ptr<Evaluator>> create_evaluator_copies(
+    options::OptionParser &parser, const std::string &key, int position,
+    int num_copies);
 }
 
 #endif
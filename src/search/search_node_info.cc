@@ -1,10 +1,22 @@
 #include "search_node_info.h"
 
-static const int pointer_bytes = sizeof(void *);
-static const int info_bytes = 3 * sizeof(int) + sizeof(StateID);
-static const int padding_bytes = info_bytes % pointer_bytes;
+using namespace std;
 
-static_assert(
-    sizeof(SearchNodeInfo) == info_bytes + padding_bytes,
-    "The size of SearchNodeInfo is larger than expected. This probably means "
-    "that packing two fields into one integer using bitfields is not supported.");
+const int SearchNodeInfo::STATUS_BITS;
+const unsigned int SearchNodeInfo::STATUS_MASK;
+const int SearchNodeInfo::STATUS_AND_G;
+const int SearchNodeInfo::PARENT_STATE_ID;
+const int SearchNodeInfo::REAL_G;
+
+vector<unsigned int> SearchNodeInfo::get_default_data(bool store_real_g) {
+    vector<unsigned int> default_data(store_real_g ? 3 : 2);
+    SearchNodeInfo info(ArrayView<unsigned int>(
+                            default_data.data(), default_data.size()));
+    info.set_status(NEW);
+    info.set_g(-1);
+    info.set_parent_state_id(StateID::no_state);
+    if (store_real_g) {
+        info.set_real_g(-1);
+    }
+    return default_data;
+}
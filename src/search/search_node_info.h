@@ -1,24 +1,89 @@
 #ifndef SEARCH_NODE_INFO_H
 #define SEARCH_NODE_INFO_H
 
-#include "operator_id.h"
+#include "per_state_array.h"
 #include "state_id.h"
 
+#include <cassert>
+#include <vector>
+
 // For documentation on classes relevant to storing and working with registered
 // states see the file state_registry.h.
 
-struct SearchNodeInfo {
+/*
+  SearchNodeInfo is a view on the search information of a state, which the
+  SearchSpace stores as a PerStateArray of unsigned ints. The layout depends
+  on the search:
+
+    word 0: status (2 bits) and g value (30 bits)
+    word 1: ID of the parent state
+    word 2: real g value (only if it can differ from the g value)
+
+  This uses 8 bytes per state for tasks in which real and adjusted costs
+  agree and 12 bytes otherwise. The creating operator is not stored. When
+  extracting a plan, we recover it from the parent state and the state
+  itself (see SearchSpace::trace_path).
+*/
+class SearchNodeInfo {
+    static const int STATUS_BITS = 2;
+    static const unsigned int STATUS_MASK = (1u << STATUS_BITS) - 1;
+    static const int STATUS_AND_G = 0;
+    static const int PARENT_STATE_ID = 1;
+    static const int REAL_G = 2;
+
+    ArrayView<unsigned int> data;
+public:
     enum NodeStatus {NEW = 0, OPEN = 1, CLOSED = 2, DEAD_END = 3};
 
-    unsigned int status : 2;
-    int g : 30;
-    StateID parent_state_id;
-    OperatorID creating_operator;
-    int real_g;
+    explicit SearchNodeInfo(const ArrayView<unsigned int> &data)
+        : data(data) {
+    }
+
+    // Return the data of a new search node with the given layout.
+    static std::vector<unsigned int> get_default_data(bool store_real_g);
+
+    NodeStatus get_status() const {
+        return static_cast<NodeStatus>(data[STATUS_AND_G] & STATUS_MASK);
+    }
+
+    void set_status(NodeStatus status) {
+        data[STATUS_AND_G] = (data[STATUS_AND_G] & ~STATUS_MASK) | status;
+    }
+
+    int get_g() const {
+        // The arithmetic shift restores the sign of g = -1 for new nodes.
+        return static_cast<int>(data[STATUS_AND_G]) >> STATUS_BITS;
+    }
+
+    void set_g(int g) {
+        data[STATUS_AND_G] =
+            (static_cast<unsigned int>(g) << STATUS_BITS) |
+            (data[STATUS_AND_G] & STATUS_MASK);
+        assert(get_g() == g);
+    }
+
+    int get_real_g() const {
+        if (data.size() > REAL_G) {
+            return static_cast<int>(data[REAL_G]);
+        }
+        return get_g();
+    }
+
+    // Must be called after set_g.
+    void set_real_g(int real_g) {
+        if (data.size() > REAL_G) {
+            data[REAL_G] = static_cast<unsigned int>(real_g);
+        } else {
+            assert(real_g == get_g());
+        }
+    }
+
+    StateID get_parent_state_id() const {
+        return StateID(static_cast<int>(data[PARENT_STATE_ID]));
+    }
 
-    SearchNodeInfo()
-        : status(NEW), g(-1), parent_state_id(StateID::no_state),
-          creating_operator(-1), real_g(-1) {
+    void set_parent_state_id(StateID id) {
+        data[PARENT_STATE_ID] = static_cast<unsigned int>(id.value);
     }
 };
 
@@ -3,6 +3,7 @@
 #include "search_node_info.h"
 #include "task_proxy.h"
 
+#include "task_utils/successor_generator.h"
 #include "task_utils/task_properties.h"
 #include "utils/logging.h"
 
@@ -10,7 +11,7 @@
 
 using namespace std;
 
-SearchNode::SearchNode(const State &state, SearchNodeInfo &info)
+SearchNode::SearchNode(const State &state, const SearchNodeInfo &info)
     : state(state), info(info) {
     assert(state.get_id() != StateID::no_state);
 }
@@ -20,109 +21,163 @@ const State &SearchNode::get_state() const {
 }
 
 bool SearchNode::is_open() const {
-    return info.status == SearchNodeInfo::OPEN;
+    return info.get_status() == SearchNodeInfo::OPEN;
 }
 
 bool SearchNode::is_closed() const {
-    return info.status == SearchNodeInfo::CLOSED;
+    return info.get_status() == SearchNodeInfo::CLOSED;
 }
 
 bool SearchNode::is_dead_end() const {
-    return info.status == SearchNodeInfo::DEAD_END;
+    return info.get_status() == SearchNodeInfo::DEAD_END;
 }
 
 bool SearchNode::is_new() const {
-    return info.status == SearchNodeInfo::NEW;
+    return info.get_status() == SearchNodeInfo::NEW;
 }
 
 int SearchNode::get_g() const {
-    assert(info.g >= 0);
-    return info.g;
+    assert(info.get_g() >= 0);
+    return info.get_g();
 }
 
 int SearchNode::get_real_g() const {
-    return info.real_g;
+    return info.get_real_g();
 }
 
 void SearchNode::open_initial() {
-    assert(info.status == SearchNodeInfo::NEW);
-    info.status = SearchNodeInfo::OPEN;
-    info.g = 0;
-    info.real_g = 0;
-    info.parent_state_id = StateID::no_state;
-    info.creating_operator = OperatorID::no_operator;
+    assert(info.get_status() == SearchNodeInfo::NEW);
+    info.set_status(SearchNodeInfo::OPEN);
+    info.set_g(0);
+    info.set_real_g(0);
+    info.set_parent_state_id(StateID::no_state);
 }
 
 void SearchNode::open(const SearchNode &parent_node,
                       const OperatorProxy &parent_op,
                       int adjusted_cost) {
-    assert(info.status == SearchNodeInfo::NEW);
-    info.status = SearchNodeInfo::OPEN;
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state().get_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    assert(info.get_status() == SearchNodeInfo::NEW);
+    info.set_status(SearchNodeInfo::OPEN);
+    update_parent(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::reopen(const SearchNode &parent_node,
                         const OperatorProxy &parent_op,
                         int adjusted_cost) {
-    assert(info.status == SearchNodeInfo::OPEN ||
-           info.status == SearchNodeInfo::CLOSED);
+    assert(info.get_status() == SearchNodeInfo::OPEN ||
+           info.get_status() == SearchNodeInfo::CLOSED);
 
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
-    info.status = SearchNodeInfo::OPEN;
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state().get_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    info.set_status(SearchNodeInfo::OPEN);
+    update_parent(parent_node, parent_op, adjusted_cost);
 }
 
 // like reopen, except doesn't change status
 void SearchNode::update_parent(const SearchNode &parent_node,
                                const OperatorProxy &parent_op,
                                int adjusted_cost) {
-    assert(info.status == SearchNodeInfo::OPEN ||
-           info.status == SearchNodeInfo::CLOSED);
+    assert(info.get_status() == SearchNodeInfo::OPEN ||
+           info.get_status() == SearchNodeInfo::CLOSED);
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state().get_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    info.set_g(parent_node.info.get_g() + adjusted_cost);
+    info.set_real_g(parent_node.info.get_real_g() + parent_op.get_cost());
+    info.set_parent_state_id(parent_node.get_state().get_id());
 }
 
 void SearchNode::close() {
-    assert(info.status == SearchNodeInfo::OPEN);
-    info.status = SearchNodeInfo::CLOSED;
+    assert(info.get_status() == SearchNodeInfo::OPEN);
+    info.set_status(SearchNodeInfo::CLOSED);
 }
 
 void SearchNode::mark_as_dead_end() {
-    info.status = SearchNodeInfo::DEAD_END;
+    info.set_status(SearchNodeInfo::DEAD_END);
 }
 
-void SearchNode::dump(const TaskProxy &task_proxy, utils::LogProxy &log) const {
+void SearchNode::dump(utils::LogProxy &log) const {
     if (log.is_at_least_debug()) {
         log << state.get_id() << ": ";
         task_properties::dump_fdr(state);
-        if (info.creating_operator != OperatorID::no_operator) {
-            OperatorsProxy operators = task_proxy.get_operators();
-            OperatorProxy op = operators[info.creating_operator.get_index()];
-            log << " created by " << op.get_name()
-                << " from " << info.parent_state_id << endl;
+        if (info.get_parent_state_id() != StateID::no_state) {
+            log << " created from " << info.get_parent_state_id() << endl;
         } else {
             log << " no parent" << endl;
         }
     }
 }
 
-SearchSpace::SearchSpace(StateRegistry &state_registry, utils::LogProxy &log)
-    : state_registry(state_registry), log(log) {
+/*
+  Real and adjusted g values only differ if the cost type changes the costs
+  of the task.
+*/
+static bool needs_real_g(OperatorCost cost_type, bool is_unit_cost) {
+    return cost_type != NORMAL && !is_unit_cost;
+}
+
+SearchSpace::SearchSpace(
+    StateRegistry &state_registry,
+    const successor_generator::SuccessorGenerator &successor_generator,
+    OperatorCost cost_type, utils::LogProxy &log)
+    : search_node_infos(SearchNodeInfo::get_default_data(
+                            needs_real_g(cost_type, task_properties::is_unit_cost(
+                                             state_registry.get_task_proxy())))),
+      state_registry(state_registry),
+      successor_generator(successor_generator),
+      cost_type(cost_type),
+      is_unit_cost(task_properties::is_unit_cost(
+                       state_registry.get_task_proxy())),
+      log(log) {
+}
+
+SearchNodeInfo SearchSpace::get_info(const State &state) const {
+    return SearchNodeInfo(search_node_infos[state]);
+}
+
+OperatorID SearchSpace::get_creating_operator(const State &state) const {
+    SearchNodeInfo info = get_info(state);
+    StateID parent_id = info.get_parent_state_id();
+    if (parent_id == StateID::no_state) {
+        return OperatorID::no_operator;
+    }
+    State parent = state_registry.lookup_state(parent_id);
+    parent.unpack();
+    state.unpack();
+    const vector<int> &values = state.get_unpacked_values();
+
+    /*
+      Several operators can lead from the parent to the state. The search
+      keeps the first one with the lowest adjusted cost, but any cheapest
+      one yields a plan of the same cost. Among them, we prefer lower real
+      costs and then lower IDs.
+    */
+    vector<OperatorID> applicable_ops;
+    successor_generator.generate_applicable_ops(parent, applicable_ops);
+    OperatorsProxy operators = state_registry.get_task_proxy().get_operators();
+    OperatorID best_op = OperatorID::no_operator;
+    int best_adjusted_cost = -1;
+    int best_cost = -1;
+    for (OperatorID op_id : applicable_ops) {
+        OperatorProxy op = operators[op_id];
+        int adjusted_cost = get_adjusted_action_cost(op, cost_type, is_unit_cost);
+        int cost = op.get_cost();
+        if (best_op != OperatorID::no_operator &&
+            (adjusted_cost > best_adjusted_cost ||
+             (adjusted_cost == best_adjusted_cost && cost >= best_cost))) {
+            continue;
+        }
+        if (parent.get_unregistered_successor(op).get_unpacked_values() == values) {
+            best_op = op_id;
+            best_adjusted_cost = adjusted_cost;
+            best_cost = cost;
+        }
+    }
+    assert(best_op != OperatorID::no_operator);
+    return best_op;
 }
 
 SearchNode SearchSpace::get_node(const State &state) {
-    return SearchNode(state, search_node_infos[state]);
+    return SearchNode(state, get_info(state));
 }
 
 void SearchSpace::trace_path(const State &goal_state,
@@ -131,13 +186,12 @@ void SearchSpace::trace_path(const State &goal_state,
     assert(current_state.get_registry() == &state_registry);
     assert(path.empty());
     for (;;) {
-        const SearchNodeInfo &info = search_node_infos[current_state];
-        if (info.creating_operator == OperatorID::no_operator) {
-            assert(info.parent_state_id == StateID::no_state);
+        StateID parent_id = get_info(current_state).get_parent_state_id();
+        if (parent_id == StateID::no_state) {
             break;
         }
-        path.push_back(info.creating_operator);
-        current_state = state_registry.lookup_state(info.parent_state_id);
+        path.push_back(get_creating_operator(current_state));
+        current_state = state_registry.lookup_state(parent_id);
     }
     reverse(path.begin(), path.end());
 }
@@ -148,13 +202,12 @@ void SearchSpace::trace_path_state(const State &goal_state,
     assert(current_state.get_registry() == &state_registry);
     assert(state_path.empty());
     for (;;) {
-        const SearchNodeInfo &info = search_node_infos[current_state];
-        if (info.creating_operator == OperatorID::no_operator) {
-            assert(info.parent_state_id == StateID::no_state);
+        StateID parent_id = get_info(current_state).get_parent_state_id();
+        if (parent_id == StateID::no_state) {
             break;
         }
-        state_path.push_back(info.parent_state_id);
-        current_state = state_registry.lookup_state(info.parent_state_id);
+        state_path.push_back(parent_id);
+        current_state = state_registry.lookup_state(parent_id);
     }
     reverse(state_path.begin(), state_path.end());
 }
@@ -165,20 +218,44 @@ void SearchSpace::dump(const TaskProxy &task_proxy) const {
         /* The body duplicates SearchNode::dump() but we cannot create
            a search node without discarding the const qualifier. */
         State state = state_registry.lookup_state(id);
-        const SearchNodeInfo &node_info = search_node_infos[state];
+        state.unpack();
         log << id << ": ";
         task_properties::dump_fdr(state);
-        if (node_info.creating_operator != OperatorID::no_operator &&
-            node_info.parent_state_id != StateID::no_state) {
-            OperatorProxy op = operators[node_info.creating_operator.get_index()];
+        OperatorID op_id = get_creating_operator(state);
+        if (op_id != OperatorID::no_operator) {
+            OperatorProxy op = operators[op_id];
             log << " created by " << op.get_name()
-                << " from " << node_info.parent_state_id << endl;
+                << " from " << get_info(state).get_parent_state_id() << endl;
         } else {
             log << "has no parent" << endl;
         }
     }
 }
 
+size_t SearchSpace::get_node_info_bytes() const {
+    return SearchNodeInfo::get_default_data(
+        needs_real_g(cost_type, is_unit_cost)).size() * sizeof(unsigned int);
+}
+
+size_t SearchSpace::get_num_bytes() const {
+    return state_registry.get_state_data_bytes() +
+           state_registry.get_hash_set_bytes() +
+           state_registry.size() * get_node_info_bytes();
+}
+
 void SearchSpace::print_statistics() const {
     state_registry.print_statistics(log);
+    size_t num_states = state_registry.size();
+    if (num_states > 0) {
+        double state_data_bytes =
+            static_cast<double>(state_registry.get_state_data_bytes()) / num_states;
+        double hash_set_bytes =
+            static_cast<double>(state_registry.get_hash_set_bytes()) / num_states;
+        size_t node_info_bytes = get_node_info_bytes();
+        log << "Bytes per registered state: "
+            << state_data_bytes + hash_set_bytes + node_info_bytes
+            << " (state data: " << state_data_bytes
+            << ", hash set: " << hash_set_bytes
+            << ", search node info: " << node_info_bytes << ")" << endl;
+    }
 }
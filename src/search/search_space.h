@@ -2,7 +2,7 @@
 #define SEARCH_SPACE_H
 
 #include "operator_cost.h"
-#include "per_state_information.h"
+#include "per_state_array.h"
 #include "search_node_info.h"
 
 #include <vector>
@@ -11,15 +11,19 @@ class OperatorProxy;
 class State;
 class TaskProxy;
 
+namespace successor_generator {
+class SuccessorGenerator;
+}
+
 namespace utils {
 class LogProxy;
 }
 
 class SearchNode {
     State state;
-    SearchNodeInfo &info;
+    SearchNodeInfo info;
 public:
-    SearchNode(const State &state, SearchNodeInfo &info);
+    SearchNode(const State &state, const SearchNodeInfo &info);
 
     const State &get_state() const;
 
@@ -44,17 +48,30 @@ public:
     void close();
     void mark_as_dead_end();
 
-    void dump(const TaskProxy &task_proxy, utils::LogProxy &log) const;
+    void dump(utils::LogProxy &log) const;
 };
 
 
 class SearchSpace {
-    PerStateInformation<SearchNodeInfo> search_node_infos;
+    /*
+      PerStateArray has no const access, but the const methods only access
+      registered states, for which an entry exists anyway.
+    */
+    mutable PerStateArray<unsigned int> search_node_infos;
 
     StateRegistry &state_registry;
+    const successor_generator::SuccessorGenerator &successor_generator;
+    OperatorCost cost_type;
+    bool is_unit_cost;
     utils::LogProxy &log;
+
+    SearchNodeInfo get_info(const State &state) const;
+    OperatorID get_creating_operator(const State &state) const;
+    std::size_t get_node_info_bytes() const;
 public:
-    SearchSpace(StateRegistry &state_registry, utils::LogProxy &log);
+    SearchSpace(StateRegistry &state_registry,
+                const successor_generator::SuccessorGenerator &successor_generator,
+                OperatorCost cost_type, utils::LogProxy &log);
 
     SearchNode get_node(const State &state);
     void trace_path(const State &goal_state,
@@ -64,6 +81,9 @@ public:
 
     void dump(const TaskProxy &task_proxy) const;
     void print_statistics() const;
+
+    // Return the memory used for registered states and their search nodes.
+    std::size_t get_num_bytes() const;
 };
 
 #endif
@@ -8,12 +8,16 @@
 
 class StateID {
     friend class StateRegistry;
+    friend class ConcurrentStateRegistry;
     friend std::ostream &operator<<(std::ostream &os, StateID id);
     template<typename>
     friend class PerStateInformation;
     template<typename>
     friend class PerStateArray;
     friend class PerStateBitset;
+    friend class SearchNodeInfo;
+    template<typename>
+    friend class ConcurrentPerStateInformation;
 
     int value;
     explicit StateID(int value_)
@@ -8,6 +8,9 @@
 
 using namespace std;
 
+bool StateRegistry::compress_new_registries = false;
+bool StateRegistry::use_hash_fingerprints_in_new_registries = false;
+
 StateRegistry::StateRegistry(const TaskProxy &task_proxy)
     : task_proxy(task_proxy),
       state_packer(task_properties::g_state_packers[task_proxy]),
@@ -15,28 +18,66 @@ StateRegistry::StateRegistry(const TaskProxy &task_proxy)
       num_variables(task_proxy.get_variables().size()),
       state_data_pool(get_bins_per_state()),
       registered_states(
-          StateIDSemanticHash(state_data_pool, get_bins_per_state()),
-          StateIDSemanticEqual(state_data_pool, get_bins_per_state())) {
+          StateIDSemanticHash(*this),
+          StateIDSemanticEqual(*this),
+          use_hash_fingerprints_in_new_registries) {
+    if (compress_new_registries) {
+        compressed_state_pool =
+            utils::make_unique_ptr<CompressedStatePool>(get_bins_per_state());
+    }
+}
+
+void StateRegistry::use_compression(bool compress) {
+    compress_new_registries = compress;
+}
+
+void StateRegistry::use_hash_fingerprints(bool use_fingerprints) {
+    use_hash_fingerprints_in_new_registries = use_fingerprints;
+}
+
+StateID StateRegistry::insert_packed_data(const PackedStateBin *buffer) {
+    if (compressed_state_pool) {
+        compressed_state_pool->push_back(buffer);
+    } else {
+        state_data_pool.push_back(buffer);
+    }
+    return insert_id_or_pop_state();
 }
 
 StateID StateRegistry::insert_id_or_pop_state() {
     /*
-      Attempt to insert a StateID for the last state of state_data_pool
-      if none is present yet. If this fails (another entry for this state
-      is present), we have to remove the duplicate entry from the
-      state data pool.
+      Attempt to insert a StateID for the last stored state if none is
+      present yet. If this fails (another entry for this state is present),
+      we have to remove the duplicate entry from the state data pool.
     */
-    StateID id(state_data_pool.size() - 1);
+    size_t num_stored_states = compressed_state_pool ?
+        compressed_state_pool->size() : state_data_pool.size();
+    StateID id(num_stored_states - 1);
     pair<int, bool> result = registered_states.insert(id.value);
     bool is_new_entry = result.second;
     if (!is_new_entry) {
-        state_data_pool.pop_back();
+        if (compressed_state_pool) {
+            compressed_state_pool->pop_back();
+        } else {
+            state_data_pool.pop_back();
+        }
+        --num_stored_states;
     }
-    assert(registered_states.size() == static_cast<int>(state_data_pool.size()));
+    assert(registered_states.size() == static_cast<int>(num_stored_states));
     return StateID(result.first);
 }
 
 State StateRegistry::lookup_state(StateID id) const {
+    if (compressed_state_pool) {
+        /*
+          The decompressed data has to live as long as the state, so the
+          state shares ownership of it.
+        */
+        shared_ptr<vector<PackedStateBin>> buffer =
+            make_shared<vector<PackedStateBin>>(get_bins_per_state());
+        compressed_state_pool->decompress(id.value, buffer->data());
+        return task_proxy.create_state(*this, id, move(buffer));
+    }
     const PackedStateBin *buffer = state_data_pool[id.value];
     return task_proxy.create_state(*this, id, buffer);
 }
@@ -52,8 +93,7 @@ const State &StateRegistry::get_initial_state() {
         for (size_t i = 0; i < initial_state.size(); ++i) {
             state_packer.set(buffer.get(), i, initial_state[i].get_value());
         }
-        state_data_pool.push_back(buffer.get());
-        StateID id = insert_id_or_pop_state();
+        StateID id = insert_packed_data(buffer.get());
         cached_initial_state = utils::make_unique_ptr<State>(lookup_state(id));
     }
     return *cached_initial_state;
@@ -64,8 +104,22 @@ const State &StateRegistry::get_initial_state() {
 //     operating on state buffers (PackedStateBin *).
 State StateRegistry::get_successor_state(const State &predecessor, const OperatorProxy &op) {
     assert(!op.is_axiom());
-    state_data_pool.push_back(predecessor.get_buffer());
-    PackedStateBin *buffer = state_data_pool[state_data_pool.size() - 1];
+    /*
+      Without compression, we compute the successor directly in the state
+      data pool. With compression, we compute it in a buffer that the new
+      state object shares and store a compressed copy.
+    */
+    PackedStateBin *buffer;
+    shared_ptr<vector<PackedStateBin>> owned_buffer;
+    if (compressed_state_pool) {
+        const PackedStateBin *predecessor_buffer = predecessor.get_buffer();
+        owned_buffer = make_shared<vector<PackedStateBin>>(
+            predecessor_buffer, predecessor_buffer + get_bins_per_state());
+        buffer = owned_buffer->data();
+    } else {
+        state_data_pool.push_back(predecessor.get_buffer());
+        buffer = state_data_pool[state_data_pool.size() - 1];
+    }
     /* Experiments for issue348 showed that for tasks with axioms it's faster
        to compute successor states using unpacked data. */
     if (task_properties::has_axioms(task_proxy)) {
@@ -81,7 +135,14 @@ State StateRegistry::get_successor_state(const State &predecessor, const Operato
         for (size_t i = 0; i < new_values.size(); ++i) {
             state_packer.set(buffer, i, new_values[i]);
         }
+        if (compressed_state_pool) {
+            compressed_state_pool->push_back(buffer);
+        }
         StateID id = insert_id_or_pop_state();
+        if (owned_buffer) {
+            return task_proxy.create_state(
+                *this, id, move(owned_buffer), move(new_values));
+        }
         return task_proxy.create_state(*this, id, buffer, move(new_values));
     } else {
         for (EffectProxy effect : op.get_effects()) {
@@ -90,11 +151,21 @@ State StateRegistry::get_successor_state(const State &predecessor, const Operato
                 state_packer.set(buffer, effect_pair.var, effect_pair.value);
             }
         }
+        if (compressed_state_pool) {
+            compressed_state_pool->push_back(buffer);
+        }
         StateID id = insert_id_or_pop_state();
+        if (owned_buffer) {
+            return task_proxy.create_state(*this, id, move(owned_buffer));
+        }
         return task_proxy.create_state(*this, id, buffer);
     }
 }
 
+State StateRegistry::insert_packed_state(const PackedStateBin *buffer) {
+    return lookup_state(insert_packed_data(buffer));
+}
+
 int StateRegistry::get_bins_per_state() const {
     return state_packer.get_num_bins();
 }
@@ -103,7 +174,19 @@ int StateRegistry::get_state_size_in_bytes() const {
     return get_bins_per_state() * sizeof(PackedStateBin);
 }
 
+size_t StateRegistry::get_state_data_bytes() const {
+    if (compressed_state_pool) {
+        return compressed_state_pool->get_num_used_bytes();
+    }
+    return state_data_pool.size() * get_state_size_in_bytes();
+}
+
+size_t StateRegistry::get_hash_set_bytes() const {
+    return registered_states.get_num_bytes();
+}
+
 void StateRegistry::print_statistics(utils::LogProxy &log) const {
     log << "Number of registered states: " << size() << endl;
     registered_states.print_statistics(log);
+    utils::print_mapped_storage_statistics(log);
 }
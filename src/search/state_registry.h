@@ -3,6 +3,7 @@
 
 #include "abstract_task.h"
 #include "axioms.h"
+#include "compressed_state_pool.h"
 #include "state_id.h"
 
 #include "algorithms/int_hash_set.h"
@@ -10,8 +11,11 @@
 #include "algorithms/segmented_vector.h"
 #include "algorithms/subscriber.h"
 #include "utils/hash.h"
+#include "utils/mapped_storage.h"
 
+#include <memory>
 #include <set>
+#include <vector>
 
 /*
   Overview of classes relevant to storing and working with registered states.
@@ -81,6 +85,7 @@
 
     SearchNodeInfo
       Remaining part of a search node besides the state that needs to be stored.
+      It is packed into two or three words per state (see search_node_info.h).
 
     SearchNode
       A SearchNode combines a StateID, a reference to a SearchNodeInfo and
@@ -89,9 +94,9 @@
       through the StateID.
 
     SearchSpace
-      The SearchSpace uses PerStateInformation<SearchNodeInfo> to map StateIDs to
-      SearchNodeInfos. The open lists only have to store StateIDs which can be
-      used to look up a search node in the SearchSpace on demand.
+      The SearchSpace uses a PerStateArray to map StateIDs to SearchNodeInfos.
+      The open lists only have to store StateIDs which can be used to look up
+      a search node in the SearchSpace on demand.
 
   ---------------
   Usage example 2
@@ -113,18 +118,25 @@ using PackedStateBin = int_packer::IntPacker::Bin;
 
 
 class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
+    using StateDataPool = segmented_vector::SegmentedArrayVector<
+        PackedStateBin, utils::MappedStorageAllocator<PackedStateBin>>;
+
+    /*
+      The hash and equality functions get the state data from the registry
+      because states may be stored compressed. The buffers hold decompressed
+      data and are unused for uncompressed registries.
+    */
     struct StateIDSemanticHash {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
-        int state_size;
-        StateIDSemanticHash(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
-            int state_size)
-            : state_data_pool(state_data_pool),
-              state_size(state_size) {
+        const StateRegistry &registry;
+        mutable std::vector<PackedStateBin> buffer;
+        explicit StateIDSemanticHash(const StateRegistry &registry)
+            : registry(registry) {
         }
 
         int_hash_set::HashType operator()(int id) const {
-            const PackedStateBin *data = state_data_pool[id];
+            int state_size = registry.get_bins_per_state();
+            buffer.resize(state_size);
+            const PackedStateBin *data = registry.get_state_data(id, buffer.data());
             utils::HashState hash_state;
             for (int i = 0; i < state_size; ++i) {
                 hash_state.feed(data[i]);
@@ -134,18 +146,21 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     };
 
     struct StateIDSemanticEqual {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
-        int state_size;
-        StateIDSemanticEqual(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
-            int state_size)
-            : state_data_pool(state_data_pool),
-              state_size(state_size) {
+        const StateRegistry &registry;
+        mutable std::vector<PackedStateBin> lhs_buffer;
+        mutable std::vector<PackedStateBin> rhs_buffer;
+        explicit StateIDSemanticEqual(const StateRegistry &registry)
+            : registry(registry) {
         }
 
         bool operator()(int lhs, int rhs) const {
-            const PackedStateBin *lhs_data = state_data_pool[lhs];
-            const PackedStateBin *rhs_data = state_data_pool[rhs];
+            int state_size = registry.get_bins_per_state();
+            lhs_buffer.resize(state_size);
+            rhs_buffer.resize(state_size);
+            const PackedStateBin *lhs_data =
+                registry.get_state_data(lhs, lhs_buffer.data());
+            const PackedStateBin *rhs_data =
+                registry.get_state_data(rhs, rhs_buffer.data());
             return std::equal(lhs_data, lhs_data + state_size, rhs_data);
         }
     };
@@ -162,16 +177,53 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     AxiomEvaluator &axiom_evaluator;
     const int num_variables;
 
-    segmented_vector::SegmentedArrayVector<PackedStateBin> state_data_pool;
+    StateDataPool state_data_pool;
+    // Replaces state_data_pool if the registry stores states compressed.
+    std::unique_ptr<CompressedStatePool> compressed_state_pool;
     StateIDSet registered_states;
 
     std::unique_ptr<State> cached_initial_state;
 
+    static bool compress_new_registries;
+    static bool use_hash_fingerprints_in_new_registries;
+
+    /*
+      Return the packed data of the state with the given ID. Compressed states
+      are decompressed into the given buffer of get_bins_per_state() bins.
+    */
+    const PackedStateBin *get_state_data(int id, PackedStateBin *buffer) const {
+        if (compressed_state_pool) {
+            compressed_state_pool->decompress(id, buffer);
+            return buffer;
+        }
+        return state_data_pool[id];
+    }
+
+    /*
+      Store the given packed data with the next free ID. If the state was
+      registered before, the data is removed again and the existing ID is
+      returned.
+    */
+    StateID insert_packed_data(const PackedStateBin *buffer);
     StateID insert_id_or_pop_state();
     int get_bins_per_state() const;
 public:
     explicit StateRegistry(const TaskProxy &task_proxy);
 
+    /*
+      Let all registries created from now on store their states compressed
+      (see CompressedStatePool). This reduces the memory for state data
+      considerably, but looking up a state has to decompress its data.
+    */
+    static void use_compression(bool compress);
+
+    /*
+      Let all registries created from now on store a fingerprint of the hash
+      of each state in the hash set of registered states (see IntHashSet).
+      This reduces the memory accesses for detecting duplicates.
+    */
+    static void use_hash_fingerprints(bool use_fingerprints);
+
     const TaskProxy &get_task_proxy() const {
         return task_proxy;
     }
@@ -203,6 +255,14 @@ public:
     */
     State get_successor_state(const State &predecessor, const OperatorProxy &op);
 
+    /*
+      Returns the state with the given packed data and registers it if this
+      was not done before. The buffer must have been packed with the state
+      packer of this registry's task, e.g. by another registry for the same
+      task. Axioms are not evaluated, so the data must be complete.
+    */
+    State insert_packed_state(const PackedStateBin *buffer);
+
     /*
       Returns the number of states registered so far.
     */
@@ -212,6 +272,11 @@ public:
 
     int get_state_size_in_bytes() const;
 
+    // Return the memory used for the data of all registered states.
+    std::size_t get_state_data_bytes() const;
+    // Return the memory used by the hash set for duplicate detection.
+    std::size_t get_hash_set_bytes() const;
+
     void print_statistics(utils::LogProxy &log) const;
 
     class const_iterator : public std::iterator<
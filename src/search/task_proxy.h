@@ -579,6 +579,12 @@ class State {
       semantics of the state".
     */
     mutable std::shared_ptr<std::vector<int>> values;
+    /*
+      Registries that store their states compressed hand out states with
+      decompressed copies of the packed data. Such states share ownership of
+      the copy, and buffer points into it. For all other states, this is null.
+    */
+    std::shared_ptr<std::vector<PackedStateBin>> owned_buffer;
     const int_packer::IntPacker *state_packer;
     int num_variables;
 public:
@@ -590,6 +596,12 @@ public:
     // Construct a registered state with packed and unpacked data.
     State(const AbstractTask &task, const StateRegistry &registry, StateID id,
           const PackedStateBin *buffer, std::vector<int> &&values);
+    // Construct a registered state that owns its packed data.
+    State(const AbstractTask &task, const StateRegistry &registry, StateID id,
+          std::shared_ptr<std::vector<PackedStateBin>> &&owned_buffer);
+    State(const AbstractTask &task, const StateRegistry &registry, StateID id,
+          std::shared_ptr<std::vector<PackedStateBin>> &&owned_buffer,
+          std::vector<int> &&values);
     // Construct a state with only unpacked data.
     State(const AbstractTask &task, std::vector<int> &&values);
 
@@ -699,6 +711,22 @@ public:
         return State(*task, registry, id, buffer, std::move(state_values));
     }
 
+    // This method is meant to be called only by the state registry.
+    State create_state(
+        const StateRegistry &registry, StateID id,
+        std::shared_ptr<std::vector<PackedStateBin>> &&owned_buffer) const {
+        return State(*task, registry, id, std::move(owned_buffer));
+    }
+
+    // This method is meant to be called only by the state registry.
+    State create_state(
+        const StateRegistry &registry, StateID id,
+        std::shared_ptr<std::vector<PackedStateBin>> &&owned_buffer,
+        std::vector<int> &&state_values) const {
+        return State(*task, registry, id, std::move(owned_buffer),
+                     std::move(state_values));
+    }
+
     State get_initial_state() const {
         return create_state(task->get_initial_state_values());
     }
@@ -724,6 +752,22 @@ public:
         return create_state(std::move(state_values));
     }
 
+    /*
+      Like convert_ancestor_state, but store the converted values in the
+      given vector instead of creating a state. The values of ancestor_state
+      are read without unpacking it.
+    */
+    void convert_ancestor_state_values(
+        const State &ancestor_state, std::vector<int> &values) const {
+        TaskProxy ancestor_task_proxy = ancestor_state.get_task();
+        int num_variables = ancestor_state.size();
+        values.resize(num_variables);
+        for (int var = 0; var < num_variables; ++var) {
+            values[var] = ancestor_state[var].get_value();
+        }
+        task->convert_ancestor_state_values(values, ancestor_task_proxy.task);
+    }
+
     const causal_graph::CausalGraph &get_causal_graph() const;
 };
 
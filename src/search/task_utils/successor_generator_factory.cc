@@ -56,6 +56,8 @@ using namespace std;
 */
 
 namespace successor_generator {
+static bool use_masks_for_new_generators = false;
+
 struct OperatorRange {
     int begin;
     int end;
@@ -107,6 +109,10 @@ public:
     int get_value(int depth) const {
         return precondition[depth].value;
     }
+
+    const vector<FactPair> &get_precondition() const {
+        return precondition;
+    }
 };
 
 
@@ -270,6 +276,23 @@ GeneratorPtr SuccessorGeneratorFactory::construct_recursive(
     return construct_fork(move(nodes));
 }
 
+GeneratorPtr SuccessorGeneratorFactory::construct_precondition_masks() const {
+    vector<OperatorID> operators;
+    vector<vector<FactPair>> preconditions;
+    operators.reserve(operator_infos.size());
+    preconditions.reserve(operator_infos.size());
+    for (const OperatorInfo &op_info : operator_infos) {
+        operators.push_back(op_info.get_op());
+        preconditions.push_back(op_info.get_precondition());
+    }
+    vector<int> domain_sizes;
+    for (VariableProxy var : task_proxy.get_variables()) {
+        domain_sizes.push_back(var.get_domain_size());
+    }
+    return utils::make_unique_ptr<GeneratorPreconditionMasks>(
+        move(operators), preconditions, domain_sizes);
+}
+
 static vector<FactPair> build_sorted_precondition(const OperatorProxy &op) {
     vector<FactPair> precond;
     precond.reserve(op.get_preconditions().size());
@@ -291,9 +314,23 @@ GeneratorPtr SuccessorGeneratorFactory::create() {
        This amounts to breaking ties by operator ID. */
     stable_sort(operator_infos.begin(), operator_infos.end());
 
-    OperatorRange full_range(0, operator_infos.size());
-    GeneratorPtr root = construct_recursive(0, full_range);
+    /*
+      Operators that come first in this order also come first in the output
+      of the decision tree, so both generators report applicable operators
+      in the same order.
+    */
+    GeneratorPtr root;
+    if (use_masks_for_new_generators) {
+        root = construct_precondition_masks();
+    } else {
+        OperatorRange full_range(0, operator_infos.size());
+        root = construct_recursive(0, full_range);
+    }
     operator_infos.clear();
     return root;
 }
+
+void SuccessorGeneratorFactory::use_precondition_masks(bool use_masks) {
+    use_masks_for_new_generators = use_masks;
+}
 }
@@ -26,11 +26,20 @@ class SuccessorGeneratorFactory {
     GeneratorPtr construct_switch(
         int switch_var_id, ValuesAndGenerators values_and_generators) const;
     GeneratorPtr construct_recursive(int depth, OperatorRange range) const;
+    GeneratorPtr construct_precondition_masks() const;
 public:
     explicit SuccessorGeneratorFactory(const TaskProxy &task_proxy);
     // Destructor cannot be implicit because OperatorInfo is forward-declared.
     ~SuccessorGeneratorFactory();
     GeneratorPtr create();
+
+    /*
+      Let all factories used from now on create a GeneratorPreconditionMasks
+      instead of a decision tree. Which one is faster depends on the task:
+      the masks have to look at every block of operators in every state,
+      while the tree only visits nodes that lead to applicable operators.
+    */
+    static void use_precondition_masks(bool use_masks);
 };
 }
 
@@ -2,8 +2,13 @@
 
 #include "../task_proxy.h"
 
+#include <algorithm>
 #include <cassert>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 using namespace std;
 
 /*
@@ -173,4 +178,79 @@ void GeneratorLeafSingle::generate_applicable_ops(
     const vector<int> &, vector<OperatorID> &applicable_ops) const {
     applicable_ops.push_back(applicable_operator);
 }
+
+static int get_lowest_bit_index(uint64_t mask) {
+    assert(mask != 0);
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return index;
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+GeneratorPreconditionMasks::GeneratorPreconditionMasks(
+    vector<OperatorID> &&operators_,
+    const vector<vector<FactPair>> &preconditions,
+    const vector<int> &domain_sizes)
+    : operators(move(operators_)) {
+    assert(operators.size() == preconditions.size());
+    int num_ops = operators.size();
+    int num_vars = domain_sizes.size();
+    // Position of the variable in the relevant variables of the current block.
+    vector<int> var_positions(num_vars, -1);
+    for (int block_start = 0; block_start < num_ops; block_start += BLOCK_SIZE) {
+        int block_end = min(block_start + BLOCK_SIZE, num_ops);
+        int begin = var_ids.size();
+        block_begin.push_back(begin);
+        for (int op = block_start; op < block_end; ++op) {
+            for (const FactPair &pre : preconditions[op]) {
+                if (var_positions[pre.var] == -1) {
+                    var_positions[pre.var] = var_ids.size();
+                    var_ids.push_back(pre.var);
+                    mask_offsets.push_back(masks.size());
+                    // Initially, all operators are compatible with all values.
+                    masks.resize(masks.size() + domain_sizes[pre.var], ~Mask(0));
+                }
+            }
+        }
+        for (int op = block_start; op < block_end; ++op) {
+            Mask op_bit = Mask(1) << (op - block_start);
+            for (const FactPair &pre : preconditions[op]) {
+                int offset = mask_offsets[var_positions[pre.var]];
+                for (int value = 0; value < domain_sizes[pre.var]; ++value) {
+                    if (value != pre.value) {
+                        masks[offset + value] &= ~op_bit;
+                    }
+                }
+            }
+        }
+        for (int i = begin; i < static_cast<int>(var_ids.size()); ++i) {
+            var_positions[var_ids[i]] = -1;
+        }
+    }
+    block_begin.push_back(var_ids.size());
+}
+
+void GeneratorPreconditionMasks::generate_applicable_ops(
+    const vector<int> &state, vector<OperatorID> &applicable_ops) const {
+    int num_ops = operators.size();
+    int num_blocks = block_begin.size() - 1;
+    for (int block = 0; block < num_blocks; ++block) {
+        int block_start = block * BLOCK_SIZE;
+        int block_size = min(BLOCK_SIZE, num_ops - block_start);
+        Mask applicable = ~Mask(0) >> (BLOCK_SIZE - block_size);
+        for (int i = block_begin[block];
+             applicable && i < block_begin[block + 1]; ++i) {
+            applicable &= masks[mask_offsets[i] + state[var_ids[i]]];
+        }
+        while (applicable) {
+            applicable_ops.push_back(
+                operators[block_start + get_lowest_bit_index(applicable)]);
+            // Clear the lowest set bit.
+            applicable &= applicable - 1;
+        }
+    }
+}
 }
@@ -3,11 +3,13 @@
 
 #include "../operator_id.h"
 
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
 class State;
+struct FactPair;
 
 namespace successor_generator {
 class GeneratorBase {
@@ -86,6 +88,46 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const override;
 };
+
+/*
+  Alternative to the decision tree that tests 64 operators at a time with
+  bitwise operations. The operators are split into blocks of 64. For each
+  block and each variable on which an operator of the block has a
+  precondition, we store one mask per value of the variable. Bit i of the
+  mask for value d is set iff operator i of the block has no precondition
+  on the variable or requires value d. The operators of a block applicable
+  in a state are then given by the conjunction of the masks selected by the
+  state. Blocks are scanned in order and each block stops at the first
+  variable that rules out all of its operators.
+*/
+class GeneratorPreconditionMasks : public GeneratorBase {
+    using Mask = std::uint64_t;
+    static const int BLOCK_SIZE = 64;
+
+    std::vector<OperatorID> operators;
+    /*
+      The relevant variables of block b are var_ids[i] for
+      block_begin[b] <= i < block_begin[b + 1]. The mask of operators of
+      block b compatible with value d of var_ids[i] is
+      masks[mask_offsets[i] + d].
+    */
+    std::vector<int> block_begin;
+    std::vector<int> var_ids;
+    std::vector<int> mask_offsets;
+    std::vector<Mask> masks;
+public:
+    /*
+      The preconditions must be sorted by variable and preconditions[i]
+      must belong to operators[i]. Applicable operators are reported in
+      the order of the given operators.
+    */
+    GeneratorPreconditionMasks(
+        std::vector<OperatorID> &&operators,
+        const std::vector<std::vector<FactPair>> &preconditions,
+        const std::vector<int> &domain_sizes);
+    virtual void generate_applicable_ops(
+        const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const override;
+};
 }
 
 #endif
@@ -1,5 +1,6 @@
 #include "task_properties.h"
 
+#include "../utils/heuristic_cache.h"
 #include "../utils/logging.h"
 #include "../utils/memory.h"
 #include "../utils/system.h"
@@ -100,6 +101,50 @@ int get_num_total_effects(const TaskProxy &task_proxy) {
     return num_effects;
 }
 
+template<class FactProxyCollection>
+static void add_facts_to_cache_key(
+    const FactProxyCollection &facts, utils::CacheKey &key) {
+    key.feed(get_fact_pairs(facts));
+}
+
+template<class OperatorProxyCollection>
+static void add_operators_to_cache_key(
+    const OperatorProxyCollection &operators, utils::CacheKey &key) {
+    key.feed(static_cast<uint64_t>(operators.size()));
+    for (OperatorProxy op : operators) {
+        key.feed(op.get_name());
+        key.feed(op.get_cost());
+        add_facts_to_cache_key(op.get_preconditions(), key);
+        EffectsProxy effects = op.get_effects();
+        key.feed(static_cast<uint64_t>(effects.size()));
+        for (EffectProxy effect : effects) {
+            add_facts_to_cache_key(effect.get_conditions(), key);
+            key.feed(effect.get_fact().get_pair());
+        }
+    }
+}
+
+void add_task_to_cache_key(const TaskProxy &task_proxy, utils::CacheKey &key) {
+    VariablesProxy variables = task_proxy.get_variables();
+    key.feed(static_cast<uint64_t>(variables.size()));
+    for (VariableProxy var : variables) {
+        key.feed(var.get_name());
+        key.feed(var.get_domain_size());
+        key.feed(var.is_derived());
+        if (var.is_derived()) {
+            key.feed(var.get_axiom_layer());
+            key.feed(var.get_default_axiom_value());
+        }
+        for (int value = 0; value < var.get_domain_size(); ++value) {
+            key.feed(var.get_fact(value).get_name());
+        }
+    }
+    add_operators_to_cache_key(task_proxy.get_operators(), key);
+    add_operators_to_cache_key(task_proxy.get_axioms(), key);
+    add_facts_to_cache_key(task_proxy.get_goals(), key);
+    key.feed(task_proxy.get_initial_state().get_unpacked_values());
+}
+
 void print_variable_statistics(const TaskProxy &task_proxy) {
     const int_packer::IntPacker &state_packer = g_state_packers[task_proxy];
 
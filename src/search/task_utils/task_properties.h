@@ -6,6 +6,10 @@
 
 #include "../algorithms/int_packer.h"
 
+namespace utils {
+class CacheKey;
+}
+
 namespace task_properties {
 inline bool is_applicable(OperatorProxy op, const State &state) {
     for (FactProxy precondition : op.get_preconditions()) {
@@ -76,6 +80,17 @@ std::vector<FactPair> get_fact_pairs(const FactProxyCollection &facts) {
     return fact_pairs;
 }
 
+/*
+  Feed the task into the key of a heuristic cache entry (see
+  utils/heuristic_cache.h). This covers the variables and their facts, the
+  operators and axioms with their costs, the goals and the initial state.
+  Mutexes are not included because the heuristics that use the cache
+  ignore them.
+  Runtime: O(n), where n is the size of the task.
+*/
+extern void add_task_to_cache_key(
+    const TaskProxy &task_proxy, utils::CacheKey &key);
+
 extern void print_variable_statistics(const TaskProxy &task_proxy);
 extern void dump_pddl(const State &state);
 extern void dump_fdr(const State &state);
@@ -0,0 +1,689 @@
+#include "binary_root_task.h"
+
+#include "../utils/memory.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using utils::ExitCode;
+
+namespace tasks {
+static const char BINARY_TASK_MAGIC[8] = {'\0', 'F', 'D', 'T', 'A', 'S', 'K', '\0'};
+static const uint32_t BINARY_TASK_VERSION = 1;
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+static const int HEADER_BYTES = sizeof(BINARY_TASK_MAGIC) + 4 * sizeof(uint32_t);
+static const int SECTION_ENTRY_BYTES = 2 * sizeof(int64_t);
+static const int ALIGNMENT = 8;
+
+/*
+  The sections of the file in the order in which they appear. All sections
+  except STRING_DATA are arrays of ints. Sections holding facts store two
+  ints per fact.
+*/
+enum Section {
+    VARIABLE_NAMES,
+    VARIABLE_DOMAIN_SIZES,
+    VARIABLE_AXIOM_LAYERS,
+    VARIABLE_DEFAULT_AXIOM_VALUES,
+    // Index of the first fact of each variable, used to index the next sections.
+    FACT_BEGIN,
+    FACT_NAMES,
+    MUTEX_BEGIN,
+    MUTEXES,
+    INITIAL_STATE,
+    GOALS,
+    OPERATOR_COSTS,
+    OPERATOR_NAMES,
+    OPERATOR_PRECONDITION_BEGIN,
+    OPERATOR_PRECONDITIONS,
+    OPERATOR_EFFECT_BEGIN,
+    OPERATOR_EFFECTS,
+    // Indexed by the position of the effect in OPERATOR_EFFECTS.
+    OPERATOR_EFFECT_CONDITION_BEGIN,
+    OPERATOR_EFFECT_CONDITIONS,
+    // The axiom sections mirror the operator sections.
+    AXIOM_COSTS,
+    AXIOM_NAMES,
+    AXIOM_PRECONDITION_BEGIN,
+    AXIOM_PRECONDITIONS,
+    AXIOM_EFFECT_BEGIN,
+    AXIOM_EFFECTS,
+    AXIOM_EFFECT_CONDITION_BEGIN,
+    AXIOM_EFFECT_CONDITIONS,
+    STRING_BEGIN,
+    STRING_DATA,
+    NUM_SECTIONS
+};
+
+static const int NUM_ACTION_SECTIONS = AXIOM_COSTS - OPERATOR_COSTS;
+
+static Section get_action_section(Section operator_section, bool is_axiom) {
+    assert(operator_section >= OPERATOR_COSTS && operator_section < AXIOM_COSTS);
+    return is_axiom
+           ? static_cast<Section>(operator_section + NUM_ACTION_SECTIONS)
+           : operator_section;
+}
+
+static void input_error(const string &msg) {
+    cerr << "Invalid binary task: " << msg << endl;
+    utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+}
+
+bool is_binary_task(istream &in) {
+    // Text task files start with "begin_version".
+    return in.peek() == BINARY_TASK_MAGIC[0];
+}
+
+
+/*
+  The bytes of a binary task file, either mapped into memory or read into
+  a buffer.
+*/
+class BinaryTaskFile {
+    const char *data;
+    size_t size;
+    vector<char> buffer;
+    void *mapping;
+
+    bool try_to_map_stdin() {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+        struct stat file_info;
+        if (fstat(STDIN_FILENO, &file_info) != 0 ||
+            !S_ISREG(file_info.st_mode) || file_info.st_size == 0) {
+            return false;
+        }
+        size_t file_size = file_info.st_size;
+        void *region = mmap(
+            nullptr, file_size, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0);
+        if (region == MAP_FAILED) {
+            return false;
+        }
+        mapping = region;
+        data = static_cast<const char *>(region);
+        size = file_size;
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void read_stream(istream &in) {
+        const size_t chunk_size = 1 << 20;
+        size_t num_read = 0;
+        while (in) {
+            buffer.resize(num_read + chunk_size);
+            in.read(buffer.data() + num_read, chunk_size);
+            num_read += in.gcount();
+        }
+        buffer.resize(num_read);
+        data = buffer.data();
+        size = buffer.size();
+    }
+
+public:
+    explicit BinaryTaskFile(istream &in)
+        : data(nullptr), size(0), mapping(nullptr) {
+        if (&in != &cin || !try_to_map_stdin()) {
+            read_stream(in);
+        }
+    }
+
+    ~BinaryTaskFile() {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+        if (mapping) {
+            munmap(mapping, size);
+        }
+#endif
+    }
+
+    BinaryTaskFile(const BinaryTaskFile &) = delete;
+    BinaryTaskFile &operator=(const BinaryTaskFile &) = delete;
+
+    const char *get_data() const {
+        return data;
+    }
+
+    size_t get_size() const {
+        return size;
+    }
+
+    bool is_mapped() const {
+        return mapping != nullptr;
+    }
+};
+
+
+struct IntArray {
+    const int *data;
+    int size;
+
+    IntArray()
+        : data(nullptr), size(0) {
+    }
+
+    int operator[](int index) const {
+        assert(index >= 0 && index < size);
+        return data[index];
+    }
+
+    FactPair get_fact(int index) const {
+        return FactPair((*this)[2 * index], (*this)[2 * index + 1]);
+    }
+};
+
+
+class BinaryRootTask : public AbstractTask {
+    unique_ptr<BinaryTaskFile> file;
+    vector<IntArray> sections;
+    const char *string_data;
+    size_t string_data_size;
+
+    void check_size(Section section, int expected_size) const;
+    void check_begin_section(Section begin_section, Section section,
+                             int num_objects, int entry_size) const;
+    void load_sections();
+
+    string get_string(int id) const;
+    const IntArray &get_action_section(
+        Section operator_section, bool is_axiom) const;
+    int get_effect_index(int op_index, int eff_index, bool is_axiom) const;
+    int get_fact_index(const FactPair &fact) const;
+
+public:
+    explicit BinaryRootTask(istream &in);
+
+    virtual int get_num_variables() const override;
+    virtual string get_variable_name(int var) const override;
+    virtual int get_variable_domain_size(int var) const override;
+    virtual int get_variable_axiom_layer(int var) const override;
+    virtual int get_variable_default_axiom_value(int var) const override;
+    virtual string get_fact_name(const FactPair &fact) const override;
+    virtual bool are_facts_mutex(
+        const FactPair &fact1, const FactPair &fact2) const override;
+
+    virtual int get_operator_cost(int index, bool is_axiom) const override;
+    virtual string get_operator_name(
+        int index, bool is_axiom) const override;
+    virtual int get_num_operators() const override;
+    virtual int get_num_operator_preconditions(
+        int index, bool is_axiom) const override;
+    virtual FactPair get_operator_precondition(
+        int op_index, int fact_index, bool is_axiom) const override;
+    virtual int get_num_operator_effects(
+        int op_index, bool is_axiom) const override;
+    virtual int get_num_operator_effect_conditions(
+        int op_index, int eff_index, bool is_axiom) const override;
+    virtual FactPair get_operator_effect_condition(
+        int op_index, int eff_index, int cond_index, bool is_axiom) const override;
+    virtual FactPair get_operator_effect(
+        int op_index, int eff_index, bool is_axiom) const override;
+    virtual int convert_operator_index(
+        int index, const AbstractTask *ancestor_task) const override;
+
+    virtual int get_num_axioms() const override;
+
+    virtual int get_num_goals() const override;
+    virtual FactPair get_goal_fact(int index) const override;
+
+    virtual vector<int> get_initial_state_values() const override;
+    virtual void convert_ancestor_state_values(
+        vector<int> &values,
+        const AbstractTask *ancestor_task) const override;
+};
+
+
+BinaryRootTask::BinaryRootTask(istream &in)
+    : file(utils::make_unique_ptr<BinaryTaskFile>(in)),
+      sections(NUM_SECTIONS),
+      string_data(nullptr),
+      string_data_size(0) {
+    load_sections();
+}
+
+void BinaryRootTask::load_sections() {
+    const char *data = file->get_data();
+    size_t size = file->get_size();
+    if (size < HEADER_BYTES ||
+        memcmp(data, BINARY_TASK_MAGIC, sizeof(BINARY_TASK_MAGIC)) != 0) {
+        input_error("missing header");
+    }
+    uint32_t header[4];
+    memcpy(header, data + sizeof(BINARY_TASK_MAGIC), sizeof(header));
+    if (header[1] != BYTE_ORDER_MARK) {
+        input_error("file was written on a machine with different byte order");
+    }
+    if (header[0] != BINARY_TASK_VERSION) {
+        cerr << "Expected binary task version " << BINARY_TASK_VERSION
+             << ", got " << header[0] << "." << endl
+             << "Convert the translator output file again." << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    if (header[2] != NUM_SECTIONS) {
+        input_error("unexpected number of sections");
+    }
+    if (size < HEADER_BYTES + NUM_SECTIONS * SECTION_ENTRY_BYTES) {
+        input_error("truncated section table");
+    }
+    for (int section = 0; section < NUM_SECTIONS; ++section) {
+        int64_t entry[2];
+        memcpy(entry, data + HEADER_BYTES + section * SECTION_ENTRY_BYTES,
+               sizeof(entry));
+        int64_t offset = entry[0];
+        int64_t num_elements = entry[1];
+        size_t element_size = (section == STRING_DATA) ? 1 : sizeof(int);
+        if (offset < 0 || offset % ALIGNMENT != 0 || num_elements < 0 ||
+            num_elements > numeric_limits<int>::max() ||
+            static_cast<size_t>(offset) > size ||
+            static_cast<size_t>(num_elements) >
+            (size - offset) / element_size) {
+            input_error("section " + to_string(section) + " out of bounds");
+        }
+        if (section == STRING_DATA) {
+            string_data = data + offset;
+            string_data_size = num_elements;
+        } else {
+            sections[section].data =
+                reinterpret_cast<const int *>(data + offset);
+            sections[section].size = num_elements;
+        }
+    }
+
+    /*
+      We only check that the sizes of the sections fit together, which takes
+      constant time per section. The contents were validated when the text
+      task was converted.
+    */
+    int num_variables = get_num_variables();
+    check_size(VARIABLE_NAMES, num_variables);
+    check_size(VARIABLE_AXIOM_LAYERS, num_variables);
+    check_size(VARIABLE_DEFAULT_AXIOM_VALUES, num_variables);
+    check_size(INITIAL_STATE, num_variables);
+    check_begin_section(FACT_BEGIN, FACT_NAMES, num_variables, 1);
+    int num_facts = sections[FACT_NAMES].size;
+    check_begin_section(MUTEX_BEGIN, MUTEXES, num_facts, 2);
+    if (sections[GOALS].size % 2 != 0) {
+        input_error("odd size of goal section");
+    }
+    for (bool is_axiom : {false, true}) {
+        int num_actions = get_action_section(OPERATOR_COSTS, is_axiom).size;
+        check_size(tasks::get_action_section(OPERATOR_NAMES, is_axiom), num_actions);
+        check_begin_section(
+            tasks::get_action_section(OPERATOR_PRECONDITION_BEGIN, is_axiom),
+            tasks::get_action_section(OPERATOR_PRECONDITIONS, is_axiom),
+            num_actions, 2);
+        check_begin_section(
+            tasks::get_action_section(OPERATOR_EFFECT_BEGIN, is_axiom),
+            tasks::get_action_section(OPERATOR_EFFECTS, is_axiom),
+            num_actions, 2);
+        int num_effects =
+            get_action_section(OPERATOR_EFFECTS, is_axiom).size / 2;
+        check_begin_section(
+            tasks::get_action_section(OPERATOR_EFFECT_CONDITION_BEGIN, is_axiom),
+            tasks::get_action_section(OPERATOR_EFFECT_CONDITIONS, is_axiom),
+            num_effects, 2);
+    }
+    int num_strings = sections[STRING_BEGIN].size - 1;
+    if (num_strings < 0 ||
+        static_cast<size_t>(sections[STRING_BEGIN][num_strings]) !=
+        string_data_size) {
+        input_error("string table does not match string data");
+    }
+}
+
+void BinaryRootTask::check_size(Section section, int expected_size) const {
+    if (sections[section].size != expected_size) {
+        input_error("section " + to_string(section) + " has size " +
+                    to_string(sections[section].size) + ", expected " +
+                    to_string(expected_size));
+    }
+}
+
+void BinaryRootTask::check_begin_section(
+    Section begin_section, Section section, int num_objects,
+    int entry_size) const {
+    check_size(begin_section, num_objects + 1);
+    const IntArray &begin = sections[begin_section];
+    if (begin[0] != 0 ||
+        static_cast<int64_t>(begin[num_objects]) * entry_size !=
+        sections[section].size) {
+        input_error("section " + to_string(begin_section) +
+                    " does not match section " + to_string(section));
+    }
+}
+
+string BinaryRootTask::get_string(int id) const {
+    const IntArray &begin = sections[STRING_BEGIN];
+    return string(string_data + begin[id], string_data + begin[id + 1]);
+}
+
+const IntArray &BinaryRootTask::get_action_section(
+    Section operator_section, bool is_axiom) const {
+    return sections[tasks::get_action_section(operator_section, is_axiom)];
+}
+
+int BinaryRootTask::get_effect_index(
+    int op_index, int eff_index, bool is_axiom) const {
+    int effect = get_action_section(
+        OPERATOR_EFFECT_BEGIN, is_axiom)[op_index] + eff_index;
+    assert(effect < get_action_section(
+               OPERATOR_EFFECT_BEGIN, is_axiom)[op_index + 1]);
+    return effect;
+}
+
+int BinaryRootTask::get_fact_index(const FactPair &fact) const {
+    assert(fact.value >= 0 && fact.value < get_variable_domain_size(fact.var));
+    return sections[FACT_BEGIN][fact.var] + fact.value;
+}
+
+int BinaryRootTask::get_num_variables() const {
+    return sections[VARIABLE_DOMAIN_SIZES].size;
+}
+
+string BinaryRootTask::get_variable_name(int var) const {
+    return get_string(sections[VARIABLE_NAMES][var]);
+}
+
+int BinaryRootTask::get_variable_domain_size(int var) const {
+    return sections[VARIABLE_DOMAIN_SIZES][var];
+}
+
+int BinaryRootTask::get_variable_axiom_layer(int var) const {
+    return sections[VARIABLE_AXIOM_LAYERS][var];
+}
+
+int BinaryRootTask::get_variable_default_axiom_value(int var) const {
+    return sections[VARIABLE_DEFAULT_AXIOM_VALUES][var];
+}
+
+string BinaryRootTask::get_fact_name(const FactPair &fact) const {
+    return get_string(sections[FACT_NAMES][get_fact_index(fact)]);
+}
+
+bool BinaryRootTask::are_facts_mutex(
+    const FactPair &fact1, const FactPair &fact2) const {
+    if (fact1.var == fact2.var) {
+        // Same variable: mutex iff different value.
+        return fact1.value != fact2.value;
+    }
+    // The mutexes of each fact are sorted, so we can use binary search.
+    const IntArray &mutexes = sections[MUTEXES];
+    int fact_index = get_fact_index(fact1);
+    int lower = sections[MUTEX_BEGIN][fact_index];
+    int upper = sections[MUTEX_BEGIN][fact_index + 1];
+    while (lower < upper) {
+        int middle = lower + (upper - lower) / 2;
+        FactPair mutex = mutexes.get_fact(middle);
+        if (mutex == fact2) {
+            return true;
+        } else if (mutex < fact2) {
+            lower = middle + 1;
+        } else {
+            upper = middle;
+        }
+    }
+    return false;
+}
+
+int BinaryRootTask::get_operator_cost(int index, bool is_axiom) const {
+    return get_action_section(OPERATOR_COSTS, is_axiom)[index];
+}
+
+string BinaryRootTask::get_operator_name(int index, bool is_axiom) const {
+    return get_string(get_action_section(OPERATOR_NAMES, is_axiom)[index]);
+}
+
+int BinaryRootTask::get_num_operators() const {
+    return sections[OPERATOR_COSTS].size;
+}
+
+int BinaryRootTask::get_num_operator_preconditions(
+    int index, bool is_axiom) const {
+    const IntArray &begin =
+        get_action_section(OPERATOR_PRECONDITION_BEGIN, is_axiom);
+    return begin[index + 1] - begin[index];
+}
+
+FactPair BinaryRootTask::get_operator_precondition(
+    int op_index, int fact_index, bool is_axiom) const {
+    assert(fact_index < get_num_operator_preconditions(op_index, is_axiom));
+    int begin = get_action_section(
+        OPERATOR_PRECONDITION_BEGIN, is_axiom)[op_index];
+    return get_action_section(
+        OPERATOR_PRECONDITIONS, is_axiom).get_fact(begin + fact_index);
+}
+
+int BinaryRootTask::get_num_operator_effects(int op_index, bool is_axiom) const {
+    const IntArray &begin = get_action_section(OPERATOR_EFFECT_BEGIN, is_axiom);
+    return begin[op_index + 1] - begin[op_index];
+}
+
+int BinaryRootTask::get_num_operator_effect_conditions(
+    int op_index, int eff_index, bool is_axiom) const {
+    int effect = get_effect_index(op_index, eff_index, is_axiom);
+    const IntArray &begin =
+        get_action_section(OPERATOR_EFFECT_CONDITION_BEGIN, is_axiom);
+    return begin[effect + 1] - begin[effect];
+}
+
+FactPair BinaryRootTask::get_operator_effect_condition(
+    int op_index, int eff_index, int cond_index, bool is_axiom) const {
+    assert(cond_index < get_num_operator_effect_conditions(
+               op_index, eff_index, is_axiom));
+    int effect = get_effect_index(op_index, eff_index, is_axiom);
+    int begin = get_action_section(
+        OPERATOR_EFFECT_CONDITION_BEGIN, is_axiom)[effect];
+    return get_action_section(
+        OPERATOR_EFFECT_CONDITIONS, is_axiom).get_fact(begin + cond_index);
+}
+
+FactPair BinaryRootTask::get_operator_effect(
+    int op_index, int eff_index, bool is_axiom) const {
+    int effect = get_effect_index(op_index, eff_index, is_axiom);
+    return get_action_section(OPERATOR_EFFECTS, is_axiom).get_fact(effect);
+}
+
+int BinaryRootTask::convert_operator_index(
+    int index, const AbstractTask *ancestor_task) const {
+    if (this != ancestor_task) {
+        ABORT("Invalid operator ID conversion");
+    }
+    return index;
+}
+
+int BinaryRootTask::get_num_axioms() const {
+    return sections[AXIOM_COSTS].size;
+}
+
+int BinaryRootTask::get_num_goals() const {
+    return sections[GOALS].size / 2;
+}
+
+FactPair BinaryRootTask::get_goal_fact(int index) const {
+    return sections[GOALS].get_fact(index);
+}
+
+vector<int> BinaryRootTask::get_initial_state_values() const {
+    const IntArray &state = sections[INITIAL_STATE];
+    return vector<int>(state.data, state.data + state.size);
+}
+
+void BinaryRootTask::convert_ancestor_state_values(
+    vector<int> &, const AbstractTask *ancestor_task) const {
+    if (this != ancestor_task) {
+        ABORT("Invalid state conversion");
+    }
+}
+
+shared_ptr<AbstractTask> read_binary_task(istream &in) {
+    return make_shared<BinaryRootTask>(in);
+}
+
+
+class BinaryTaskWriter {
+    vector<vector<int>> sections;
+    vector<char> string_data;
+
+    int add_string(const string &str) {
+        vector<int> &begin = sections[STRING_BEGIN];
+        if (string_data.size() + str.size() >
+            static_cast<size_t>(numeric_limits<int>::max())) {
+            cerr << "Task names are too long for the binary task format."
+                 << endl;
+            utils::exit_with(ExitCode::SEARCH_UNSUPPORTED);
+        }
+        int id = begin.size() - 1;
+        string_data.insert(string_data.end(), str.begin(), str.end());
+        begin.push_back(string_data.size());
+        return id;
+    }
+
+    static void add_fact(vector<int> &section, const FactPair &fact) {
+        section.push_back(fact.var);
+        section.push_back(fact.value);
+    }
+
+    void add_actions(const AbstractTask &task, bool is_axiom) {
+        auto section = [&](Section operator_section) -> vector<int> & {
+                return sections[get_action_section(operator_section, is_axiom)];
+            };
+        section(OPERATOR_PRECONDITION_BEGIN).push_back(0);
+        section(OPERATOR_EFFECT_BEGIN).push_back(0);
+        section(OPERATOR_EFFECT_CONDITION_BEGIN).push_back(0);
+        int num_actions =
+            is_axiom ? task.get_num_axioms() : task.get_num_operators();
+        for (int op = 0; op < num_actions; ++op) {
+            section(OPERATOR_COSTS).push_back(task.get_operator_cost(op, is_axiom));
+            section(OPERATOR_NAMES).push_back(
+                add_string(task.get_operator_name(op, is_axiom)));
+            int num_preconditions =
+                task.get_num_operator_preconditions(op, is_axiom);
+            for (int i = 0; i < num_preconditions; ++i) {
+                add_fact(section(OPERATOR_PRECONDITIONS),
+                         task.get_operator_precondition(op, i, is_axiom));
+            }
+            section(OPERATOR_PRECONDITION_BEGIN).push_back(
+                section(OPERATOR_PRECONDITIONS).size() / 2);
+            int num_effects = task.get_num_operator_effects(op, is_axiom);
+            for (int eff = 0; eff < num_effects; ++eff) {
+                add_fact(section(OPERATOR_EFFECTS),
+                         task.get_operator_effect(op, eff, is_axiom));
+                int num_conditions =
+                    task.get_num_operator_effect_conditions(op, eff, is_axiom);
+                for (int i = 0; i < num_conditions; ++i) {
+                    add_fact(section(OPERATOR_EFFECT_CONDITIONS),
+                             task.get_operator_effect_condition(
+                                 op, eff, i, is_axiom));
+                }
+                section(OPERATOR_EFFECT_CONDITION_BEGIN).push_back(
+                    section(OPERATOR_EFFECT_CONDITIONS).size() / 2);
+            }
+            section(OPERATOR_EFFECT_BEGIN).push_back(
+                section(OPERATOR_EFFECTS).size() / 2);
+        }
+    }
+
+    static int64_t align(int64_t offset) {
+        return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    static void write_padding(ostream &out, int64_t &offset) {
+        static const char zeros[ALIGNMENT] = {};
+        int64_t aligned_offset = align(offset);
+        out.write(zeros, aligned_offset - offset);
+        offset = aligned_offset;
+    }
+
+public:
+    BinaryTaskWriter(const AbstractTask &task,
+                     const vector<vector<set<FactPair>>> &mutexes)
+        : sections(NUM_SECTIONS) {
+        sections[STRING_BEGIN].push_back(0);
+        sections[FACT_BEGIN].push_back(0);
+        sections[MUTEX_BEGIN].push_back(0);
+        int num_variables = task.get_num_variables();
+        for (int var = 0; var < num_variables; ++var) {
+            int domain_size = task.get_variable_domain_size(var);
+            sections[VARIABLE_NAMES].push_back(
+                add_string(task.get_variable_name(var)));
+            sections[VARIABLE_DOMAIN_SIZES].push_back(domain_size);
+            sections[VARIABLE_AXIOM_LAYERS].push_back(
+                task.get_variable_axiom_layer(var));
+            sections[VARIABLE_DEFAULT_AXIOM_VALUES].push_back(
+                task.get_variable_default_axiom_value(var));
+            for (int value = 0; value < domain_size; ++value) {
+                sections[FACT_NAMES].push_back(
+                    add_string(task.get_fact_name(FactPair(var, value))));
+                // Sets are sorted, which are_facts_mutex relies on.
+                for (const FactPair &mutex : mutexes[var][value]) {
+                    add_fact(sections[MUTEXES], mutex);
+                }
+                sections[MUTEX_BEGIN].push_back(sections[MUTEXES].size() / 2);
+            }
+            sections[FACT_BEGIN].push_back(sections[FACT_NAMES].size());
+        }
+        sections[INITIAL_STATE] = task.get_initial_state_values();
+        int num_goals = task.get_num_goals();
+        for (int i = 0; i < num_goals; ++i) {
+            add_fact(sections[GOALS], task.get_goal_fact(i));
+        }
+        add_actions(task, false);
+        add_actions(task, true);
+    }
+
+    void write(ostream &out) const {
+        uint32_t header[4] = {
+            BINARY_TASK_VERSION, BYTE_ORDER_MARK, NUM_SECTIONS, 0};
+        out.write(BINARY_TASK_MAGIC, sizeof(BINARY_TASK_MAGIC));
+        out.write(reinterpret_cast<const char *>(header), sizeof(header));
+
+        int64_t offset = align(HEADER_BYTES + NUM_SECTIONS * SECTION_ENTRY_BYTES);
+        for (int section = 0; section < NUM_SECTIONS; ++section) {
+            int64_t num_elements;
+            int64_t num_bytes;
+            if (section == STRING_DATA) {
+                num_elements = string_data.size();
+                num_bytes = num_elements;
+            } else {
+                num_elements = sections[section].size();
+                num_bytes = num_elements * sizeof(int);
+            }
+            int64_t entry[2] = {offset, num_elements};
+            out.write(reinterpret_cast<const char *>(entry), sizeof(entry));
+            offset = align(offset + num_bytes);
+        }
+
+        offset = HEADER_BYTES + NUM_SECTIONS * SECTION_ENTRY_BYTES;
+        for (int section = 0; section < NUM_SECTIONS; ++section) {
+            write_padding(out, offset);
+            if (section == STRING_DATA) {
+                out.write(string_data.data(), string_data.size());
+                offset += string_data.size();
+            } else {
+                const vector<int> &data = sections[section];
+                out.write(reinterpret_cast<const char *>(data.data()),
+                          data.size() * sizeof(int));
+                offset += data.size() * sizeof(int);
+            }
+        }
+    }
+};
+
+void write_binary_task(
+    const AbstractTask &task,
+    const vector<vector<set<FactPair>>> &mutexes,
+    ostream &out) {
+    BinaryTaskWriter(task, mutexes).write(out);
+}
+}
@@ -0,0 +1,67 @@
+#ifndef TASKS_BINARY_ROOT_TASK_H
+#define TASKS_BINARY_ROOT_TASK_H
+
+#include "../abstract_task.h"
+
+#include <iostream>
+#include <memory>
+#include <set>
+#include <vector>
+
+/*
+  Binary representation of the root task that can be loaded without
+  parsing. All data is stored in flat arrays of 32-bit integers, and the
+  task loaded from it (BinaryRootTask) answers all queries directly from
+  these arrays. If the file is passed as standard input and is a regular
+  file, we map it into memory instead of reading it, so loading the task
+  takes time independent of its size.
+
+  The file starts with a header:
+
+    8 bytes  BINARY_TASK_MAGIC
+    uint32   format version (BINARY_TASK_VERSION)
+    uint32   BYTE_ORDER_MARK, to detect files written on a machine with
+             different endianness
+    uint32   number of sections (NUM_SECTIONS)
+    uint32   padding
+    NUM_SECTIONS times:
+      int64  byte offset of the section from the start of the file
+      int64  number of elements in the section
+
+  Each section starts at an offset divisible by 8. The sections are
+  listed in the order of the Section enum in binary_root_task.cc. Facts
+  are stored as pairs of ints (variable, value). For data with a
+  variable number of entries per object (e.g. preconditions per operator),
+  there is one section "X_BEGIN" with n + 1 start indices into the
+  section "X" for n objects. Strings are stored as indices into the
+  STRING_BEGIN section, which holds the start offsets of all strings in
+  the STRING_DATA section of chars.
+
+  The format only depends on the task, not on the planner configuration.
+  Files are written by write_binary_task(), which the planner calls for
+  "downward --write-binary-task FILE < output.sas".
+*/
+
+namespace tasks {
+// Return true if the input starts with the magic bytes of a binary task.
+extern bool is_binary_task(std::istream &in);
+
+/*
+  Load a binary task from in. If in is std::cin and standard input is a
+  regular file, the file is mapped into memory. Otherwise, the remaining
+  input is read into memory in one go.
+*/
+extern std::shared_ptr<AbstractTask> read_binary_task(std::istream &in);
+
+/*
+  Write the given task in the binary format. Mutexes are not part of the
+  AbstractTask interface, so they must be given explicitly: mutexes[var][value]
+  is the set of facts of other variables that are mutex with the fact.
+*/
+extern void write_binary_task(
+    const AbstractTask &task,
+    const std::vector<std::vector<std::set<FactPair>>> &mutexes,
+    std::ostream &out);
+}
+
+#endif
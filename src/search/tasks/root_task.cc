@@ -1,5 +1,7 @@
 #include "root_task.h"
 
+#include "binary_root_task.h"
+
 #include "../option_parser.h"
 #include "../plugin.h"
 #include "../state_registry.h"
@@ -69,6 +71,10 @@ class RootTask : public AbstractTask {
 public:
     explicit RootTask(istream &in);
 
+    const vector<vector<set<FactPair>>> &get_mutexes() const {
+        return mutexes;
+    }
+
     virtual int get_num_variables() const override;
     virtual string get_variable_name(int var) const override;
     virtual int get_variable_domain_size(int var) const override;
@@ -495,7 +501,20 @@ void RootTask::convert_ancestor_state_values(
 
 void read_root_task(istream &in) {
     assert(!g_root_task);
-    g_root_task = make_shared<RootTask>(in);
+    if (is_binary_task(in)) {
+        g_root_task = read_binary_task(in);
+    } else {
+        g_root_task = make_shared<RootTask>(in);
+    }
+}
+
+void write_binary_root_task(ostream &out) {
+    const RootTask *root_task = dynamic_cast<const RootTask *>(g_root_task.get());
+    if (!root_task) {
+        cerr << "The input task is already in binary format." << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    write_binary_task(*root_task, root_task->get_mutexes(), out);
 }
 
 static shared_ptr<AbstractTask> _parse(OptionParser &parser) {
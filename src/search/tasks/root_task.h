@@ -5,6 +5,12 @@
 
 namespace tasks {
 extern std::shared_ptr<AbstractTask> g_root_task;
+/*
+  Read the root task from the translator output or from a binary task
+  file written by write_binary_root_task (see binary_root_task.h).
+*/
 extern void read_root_task(std::istream &in);
+// Write the root task, which must have been read from text, in binary format.
+extern void write_binary_root_task(std::ostream &out);
 }
 #endif
@@ -0,0 +1,232 @@
+#include "heuristic_cache.h"
+
+#include "system.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace utils {
+static const char MAGIC[8] = {'F', 'D', 'H', 'C', 'A', 'C', 'H', 'E'};
+// Increase the version whenever the format of an entry changes.
+static const int64_t FORMAT_VERSION = 1;
+static const uint64_t BYTE_ORDER_MARK = 0x0102030405060708ULL;
+static const size_t HEADER_BYTES = sizeof(MAGIC) + 2 * sizeof(int64_t);
+
+static string cache_directory;
+
+void use_heuristic_cache(const string &directory) {
+    cache_directory = directory;
+}
+
+bool uses_heuristic_cache() {
+    return !cache_directory.empty();
+}
+
+static string get_entry_path(const string &kind, const string &key) {
+    return cache_directory + "/" + kind + "-" + key + ".bin";
+}
+
+
+CacheKey::CacheKey(const string &kind) {
+    // Use a different initial state for the second hash.
+    utils::feed(hash2, 0x9e3779b9U);
+    feed(kind);
+    feed(static_cast<int>(FORMAT_VERSION));
+}
+
+void CacheKey::feed(const string &value) {
+    feed(static_cast<uint64_t>(value.size()));
+    for (char c : value) {
+        feed(static_cast<int>(c));
+    }
+}
+
+string CacheKey::finish() {
+    ostringstream out;
+    out << hex << setfill('0') << setw(16) << hash1.get_hash64()
+        << setw(16) << hash2.get_hash64();
+    return out.str();
+}
+
+
+CacheWriter::CacheWriter(const string &kind, const string &key)
+    : path(get_entry_path(kind, key)),
+      num_bytes(0) {
+    assert(uses_heuristic_cache());
+    // Writers in other threads and processes use different temporary files.
+    ostringstream temp_name;
+    temp_name << path << ".tmp-" << get_process_id() << "-"
+              << hash<thread::id>()(this_thread::get_id());
+    temp_path = temp_name.str();
+    file.open(temp_path, ios::binary | ios::trunc);
+    write_bytes(MAGIC, sizeof(MAGIC));
+    write_int(FORMAT_VERSION);
+    write_bytes(&BYTE_ORDER_MARK, sizeof(BYTE_ORDER_MARK));
+}
+
+CacheWriter::~CacheWriter() {
+    if (file.is_open()) {
+        // The entry was not committed.
+        file.close();
+        remove(temp_path.c_str());
+    }
+}
+
+void CacheWriter::write_bytes(const void *data, size_t size) {
+    file.write(static_cast<const char *>(data), size);
+    num_bytes += size;
+}
+
+void CacheWriter::write_padding() {
+    static const char zeros[8] = {};
+    write_bytes(zeros, (8 - num_bytes % 8) % 8);
+}
+
+void CacheWriter::write_int(int64_t value) {
+    write_bytes(&value, sizeof(value));
+}
+
+void CacheWriter::commit() {
+    file.close();
+    if (file.fail() || rename(temp_path.c_str(), path.c_str()) != 0) {
+        remove(temp_path.c_str());
+    }
+}
+
+
+class MappedCacheFile {
+    const char *data;
+    size_t size;
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    void *region;
+#else
+    // Use 64-bit words so that the arrays in the entry are aligned.
+    vector<uint64_t> buffer;
+#endif
+public:
+    explicit MappedCacheFile(const string &path)
+        : data(nullptr),
+          size(0) {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+        region = nullptr;
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            return;
+        }
+        struct stat file_status;
+        if (fstat(fd, &file_status) == 0 && file_status.st_size > 0) {
+            size_t file_size = file_status.st_size;
+            void *mapped = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE,
+                                fd, 0);
+            if (mapped != MAP_FAILED) {
+                region = mapped;
+                data = static_cast<const char *>(mapped);
+                size = file_size;
+            }
+        }
+        // The mapping stays valid after closing the file.
+        close(fd);
+#else
+        ifstream file(path, ios::binary | ios::ate);
+        if (!file) {
+            return;
+        }
+        size_t file_size = file.tellg();
+        buffer.resize((file_size + 7) / 8);
+        file.seekg(0);
+        if (file.read(reinterpret_cast<char *>(buffer.data()), file_size)) {
+            data = reinterpret_cast<const char *>(buffer.data());
+            size = file_size;
+        }
+#endif
+    }
+
+    ~MappedCacheFile() {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+        if (region) {
+            munmap(region, size);
+        }
+#endif
+    }
+
+    MappedCacheFile(const MappedCacheFile &) = delete;
+    MappedCacheFile &operator=(const MappedCacheFile &) = delete;
+
+    const char *get_data() const {
+        return data;
+    }
+
+    size_t get_size() const {
+        return size;
+    }
+};
+
+
+CacheReader::CacheReader(const shared_ptr<const MappedCacheFile> &mapping)
+    : mapping(mapping),
+      data(mapping->get_data()),
+      size(mapping->get_size()),
+      pos(0),
+      valid(data != nullptr) {
+}
+
+unique_ptr<CacheReader> CacheReader::open(
+    const string &kind, const string &key) {
+    assert(uses_heuristic_cache());
+    auto mapping = make_shared<MappedCacheFile>(get_entry_path(kind, key));
+    if (!mapping->get_data() || mapping->get_size() < HEADER_BYTES) {
+        return nullptr;
+    }
+    unique_ptr<CacheReader> reader(new CacheReader(mapping));
+    const void *magic = reader->read_bytes(sizeof(MAGIC));
+    int64_t version = reader->read_int();
+    const void *byte_order_mark = reader->read_bytes(sizeof(BYTE_ORDER_MARK));
+    if (!reader->is_valid() ||
+        memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        version != FORMAT_VERSION ||
+        memcmp(byte_order_mark, &BYTE_ORDER_MARK,
+               sizeof(BYTE_ORDER_MARK)) != 0) {
+        return nullptr;
+    }
+    return reader;
+}
+
+const void *CacheReader::read_bytes(size_t num_bytes) {
+    if (!valid || num_bytes > size - pos) {
+        valid = false;
+        return nullptr;
+    }
+    const void *result = data + pos;
+    pos += num_bytes;
+    return result;
+}
+
+int64_t CacheReader::read_int() {
+    const void *bytes = read_bytes(sizeof(int64_t));
+    if (!bytes) {
+        return 0;
+    }
+    int64_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+shared_ptr<const void> CacheReader::get_mapping() const {
+    return mapping;
+}
+}
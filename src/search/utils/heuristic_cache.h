@@ -0,0 +1,158 @@
+#ifndef UTILS_HEURISTIC_CACHE_H
+#define UTILS_HEURISTIC_CACHE_H
+
+#include "hash.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace utils {
+/*
+  Persistent store for data structures of heuristics that are expensive to
+  compute but only depend on the task and the heuristic parameters, like
+  pattern databases and abstractions.
+
+  After calling use_heuristic_cache(directory), heuristics that support the
+  cache look for an entry with their key in the directory before computing
+  their data and write an entry after computing it. The key is a 128-bit
+  hash of everything the data depends on (see CacheKey), so entries of
+  different tasks and parameters can share the same directory, and several
+  planner processes can use the same directory concurrently: entries are
+  written to a temporary file that is renamed when it is complete.
+
+  Entry files are memory-mapped for reading, so that large tables can be
+  used directly from the page cache without copying them. Entries that
+  cannot be read (e.g., because they were written by a planner version with
+  a different format or on a machine with a different byte order) are
+  ignored and overwritten.
+*/
+extern void use_heuristic_cache(const std::string &directory);
+extern bool uses_heuristic_cache();
+
+/*
+  Key of a cache entry. Everything that influences the cached data must be
+  fed into the key. Values are fed into two independent hash states, which
+  together give a 128-bit hash, so collisions can be ignored in practice.
+*/
+class CacheKey {
+    HashState hash1;
+    HashState hash2;
+public:
+    explicit CacheKey(const std::string &kind);
+
+    template<typename T>
+    void feed(const T &value) {
+        utils::feed(hash1, value);
+        utils::feed(hash2, value);
+    }
+
+    void feed(const std::string &value);
+
+    // Return the key as a hexadecimal string. Afterwards, the key is unusable.
+    std::string finish();
+};
+
+/*
+  Writes a cache entry. The entry is a sequence of 64-bit integers and
+  arrays, where each array starts at an offset that is a multiple of 8. The
+  entry only becomes visible to readers when commit() is called. If writing
+  fails (e.g., because the disk is full), the entry is silently dropped.
+*/
+class CacheWriter {
+    std::string path;
+    std::string temp_path;
+    std::ofstream file;
+    std::uint64_t num_bytes;
+
+    void write_bytes(const void *data, std::size_t size);
+    void write_padding();
+public:
+    CacheWriter(const std::string &kind, const std::string &key);
+    ~CacheWriter();
+
+    void write_int(std::int64_t value);
+
+    template<typename T>
+    void write_array(const T *data, std::size_t size) {
+        write_int(size);
+        write_bytes(data, size * sizeof(T));
+        write_padding();
+    }
+
+    template<typename T>
+    void write_vector(const std::vector<T> &vec) {
+        write_array(vec.data(), vec.size());
+    }
+
+    void commit();
+};
+
+class MappedCacheFile;
+
+/*
+  Reads a cache entry in the order it was written. All reads are checked
+  against the file size: after a read that goes beyond the end of the
+  entry, is_valid() returns false and the read values are meaningless.
+  Arrays are returned as pointers into the mapped file, which stays mapped
+  as long as the reader or a copy of get_mapping() exists.
+*/
+class CacheReader {
+    std::shared_ptr<const MappedCacheFile> mapping;
+    const char *data;
+    std::size_t size;
+    std::size_t pos;
+    bool valid;
+
+    const void *read_bytes(std::size_t num_bytes);
+public:
+    explicit CacheReader(const std::shared_ptr<const MappedCacheFile> &mapping);
+
+    // Return nullptr if there is no readable entry with the given key.
+    static std::unique_ptr<CacheReader> open(
+        const std::string &kind, const std::string &key);
+
+    std::int64_t read_int();
+
+    template<typename T>
+    const T *read_array(std::size_t &array_size) {
+        std::int64_t num_entries = read_int();
+        if (num_entries < 0 ||
+            static_cast<std::uint64_t>(num_entries) > size / sizeof(T)) {
+            valid = false;
+            array_size = 0;
+            return nullptr;
+        }
+        array_size = num_entries;
+        std::size_t num_bytes = (array_size * sizeof(T) + 7) / 8 * 8;
+        return static_cast<const T *>(read_bytes(num_bytes));
+    }
+
+    template<typename T>
+    std::vector<T> read_vector() {
+        std::size_t array_size;
+        const T *array = read_array<T>(array_size);
+        if (!array) {
+            return std::vector<T>();
+        }
+        return std::vector<T>(array, array + array_size);
+    }
+
+    // Return true iff all reads so far were within the entry.
+    bool is_valid() const {
+        return valid;
+    }
+
+    // Return true iff all reads were valid and the entry was read completely.
+    bool is_complete() const {
+        return valid && pos == size;
+    }
+
+    std::shared_ptr<const void> get_mapping() const;
+};
+}
+
+#endif
@@ -0,0 +1,189 @@
+#include "mapped_storage.h"
+
+#include "language.h"
+#include "logging.h"
+#include "system.h"
+
+#include <cassert>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace utils {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+/*
+  We map the file in large chunks to keep the number of memory mappings
+  small (Linux limits them to about 65000 per process by default). Blocks
+  are handed out from the current chunk in order of allocation, so states
+  that are generated at similar times end up close to each other in the
+  file. Freed blocks are kept in free lists by size, which works well
+  because the segmented vectors only ever allocate a few different sizes.
+*/
+static const size_t CHUNK_BYTES = 64 * 1024 * 1024;
+static const size_t ALIGNMENT = 64;
+
+class MappedFile {
+    string path;
+    int fd;
+    size_t file_size;
+    char *chunk_pos;
+    size_t chunk_remaining;
+    size_t num_used_bytes;
+    unordered_map<size_t, vector<void *>> free_blocks;
+    mutex file_mutex;
+
+    char *map_region(size_t num_bytes) {
+        off_t offset = file_size;
+#if OPERATING_SYSTEM == LINUX
+        int error = posix_fallocate(fd, offset, num_bytes);
+#else
+        int error = ftruncate(fd, offset + num_bytes) == 0 ? 0 : errno;
+#endif
+        if (error) {
+            cerr << "Could not extend state storage file " << path << ": "
+                 << strerror(error) << endl;
+            exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
+        }
+        void *region = mmap(nullptr, num_bytes, PROT_READ | PROT_WRITE,
+                            MAP_SHARED, fd, offset);
+        if (region == MAP_FAILED) {
+            cerr << "Could not map state storage file " << path << ": "
+                 << strerror(errno) << endl;
+            exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
+        }
+        file_size += num_bytes;
+        return static_cast<char *>(region);
+    }
+
+public:
+    explicit MappedFile(const string &directory)
+        : path(directory + "/downward-states-XXXXXX"),
+          file_size(0),
+          chunk_pos(nullptr),
+          chunk_remaining(0),
+          num_used_bytes(0) {
+        vector<char> path_buffer(path.begin(), path.end());
+        path_buffer.push_back('\0');
+        fd = mkstemp(path_buffer.data());
+        if (fd == -1) {
+            cerr << "Could not create state storage file in " << directory
+                 << ": " << strerror(errno) << endl;
+            exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+        path = path_buffer.data();
+        // The file stays accessible through fd and its mappings.
+        unlink(path.c_str());
+    }
+
+    void *allocate(size_t num_bytes) {
+        num_bytes = (num_bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        lock_guard<mutex> lock(file_mutex);
+        num_used_bytes += num_bytes;
+        vector<void *> &free_list = free_blocks[num_bytes];
+        if (!free_list.empty()) {
+            void *block = free_list.back();
+            free_list.pop_back();
+            return block;
+        }
+        if (num_bytes > CHUNK_BYTES) {
+            size_t region_bytes =
+                (num_bytes + CHUNK_BYTES - 1) / CHUNK_BYTES * CHUNK_BYTES;
+            return map_region(region_bytes);
+        }
+        if (num_bytes > chunk_remaining) {
+            // The rest of the current chunk is lost.
+            chunk_pos = map_region(CHUNK_BYTES);
+            chunk_remaining = CHUNK_BYTES;
+        }
+        void *block = chunk_pos;
+        chunk_pos += num_bytes;
+        chunk_remaining -= num_bytes;
+        return block;
+    }
+
+    void deallocate(void *block, size_t num_bytes) {
+        num_bytes = (num_bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        lock_guard<mutex> lock(file_mutex);
+        assert(num_used_bytes >= num_bytes);
+        num_used_bytes -= num_bytes;
+        free_blocks[num_bytes].push_back(block);
+    }
+
+    void print_statistics(LogProxy &log) {
+        lock_guard<mutex> lock(file_mutex);
+        log << "Mapped state storage: " << num_used_bytes / 1024
+            << " KB in use, file size " << file_size / 1024 << " KB" << endl;
+    }
+};
+
+/*
+  The file is intentionally never closed: containers that are destroyed
+  during static destruction may still return blocks to it. The operating
+  system removes the file when the process ends.
+*/
+static MappedFile *mapped_file = nullptr;
+
+void use_mapped_storage(const string &directory) {
+    if (mapped_file) {
+        cerr << "Mapped state storage can only be set up once." << endl;
+        exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    mapped_file = new MappedFile(directory);
+}
+#else
+void use_mapped_storage(const string &) {
+    cerr << "Mapped state storage is not supported on this operating system."
+         << endl;
+    exit_with(ExitCode::SEARCH_UNSUPPORTED);
+}
+#endif
+
+bool uses_mapped_storage() {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    return mapped_file != nullptr;
+#else
+    return false;
+#endif
+}
+
+void *allocate_mapped_storage(size_t num_bytes) {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    if (mapped_file) {
+        return mapped_file->allocate(num_bytes);
+    }
+#endif
+    return ::operator new(num_bytes);
+}
+
+void deallocate_mapped_storage(void *ptr, size_t num_bytes) {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    if (mapped_file) {
+        mapped_file->deallocate(ptr, num_bytes);
+        return;
+    }
+#endif
+    ::operator delete(ptr);
+}
+
+void print_mapped_storage_statistics(LogProxy &log) {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    if (mapped_file) {
+        mapped_file->print_statistics(log);
+    }
+#else
+    utils::unused_variable(log);
+#endif
+}
+}
@@ -0,0 +1,68 @@
+#ifndef UTILS_MAPPED_STORAGE_H
+#define UTILS_MAPPED_STORAGE_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace utils {
+class LogProxy;
+
+/*
+  Storage for the large per-state data structures (the packed states of a
+  StateRegistry and the entries of PerStateInformation and PerStateArray).
+
+  By default, the storage simply uses the heap. After calling
+  use_mapped_storage(directory), all subsequent allocations are placed in a
+  temporary file in the given directory, which is mapped into memory in
+  large chunks. The file is deleted as soon as it is created, so it
+  disappears when the planner exits, even after a crash.
+
+  Since the memory is backed by a file instead of swap space, the operating
+  system can write pages that have not been accessed recently (e.g.,
+  closed states that are never touched again) to the file and drop them
+  from memory, while pages in use stay resident. This allows exploring
+  state spaces that are larger than the available RAM, as long as the
+  working set fits. Note that limits on the address space (ulimit -v) also
+  count the mapped file, so the memory of such runs should be limited
+  with a limit on resident memory instead.
+
+  use_mapped_storage() must be called before the first allocation and is
+  only supported on Linux and macOS. Allocations are thread-safe.
+*/
+extern void use_mapped_storage(const std::string &directory);
+extern bool uses_mapped_storage();
+extern void *allocate_mapped_storage(std::size_t num_bytes);
+extern void deallocate_mapped_storage(void *ptr, std::size_t num_bytes);
+extern void print_mapped_storage_statistics(LogProxy &log);
+
+/*
+  Allocator for containers like SegmentedVector that allocate their data
+  from the storage described above. Objects are constructed and destroyed
+  as with std::allocator.
+*/
+template<typename T>
+class MappedStorageAllocator : public std::allocator<T> {
+public:
+    template<typename U>
+    struct rebind {
+        using other = MappedStorageAllocator<U>;
+    };
+
+    MappedStorageAllocator() = default;
+
+    template<typename U>
+    MappedStorageAllocator(const MappedStorageAllocator<U> &) {
+    }
+
+    T *allocate(std::size_t n) {
+        return static_cast<T *>(allocate_mapped_storage(n * sizeof(T)));
+    }
+
+    void deallocate(T *ptr, std::size_t n) {
+        deallocate_mapped_storage(ptr, n * sizeof(T));
+    }
+};
+}
+
+#endif
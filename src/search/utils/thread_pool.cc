@@ -0,0 +1,92 @@
+#include "thread_pool.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace utils {
+ThreadPool::ThreadPool(int num_threads)
+    : current_job(nullptr),
+      num_tasks(0),
+      next_task(0),
+      num_busy_workers(0),
+      round(0),
+      shutting_down(false) {
+    assert(num_threads >= 1);
+    workers.reserve(num_threads - 1);
+    for (int thread_id = 1; thread_id < num_threads; ++thread_id) {
+        workers.emplace_back(&ThreadPool::work, this, thread_id);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(pool_mutex);
+        shutting_down = true;
+    }
+    work_available.notify_all();
+    for (thread &worker : workers) {
+        worker.join();
+    }
+}
+
+int ThreadPool::get_num_threads() const {
+    return workers.size() + 1;
+}
+
+void ThreadPool::process_tasks(int thread_id) {
+    while (true) {
+        int task_id = next_task.fetch_add(1, memory_order_relaxed);
+        if (task_id >= num_tasks) {
+            break;
+        }
+        (*current_job)(task_id, thread_id);
+    }
+}
+
+void ThreadPool::work(int thread_id) {
+    int last_round = 0;
+    while (true) {
+        {
+            unique_lock<mutex> lock(pool_mutex);
+            work_available.wait(lock, [&]() {
+                                    return shutting_down || round != last_round;
+                                });
+            if (shutting_down) {
+                return;
+            }
+            last_round = round;
+        }
+        process_tasks(thread_id);
+        {
+            lock_guard<mutex> lock(pool_mutex);
+            --num_busy_workers;
+            if (num_busy_workers == 0) {
+                work_finished.notify_one();
+            }
+        }
+    }
+}
+
+void ThreadPool::run(int num_tasks_, const Job &job) {
+    if (workers.empty() || num_tasks_ <= 1) {
+        for (int task_id = 0; task_id < num_tasks_; ++task_id) {
+            job(task_id, 0);
+        }
+        return;
+    }
+    {
+        lock_guard<mutex> lock(pool_mutex);
+        current_job = &job;
+        num_tasks = num_tasks_;
+        next_task.store(0, memory_order_relaxed);
+        num_busy_workers = workers.size();
+        ++round;
+    }
+    work_available.notify_all();
+    process_tasks(0);
+    unique_lock<mutex> lock(pool_mutex);
+    work_finished.wait(lock, [&]() {return num_busy_workers == 0;});
+    current_job = nullptr;
+}
+}
@@ -0,0 +1,55 @@
+#ifndef UTILS_THREAD_POOL_H
+#define UTILS_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils {
+/*
+  Fixed-size pool of threads for data-parallel loops.
+
+  run(num_tasks, job) calls job(task_id, thread_id) for every task_id in
+  [0, num_tasks) and returns once all tasks are done. The calling thread
+  takes part in the work and always has thread_id 0, the worker threads
+  have the IDs 1, ..., get_num_threads() - 1. Callers can use the thread ID
+  to select thread-local data (e.g. scratch space of a heuristic), since no
+  two tasks with the same thread ID run concurrently.
+
+  A pool with a single thread does not create any worker threads and simply
+  runs all tasks in the calling thread.
+*/
+class ThreadPool {
+    using Job = std::function<void(int task_id, int thread_id)>;
+
+    std::vector<std::thread> workers;
+
+    std::mutex pool_mutex;
+    std::condition_variable work_available;
+    std::condition_variable work_finished;
+
+    const Job *current_job;
+    int num_tasks;
+    std::atomic<int> next_task;
+    int num_busy_workers;
+    int round;
+    bool shutting_down;
+
+    void process_tasks(int thread_id);
+    void work(int thread_id);
+public:
+    explicit ThreadPool(int num_threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    int get_num_threads() const;
+    void run(int num_tasks, const Job &job);
+};
+}
+
+#endif